@@ -0,0 +1,81 @@
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <unordered_set>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#if __has_include(<filesystem>)
+	#include <filesystem>
+	namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+	#include <experimental/filesystem>
+	namespace fs = std::experimental::filesystem;
+#endif
+
+using std::string;
+using std::vector;
+
+extern "C" {
+	bool __stdcall BenchmarkRun(vector<string> testRoms, uint32_t frameCount, const char* videoFilter, const char* outputFile);
+}
+
+vector<string> GetFilesInFolder(string rootFolder, std::unordered_set<string> extensions)
+{
+	vector<string> files;
+
+	std::error_code errorCode;
+	if(!fs::is_directory(fs::u8path(rootFolder), errorCode)) {
+		return files;
+	}
+
+	for(fs::directory_iterator i(fs::u8path(rootFolder)), end; i != end; i++) {
+		string extension = i->path().extension().u8string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		if(extensions.find(extension) != extensions.end()) {
+			files.push_back(i->path().u8string());
+		}
+	}
+
+	//Keep the same order between runs, to make results easier to compare
+	std::sort(files.begin(), files.end());
+	return files;
+}
+
+int main(int argc, char* argv[])
+{
+	//Usage: benchmark [--filter name] [rom folder] [frame count] [output file]
+	//The JSON report is written to stdout when no output file is given
+	//--filter selects the video filter applied to every frame (e.g "ntsc"), its time per frame is included in the report
+	string romFolder = "../PGOGames";
+	uint32_t frameCount = 3000;
+	const char* videoFilter = nullptr;
+	const char* outputFile = nullptr;
+
+	vector<string> args;
+	for(int i = 1; i < argc; i++) {
+		if(string(argv[i]) == "--filter" && i + 1 < argc) {
+			videoFilter = argv[++i];
+		} else {
+			args.push_back(argv[i]);
+		}
+	}
+
+	if(args.size() >= 1) {
+		romFolder = args[0];
+	}
+	if(args.size() >= 2) {
+		frameCount = (uint32_t)std::max(1, atoi(args[1].c_str()));
+	}
+	if(args.size() >= 3) {
+		outputFile = args[2].c_str();
+	}
+
+	vector<string> testRoms = GetFilesInFolder(romFolder, { {".sfc", ".smc", ".gb", ".gbc"} });
+	if(testRoms.empty()) {
+		std::cerr << "No roms found in " << romFolder << std::endl;
+		return 1;
+	}
+
+	return BenchmarkRun(testRoms, frameCount, videoFilter, outputFile) ? 0 : 1;
+}
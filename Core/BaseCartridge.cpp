@@ -50,10 +50,8 @@ shared_ptr<BaseCartridge> BaseCartridge::CreateCartridge(Console* console, Virtu
 			}
 		}
 
-		vector<uint8_t> romData;
-		romFile.ReadFile(romData);
-
-		if(romData.size() < 0x4000) {
+		uint32_t romSize = (uint32_t)romFile.GetSize();
+		if(romSize < 0x4000) {
 			return nullptr;
 		}
 
@@ -62,6 +60,8 @@ shared_ptr<BaseCartridge> BaseCartridge::CreateCartridge(Console* console, Virtu
 
 		string fileExt = FolderUtilities::GetExtension(romFile.GetFileName());
 		if(fileExt == ".bs") {
+			vector<uint8_t> romData;
+			romFile.ReadFile(romData);
 			cart->_bsxMemPack.reset(new BsxMemoryPack(console, romData, false));
 			if(!FirmwareHelper::LoadBsxFirmware(console, &cart->_prgRom, cart->_prgRomSize)) {
 				return nullptr;
@@ -73,18 +73,22 @@ shared_ptr<BaseCartridge> BaseCartridge::CreateCartridge(Console* console, Virtu
 				return nullptr;
 			}			
 		} else {
-			if(romData.size() < 0x8000) {
+			if(romSize < 0x8000) {
 				return nullptr;
 			}
 
-			cart->_prgRomSize = (uint32_t)romData.size();
+			cart->_prgRomSize = romSize;
 			if((cart->_prgRomSize & 0xFFF) != 0) {
 				//Round up to the next 4kb size, to ensure we have access to all the rom's data
 				cart->_prgRomSize = (cart->_prgRomSize & ~0xFFF) + 0x1000;
 			}
 			cart->_prgRom = new uint8_t[cart->_prgRomSize];
-			memset(cart->_prgRom, 0, cart->_prgRomSize);
-			memcpy(cart->_prgRom, romData.data(), romData.size());
+			memset(cart->_prgRom + romSize, 0, cart->_prgRomSize - romSize);
+
+			//Read (or decompress) the rom straight into the cartridge's buffer
+			if(!romFile.ReadFile(cart->_prgRom, romSize)) {
+				return nullptr;
+			}
 		}
 
 		if(memcmp(cart->_prgRom, "SNES-SPC700 Sound File Data", 27) == 0) {
@@ -851,6 +855,7 @@ void BaseCartridge::RunCoprocessors()
 {
 	//These coprocessors are run at the end of the frame, or as needed
 	if(_necDsp) {
+		SubsystemScope profilerScope(EmuSubsystem::Coprocessor);
 		_necDsp->Run();
 	}
 }
@@ -3,6 +3,7 @@
 #include "IMemoryHandler.h"
 #include "CartTypes.h"
 #include "BaseCoprocessor.h"
+#include "SubsystemProfiler.h"
 #include "../Utilities/ISerializable.h"
 
 class MemoryMappings;
@@ -121,11 +122,13 @@ public:
 	__forceinline void SyncCoprocessors()
 	{
 		if(_needCoprocSync) {
+			SubsystemScope profilerScope(EmuSubsystem::Coprocessor);
 			_coprocessor->Run();
 		}
 	}
 
 	BaseCoprocessor* GetCoprocessor();
+	bool IsCoprocessorSyncNeeded() { return _needCoprocSync; }
 
 	vector<unique_ptr<IMemoryHandler>>& GetPrgRomHandlers();
 	vector<unique_ptr<IMemoryHandler>>& GetSaveRamHandlers();
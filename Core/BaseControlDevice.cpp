@@ -62,7 +62,8 @@ void BaseControlDevice::StrobeProcessWrite(uint8_t value)
 void BaseControlDevice::ClearState()
 {
 	auto lock = _stateLock.AcquireSafe();
-	_state = ControlDeviceState();
+	//Keep the buffer, the state is cleared and rebuilt every frame
+	_state.State.clear();
 }
 
 ControlDeviceState BaseControlDevice::GetRawState()
@@ -77,6 +78,18 @@ void BaseControlDevice::SetRawState(ControlDeviceState state)
 	_state = state;
 }
 
+void BaseControlDevice::SetRawState(const PackedControlState &state)
+{
+	auto lock = _stateLock.AcquireSafe();
+	state.Unpack(_state);
+}
+
+void BaseControlDevice::GetRawState(PackedControlState &state)
+{
+	auto lock = _stateLock.AcquireSafe();
+	state.Pack(_state.State.data(), _state.State.size());
+}
+
 void BaseControlDevice::SetTextState(string textState)
 {
 	auto lock = _stateLock.AcquireSafe();
@@ -74,6 +74,9 @@ public:
 	void SetRawState(ControlDeviceState state);
 	ControlDeviceState GetRawState();
 
+	void SetRawState(const PackedControlState &state);
+	void GetRawState(PackedControlState &state);
+
 	virtual ControllerType GetControllerType() = 0;
 	virtual uint8_t ReadRam(uint16_t addr) = 0;
 	virtual void WriteRam(uint16_t addr, uint8_t value) = 0;
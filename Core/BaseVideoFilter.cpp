@@ -5,18 +5,21 @@
 #include "EmuSettings.h"
 #include "../Utilities/PNGHelper.h"
 #include "../Utilities/FolderUtilities.h"
+#include "../Utilities/WorkerPool.h"
+#include "../Utilities/FrameBufferPool.h"
 #include "Console.h"
 
 BaseVideoFilter::BaseVideoFilter(shared_ptr<Console> console)
 {
 	_console = console;
 	_overscan = _console->GetSettings()->GetOverscan();
+	_framePool.reset(new FrameBufferPool());
 }
 
 BaseVideoFilter::~BaseVideoFilter()
 {
 	auto lock = _frameLock.AcquireSafe();
-	delete[] _outputBuffer;
+	_outputFrame.reset();
 }
 
 void BaseVideoFilter::SetBaseFrameInfo(FrameInfo frameInfo)
@@ -36,14 +39,10 @@ FrameInfo BaseVideoFilter::GetFrameInfo()
 
 void BaseVideoFilter::UpdateBufferSize()
 {
-	uint32_t newBufferSize = GetFrameInfo().Width*GetFrameInfo().Height;
-	if(_bufferSize != newBufferSize) {
-		_frameLock.Acquire();
-		delete[] _outputBuffer;
-		_bufferSize = newBufferSize;
-		_outputBuffer = new uint32_t[newBufferSize];
-		_frameLock.Release();
-	}
+	//Every frame is written to a new buffer from the pool, the previous frame may still be used by the renderer or a recorder
+	FrameInfo frameInfo = GetFrameInfo();
+	_outputFrame = _framePool->GetFrame(frameInfo.Width, frameInfo.Height);
+	_bufferSize = frameInfo.Width * frameInfo.Height;
 }
 
 OverscanDimensions BaseVideoFilter::GetOverscan()
@@ -79,7 +78,27 @@ void BaseVideoFilter::SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber)
 
 uint32_t* BaseVideoFilter::GetOutputBuffer()
 {
-	return _outputBuffer;
+	return _outputFrame ? _outputFrame->GetData() : nullptr;
+}
+
+shared_ptr<FrameBuffer> BaseVideoFilter::GetOutputFrame()
+{
+	return _outputFrame;
+}
+
+void BaseVideoFilter::SetWorkerPool(WorkerPool* workerPool)
+{
+	_workerPool = workerPool;
+}
+
+void BaseVideoFilter::ProcessRows(uint32_t rowCount, uint32_t rowAlignment, std::function<void(uint32_t, uint32_t)> task)
+{
+	//Splits the rows into bands that are processed in parallel by the worker pool, when there is one
+	if(_workerPool) {
+		_workerPool->RunBands(rowCount, rowAlignment, task);
+	} else {
+		task(0, rowCount);
+	}
 }
 
 uint32_t BaseVideoFilter::ApplyScanlineEffect(uint32_t argb, uint8_t scanlineIntensity)
@@ -95,19 +114,19 @@ void BaseVideoFilter::TakeScreenshot(VideoFilterType filterType, string filename
 {
 	uint32_t* pngBuffer;
 	FrameInfo frameInfo;
-	uint32_t* frameBuffer = nullptr;
+	shared_ptr<FrameBuffer> frame;
 	{
+		//Holding a reference to the frame is enough, the next frames are written to other buffers
 		auto lock = _frameLock.AcquireSafe();
-		if(_bufferSize == 0 || !GetOutputBuffer()) {
+		if(_bufferSize == 0 || !_outputFrame) {
 			return;
 		}
 
-		frameBuffer = new uint32_t[_bufferSize];
-		memcpy(frameBuffer, GetOutputBuffer(), _bufferSize * sizeof(frameBuffer[0]));
+		frame = _outputFrame;
 		frameInfo = GetFrameInfo();
 	}
 
-	pngBuffer = frameBuffer;
+	pngBuffer = frame->GetData();
 
 	shared_ptr<ScaleFilter> scaleFilter = ScaleFilter::GetScaleFilter(filterType);
 	if(scaleFilter) {
@@ -120,8 +139,6 @@ void BaseVideoFilter::TakeScreenshot(VideoFilterType filterType, string filename
 	} else {
 		PNGHelper::WritePNG(*stream, pngBuffer, frameInfo.Width, frameInfo.Height);
 	}
-
-	delete[] frameBuffer;
 }
 
 void BaseVideoFilter::TakeScreenshot(string romName, VideoFilterType filterType)
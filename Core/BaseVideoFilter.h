@@ -1,14 +1,19 @@
 #pragma once
 #include "stdafx.h"
+#include <functional>
 #include "../Utilities/SimpleLock.h"
 #include "SettingTypes.h"
 
 class Console;
+class WorkerPool;
+class FrameBuffer;
+class FrameBufferPool;
 
 class BaseVideoFilter
 {
 private:
-	uint32_t* _outputBuffer = nullptr;
+	shared_ptr<FrameBufferPool> _framePool;
+	shared_ptr<FrameBuffer> _outputFrame;
 	uint32_t _bufferSize = 0;
 	SimpleLock _frameLock;
 	OverscanDimensions _overscan;
@@ -19,18 +24,22 @@ private:
 protected:
 	shared_ptr<Console> _console;
 	FrameInfo _baseFrameInfo;
+	WorkerPool* _workerPool = nullptr;
 
 	virtual void ApplyFilter(uint16_t *ppuOutputBuffer) = 0;
 	virtual void OnBeforeApplyFilter();
 	bool IsOddFrame();
 	uint32_t GetBufferSize();
 	uint32_t ApplyScanlineEffect(uint32_t argb, uint8_t scanlineIntensity);
+	void ProcessRows(uint32_t rowCount, uint32_t rowAlignment, std::function<void(uint32_t, uint32_t)> task);
 
 public:
 	BaseVideoFilter(shared_ptr<Console> console);
 	virtual ~BaseVideoFilter();
 
 	uint32_t* GetOutputBuffer();
+	shared_ptr<FrameBuffer> GetOutputFrame();
+	void SetWorkerPool(WorkerPool* workerPool);
 	void SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber);
 	void TakeScreenshot(string romName, VideoFilterType filterType);
 	void TakeScreenshot(VideoFilterType filterType, string filename, std::stringstream *stream = nullptr);
@@ -0,0 +1,219 @@
+#include "stdafx.h"
+#include "BenchmarkRunner.h"
+#include "Console.h"
+#include "Cpu.h"
+#include "MemoryManager.h"
+#include "Spc.h"
+#include "EmuSettings.h"
+#include "KeyManager.h"
+#include "VideoDecoder.h"
+#include "HeadlessRenderer.h"
+#include "HeadlessSoundManager.h"
+#include "PpuRenderBenchmark.h"
+#include "../Utilities/VirtualFile.h"
+#include "../Utilities/PlatformUtilities.h"
+#include "../Utilities/Timer.h"
+
+static const char* _videoFilterNames[] = {
+	"none", "ntsc", "xbrz2x", "xbrz3x", "xbrz4x", "xbrz5x", "xbrz6x", "hq2x", "hq3x", "hq4x", "scale2x", "scale3x", "scale4x",
+	"2xsai", "super2xsai", "supereagle", "prescale2x", "prescale3x", "prescale4x", "prescale6x", "prescale8x", "prescale10x"
+};
+
+BenchmarkRunner::BenchmarkRunner(uint32_t frameCount, VideoFilterType videoFilter)
+{
+	_frameCount = frameCount;
+	_videoFilter = videoFilter;
+}
+
+bool BenchmarkRunner::GetVideoFilterType(string name, VideoFilterType &type)
+{
+	std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+	for(size_t i = 0; i < sizeof(_videoFilterNames) / sizeof(_videoFilterNames[0]); i++) {
+		if(name == _videoFilterNames[i]) {
+			type = (VideoFilterType)i;
+			return true;
+		}
+	}
+	return false;
+}
+
+string BenchmarkRunner::GetVideoFilterName(VideoFilterType type)
+{
+	return _videoFilterNames[(int)type];
+}
+
+BenchmarkResult BenchmarkRunner::RunRom(string romPath)
+{
+	BenchmarkResult result;
+	result.RomPath = romPath;
+
+	shared_ptr<Console> console(new Console());
+	KeyManager::SetSettings(console->GetSettings().get());
+	console->Initialize();
+
+	//Run as fast as possible, and don't save a "recent game" state when the rom is unloaded
+	console->GetSettings()->SetFlag(EmulationFlags::MaximumSpeed);
+	PreferencesConfig preferences = console->GetSettings()->GetPreferences();
+	preferences.DisableGameSelectionScreen = true;
+	console->GetSettings()->SetPreferences(preferences);
+
+	//Render every frame in the first run, to compare it with the run that doesn't render anything
+	VideoConfig videoConfig = console->GetSettings()->GetVideoConfig();
+	videoConfig.DisableFrameSkipping = true;
+	videoConfig.VideoFilter = _videoFilter;
+	console->GetSettings()->SetVideoConfig(videoConfig);
+
+	{
+		HeadlessRenderer renderer(console);
+		HeadlessSoundManager soundManager(console);
+
+		if(console->LoadRom((VirtualFile)romPath, VirtualFile())) {
+			result.Loaded = true;
+
+			SubsystemProfiler profiler;
+			profiler.Start();
+			Timer timer;
+			uint32_t startFrame = console->GetFrameCount();
+			uint64_t startClock = console->GetMemoryManager()->GetMasterClock();
+			uint64_t startSkippedClocks = console->GetCpu()->GetIdleSkippedClocks();
+			uint64_t startSpcCycle = console->GetSpc()->GetState().Cycle;
+			uint64_t startSpcSkippedCycles = console->GetSpc()->GetIdleSkippedCycles();
+			uint64_t startOpCount = console->GetCpu()->GetOpCount();
+			VideoFilterStats startFilterStats = console->GetVideoDecoder()->GetFilterStats();
+
+			while(console->IsRunning() && console->GetFrameCount() - startFrame < _frameCount) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			result.FrameCount = console->GetFrameCount() - startFrame;
+			result.ElapsedTime = timer.GetElapsedMS();
+			profiler.Stop();
+
+			result.Fps = result.ElapsedTime > 0 ? result.FrameCount * 1000 / result.ElapsedTime : 0;
+			for(int i = 0; i < SubsystemProfiler::SubsystemCount; i++) {
+				result.SubsystemTime[i] = profiler.GetRatio((EmuSubsystem)i) * result.ElapsedTime;
+			}
+			VideoFilterStats filterStats = console->GetVideoDecoder()->GetFilterStats();
+			result.FilterTime = filterStats.TotalTime - startFilterStats.TotalTime;
+			result.FilteredFrameCount = filterStats.FrameCount - startFilterStats.FrameCount;
+			if(result.FilteredFrameCount > 0) {
+				result.FilterNsPerFrame = (filterStats.TotalFilterTime - startFilterStats.TotalFilterTime) * 1000000 / result.FilteredFrameCount;
+			}
+
+			uint64_t emulatedClocks = console->GetMemoryManager()->GetMasterClock() - startClock;
+			result.IdleSkippedClocks = console->GetCpu()->GetIdleSkippedClocks() - startSkippedClocks;
+			result.IdleSkipRatio = emulatedClocks > 0 ? (double)result.IdleSkippedClocks / emulatedClocks : 0;
+
+			uint64_t spcCycles = console->GetSpc()->GetState().Cycle - startSpcCycle;
+			uint64_t spcSkippedCycles = console->GetSpc()->GetIdleSkippedCycles() - startSpcSkippedCycles;
+			result.SpcIdleSkipRatio = spcCycles > 0 ? (double)spcSkippedCycles / spcCycles : 0;
+
+			double cpuTime = result.SubsystemTime[(int)EmuSubsystem::Cpu];
+			result.CpuInstructions = console->GetCpu()->GetOpCount() - startOpCount;
+			result.CpuInstructionsPerSecond = result.ElapsedTime > 0 ? result.CpuInstructions * 1000 / result.ElapsedTime : 0;
+			result.CpuTimeInstructionsPerSecond = cpuTime > 0 ? result.CpuInstructions * 1000 / cpuTime : 0;
+
+			//Run the same number of frames again, without rendering any of them
+			console->GetSettings()->SetFlag(EmulationFlags::SkipRendering);
+			profiler.Start();
+			timer.Reset();
+			startFrame = console->GetFrameCount();
+
+			while(console->IsRunning() && console->GetFrameCount() - startFrame < _frameCount) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			uint32_t skippedFrameCount = console->GetFrameCount() - startFrame;
+			result.SkipRenderElapsedTime = timer.GetElapsedMS();
+			profiler.Stop();
+			console->GetSettings()->ClearFlag(EmulationFlags::SkipRendering);
+
+			result.SkipRenderFps = result.SkipRenderElapsedTime > 0 ? skippedFrameCount * 1000 / result.SkipRenderElapsedTime : 0;
+			result.SkipRenderPpuTime = profiler.GetRatio(EmuSubsystem::PpuRender) * result.SkipRenderElapsedTime;
+			result.SkipRenderSpeedup = result.Fps > 0 ? result.SkipRenderFps / result.Fps : 0;
+
+			console->Stop(false);
+		}
+	}
+
+	console->Release();
+
+	result.PeakMemoryUsage = PlatformUtilities::GetPeakMemoryUsage();
+	return result;
+}
+
+string BenchmarkRunner::EscapeJson(string value)
+{
+	std::stringstream out;
+	for(char c : value) {
+		switch(c) {
+			case '"': out << "\\\""; break;
+			case '\\': out << "\\\\"; break;
+			case '\n': out << "\\n"; break;
+			case '\r': out << "\\r"; break;
+			case '\t': out << "\\t"; break;
+			default:
+				if((uint8_t)c < 0x20) {
+					out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c << std::dec;
+				} else {
+					out << c;
+				}
+				break;
+		}
+	}
+	return out.str();
+}
+
+string BenchmarkRunner::Run(vector<string> romPaths)
+{
+	static const char* subsystemNames[SubsystemProfiler::SubsystemCount] = { "cpu", "ppuRender", "spcDsp", "coprocessor", "frameOutput" };
+
+	std::stringstream json;
+	json << std::fixed << std::setprecision(3);
+	json << "{\n";
+	json << "  \"frameCount\": " << _frameCount << ",\n";
+	json << "  \"videoFilter\": \"" << GetVideoFilterName(_videoFilter) << "\",\n";
+	json << "  \"results\": [";
+
+	for(size_t i = 0; i < romPaths.size(); i++) {
+		BenchmarkResult result = RunRom(romPaths[i]);
+
+		json << (i > 0 ? "," : "") << "\n    {\n";
+		json << "      \"rom\": \"" << EscapeJson(result.RomPath) << "\",\n";
+		json << "      \"loaded\": " << (result.Loaded ? "true" : "false") << ",\n";
+		json << "      \"frames\": " << result.FrameCount << ",\n";
+		json << "      \"elapsedMs\": " << result.ElapsedTime << ",\n";
+		json << "      \"fps\": " << result.Fps << ",\n";
+		json << "      \"subsystemMs\": {";
+		for(int j = 0; j < SubsystemProfiler::SubsystemCount; j++) {
+			json << (j > 0 ? ", " : " ") << "\"" << subsystemNames[j] << "\": " << result.SubsystemTime[j];
+		}
+		json << " },\n";
+		json << "      \"filtersMs\": " << result.FilterTime << ",\n";
+		json << "      \"filterFrames\": " << result.FilteredFrameCount << ",\n";
+		json << "      \"filterNsPerFrame\": " << result.FilterNsPerFrame << ",\n";
+		json << "      \"idleSkippedClocks\": " << result.IdleSkippedClocks << ",\n";
+		json << "      \"idleSkipRatio\": " << result.IdleSkipRatio << ",\n";
+		json << "      \"spcIdleSkipRatio\": " << result.SpcIdleSkipRatio << ",\n";
+		json << "      \"cpuInstructions\": " << result.CpuInstructions << ",\n";
+		json << "      \"cpuInstructionsPerSec\": " << result.CpuInstructionsPerSecond << ",\n";
+		json << "      \"cpuInstructionsPerCpuSec\": " << result.CpuTimeInstructionsPerSecond << ",\n";
+		json << "      \"skipRender\": { \"elapsedMs\": " << result.SkipRenderElapsedTime << ", \"fps\": " << result.SkipRenderFps << ", \"ppuRenderMs\": " << result.SkipRenderPpuTime << ", \"speedup\": " << result.SkipRenderSpeedup << " },\n";
+		json << "      \"peakRssBytes\": " << result.PeakMemoryUsage << "\n";
+		json << "    }";
+	}
+
+	json << "\n  ],\n";
+
+	//Mode 1 scene rendered with the pre-decoded tile rows, and with the per-pixel bitplane decoding they replaced
+	Mode1RenderResult mode1 = PpuRenderBenchmark().Run(_frameCount);
+	json << "  \"mode1Render\": { \"frames\": " << mode1.FrameCount;
+	json << ", \"fetchNsPerFrame\": " << mode1.FetchNsPerFrame << ", \"decodeNsPerFrame\": " << mode1.DecodeNsPerFrame;
+	json << ", \"renderNsPerFrame\": " << mode1.RenderNsPerFrame << ", \"planarRenderNsPerFrame\": " << mode1.PlanarRenderNsPerFrame;
+	json << ", \"renderSpeedup\": " << mode1.RenderSpeedup << ", \"speedup\": " << mode1.Speedup;
+	json << ", \"identical\": " << (mode1.Identical ? "true" : "false") << " },\n";
+
+	json << "  \"peakRssBytes\": " << PlatformUtilities::GetPeakMemoryUsage() << "\n";
+	json << "}\n";
+	return json.str();
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "stdafx.h"
+#include "SubsystemProfiler.h"
+#include "SettingTypes.h"
+
+struct BenchmarkResult
+{
+	string RomPath;
+	bool Loaded = false;
+	uint32_t FrameCount = 0;
+	double ElapsedTime = 0;
+	double Fps = 0;
+
+	//Time spent on the emulation thread in each subsystem, in ms
+	double SubsystemTime[SubsystemProfiler::SubsystemCount] = {};
+
+	//Time spent by the video decoder thread in the video filters, in ms
+	double FilterTime = 0;
+
+	//Frames processed by the video decoder, and the average time spent in the selected video filter for each of them
+	uint32_t FilteredFrameCount = 0;
+	double FilterNsPerFrame = 0;
+
+	//Master clocks skipped by the CPU's idle loop detection, and their share of the emulated time
+	uint64_t IdleSkippedClocks = 0;
+	double IdleSkipRatio = 0;
+
+	//Share of the SPC's cycles that were skipped by its idle loop detection
+	double SpcIdleSkipRatio = 0;
+
+	//Instructions executed by the main CPU, per second of run time and per second spent in the CPU subsystem
+	uint64_t CpuInstructions = 0;
+	double CpuInstructionsPerSecond = 0;
+	double CpuTimeInstructionsPerSecond = 0;
+
+	//Second run of the same number of frames without rendering them (as done for fast-forward/run-ahead frames)
+	double SkipRenderElapsedTime = 0;
+	double SkipRenderFps = 0;
+	double SkipRenderPpuTime = 0;
+	double SkipRenderSpeedup = 0;
+
+	size_t PeakMemoryUsage = 0;
+};
+
+//Runs each rom for a fixed number of frames without frame limiter, video or audio output and reports the results as JSON
+//(followed by the results of PpuRenderBenchmark for the same number of frames)
+class BenchmarkRunner
+{
+private:
+	uint32_t _frameCount;
+	VideoFilterType _videoFilter;
+
+	BenchmarkResult RunRom(string romPath);
+	static string EscapeJson(string value);
+
+public:
+	BenchmarkRunner(uint32_t frameCount, VideoFilterType videoFilter = VideoFilterType::None);
+
+	static bool GetVideoFilterType(string name, VideoFilterType &type);
+	static string GetVideoFilterName(VideoFilterType type);
+
+	string Run(vector<string> romPaths);
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include "stdafx.h"
+#include "../Utilities/Serializer.h"
+
+//Converts the master clock to the clock of a chip running at another rate (SPC, coprocessors)
+//The ratio is an exact fraction and the fractional cycle left over by each conversion is carried to the next one,
+//so the result is always floor(clocks * numerator / denominator), without any floating point rounding or drift
+class ClockDomain
+{
+private:
+	uint32_t _numerator = 1;
+	uint32_t _denominator = 1;
+
+	//Last converted master clock, the matching cycle and the remaining fraction of a cycle (in 1/_denominator units)
+	uint64_t _masterClock = 0;
+	uint64_t _cycle = 0;
+	uint64_t _remainder = 0;
+
+public:
+	void Reset()
+	{
+		_masterClock = 0;
+		_cycle = 0;
+		_remainder = 0;
+	}
+
+	//The clocks that were already converted keep the previous ratio, call GetCycle() first to convert them
+	void SetRatio(uint32_t numerator, uint32_t denominator)
+	{
+		if(_numerator != numerator || _denominator != denominator) {
+			_remainder = _remainder * denominator / _denominator;
+			_numerator = numerator;
+			_denominator = denominator;
+		}
+	}
+
+	uint32_t GetRate(uint32_t masterClockRate)
+	{
+		return (uint32_t)((uint64_t)masterClockRate * _numerator / _denominator);
+	}
+
+	//Returns the cycle matching the given master clock (must not be lower than the clock given in the previous call)
+	uint64_t GetCycle(uint64_t masterClock)
+	{
+		uint64_t clocks = masterClock - _masterClock;
+		if(clocks <= 0xFFFFFFFF) {
+			uint64_t total = clocks * _numerator + _remainder;
+			_cycle += total / _denominator;
+			_remainder = total % _denominator;
+		} else {
+			//Split the conversion to avoid overflows when a lot of time has passed since the last call
+			uint64_t total = clocks % _denominator * _numerator + _remainder;
+			_cycle += clocks / _denominator * _numerator + total / _denominator;
+			_remainder = total % _denominator;
+		}
+		_masterClock = masterClock;
+		return _cycle;
+	}
+
+	void Serialize(Serializer &s)
+	{
+		s.Stream(_masterClock, _cycle, _remainder);
+	}
+};
@@ -28,6 +28,7 @@
 #include "DebugStats.h"
 #include "CartTypes.h"
 #include "RewindManager.h"
+#include "RollbackManager.h"
 #include "ConsoleLock.h"
 #include "MovieManager.h"
 #include "BatteryManager.h"
@@ -82,6 +83,7 @@ void Console::Release()
 
 	_videoDecoder->StopThread();
 	_videoRenderer->StopThread();
+	_saveStateManager->StopThread();
 	
 	_videoDecoder.reset();
 	_videoRenderer.reset();
@@ -136,7 +138,9 @@ void Console::Run()
 
 	while(!_stopFlag) {
 		bool useRunAhead = _settings->GetEmulationConfig().RunAheadFrames > 0 && !_debugger && !_rewindManager->IsRewinding() && _settings->GetEmulationSpeed() > 0 && _settings->GetEmulationSpeed() <= 100;
-		if(useRunAhead) {
+		if(_rollbackManager) {
+			RunFrameWithRollback();
+		} else if(useRunAhead) {
 			RunFrameWithRunAhead();
 		} else {
 			RunFrame();
@@ -210,6 +214,33 @@ void Console::RunFrameWithRunAhead()
 	}
 }
 
+void Console::RunFrameWithRollback()
+{
+	shared_ptr<RollbackManager> rollbackManager = _rollbackManager;
+	if(!rollbackManager->CanRunFrame()) {
+		//Too far ahead of the remote players, wait for their input
+		rollbackManager->WaitForInput();
+		return;
+	}
+
+	if(rollbackManager->Rollback()) {
+		//A remote input was mispredicted, re-run the frames since then (no audio/video)
+		_isRunAheadFrame = true;
+		while(rollbackManager->IsResimulating()) {
+			rollbackManager->SaveState();
+			RunFrame();
+			rollbackManager->ProcessEndOfFrame();
+		}
+		_isRunAheadFrame = false;
+	}
+
+	rollbackManager->SaveState();
+	RunFrame();
+	rollbackManager->ProcessEndOfFrame();
+	_rewindManager->ProcessEndOfFrame();
+	ProcessSystemActions();
+}
+
 void Console::ProcessEndOfFrame()
 {
 #ifndef LIBRETRO
@@ -232,6 +263,7 @@ void Console::ProcessEndOfFrame()
 			_frameDelay = newFrameDelay;
 			_frameLimiter->SetDelay(_frameDelay);
 		}
+		_frameLimiter->SetClockAdjustment(_soundMixer->GetAudioClockAdjustment());
 
 		PreferencesConfig cfg = _settings->GetPreferences();
 		if(cfg.ShowDebugInfo) {
@@ -242,6 +274,9 @@ void Console::ProcessEndOfFrame()
 	}
 
 	_controlManager->UpdateInputState();
+	if(!_isRunAheadFrame) {
+		_inputPollTime = steady_clock::now();
+	}
 	_controlManager->UpdateControlDevices();
 	_internalRegisters->ProcessAutoJoypadRead();
 #endif
@@ -270,6 +305,7 @@ void Console::RunSingleFrame()
 void Console::Stop(bool sendNotification)
 {
 	_stopFlag = true;
+	_pauseEndSignal.Signal();
 
 	_notificationManager->SendNotification(ConsoleNotificationType::BeforeGameUnload);
 
@@ -458,6 +494,7 @@ bool Console::LoadRom(VirtualFile romFile, VirtualFile patchFile, bool stopRom,
 		_notificationManager->SendNotification(ConsoleNotificationType::GameLoaded, (void*)forPowerCycle);
 
 		_paused = false;
+		_pauseEndSignal.Signal();
 
 		if(!forPowerCycle) {
 			string modelName = _region == ConsoleRegion::Pal ? "PAL" : "NTSC";
@@ -573,6 +610,7 @@ void Console::PauseOnNextFrame()
 	} else {
 		_pauseOnNextFrame = true;
 		_paused = false;
+		_pauseEndSignal.Signal();
 	}
 }
 
@@ -597,6 +635,7 @@ void Console::Resume()
 		debugger->Run();
 	} else {
 		_paused = false;
+		_pauseEndSignal.Signal();
 	}
 }
 
@@ -610,6 +649,18 @@ bool Console::IsPaused()
 	}
 }
 
+steady_clock::time_point Console::GetInputPollTime()
+{
+	return _inputPollTime;
+}
+
+FramePacingStats Console::GetFramePacingStats()
+{
+	FramePacingStats stats = _frameLimiter ? _frameLimiter->GetStats() : FramePacingStats();
+	stats.InputLatency = _videoDecoder->GetInputLatency();
+	return stats;
+}
+
 void Console::WaitForPauseEnd()
 {
 	_notificationManager->SendNotification(ConsoleNotificationType::GamePaused);
@@ -622,7 +673,7 @@ void Console::WaitForPauseEnd()
 	PlatformUtilities::RestoreTimerResolution();
 	while(_paused && !_stopFlag && !_debugger) {
 		//Sleep until emulation is resumed
-		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(30));
+		_pauseEndSignal.Wait(100);
 	}
 
 	PlatformUtilities::DisableScreensaver();
@@ -686,13 +737,16 @@ void Console::WaitForLock()
 	}
 }
 
-void Console::Serialize(ostream &out, int compressionLevel)
+void Console::StreamState(Serializer &serializer)
 {
-	Serializer serializer(SaveStateManager::FileFormatVersion);
 	bool isGameboyMode = _settings->CheckFlag(EmulationFlags::GameboyMode);
 
 	if(!isGameboyMode) {
 		serializer.Stream(_cpu.get());
+		if(!serializer.IsSaving()) {
+			//The loop iterations measured before loading the state are no longer valid
+			_cpu->ResetIdleLoop();
+		}
 		serializer.Stream(_memoryManager.get());
 		serializer.Stream(_ppu.get());
 		serializer.Stream(_dmaController.get());
@@ -707,31 +761,36 @@ void Console::Serialize(ostream &out, int compressionLevel)
 		serializer.Stream(_cart.get());
 		serializer.Stream(_controlManager.get());
 	}
+}
+
+void Console::Serialize(ostream &out, int compressionLevel)
+{
+	Serializer serializer(SaveStateManager::FileFormatVersion);
+	StreamState(serializer);
 	serializer.Save(out, compressionLevel);
 }
 
+uint32_t Console::Serialize(uint8_t* buffer, uint32_t size)
+{
+	Serializer serializer(SaveStateManager::FileFormatVersion);
+	StreamState(serializer);
+	return serializer.Save(buffer, size);
+}
+
 void Console::Deserialize(istream &in, uint32_t fileFormatVersion, bool compressed)
 {
 	Serializer serializer(in, fileFormatVersion, compressed);
-	bool isGameboyMode = _settings->CheckFlag(EmulationFlags::GameboyMode);
+	StreamState(serializer);
+	_notificationManager->SendNotification(ConsoleNotificationType::StateLoaded);
+}
 
-	if(!isGameboyMode) {
-		serializer.Stream(_cpu.get());
-		serializer.Stream(_memoryManager.get());
-		serializer.Stream(_ppu.get());
-		serializer.Stream(_dmaController.get());
-		serializer.Stream(_internalRegisters.get());
-		serializer.Stream(_cart.get());
-		serializer.Stream(_controlManager.get());
-		serializer.Stream(_spc.get());
-		if(_msu1) {
-			serializer.Stream(_msu1.get());
-		}
-	} else {
-		serializer.Stream(_cart.get());
-		serializer.Stream(_controlManager.get());
+void Console::Deserialize(const uint8_t* data, uint32_t size, uint32_t fileFormatVersion, bool sendNotification)
+{
+	Serializer serializer(data, size, fileFormatVersion);
+	StreamState(serializer);
+	if(sendNotification) {
+		_notificationManager->SendNotification(ConsoleNotificationType::StateLoaded);
 	}
-	_notificationManager->SendNotification(ConsoleNotificationType::StateLoaded);
 }
 
 shared_ptr<SoundMixer> Console::GetSoundMixer()
@@ -769,6 +828,17 @@ shared_ptr<RewindManager> Console::GetRewindManager()
 	return _rewindManager;
 }
 
+shared_ptr<RollbackManager> Console::GetRollbackManager()
+{
+	return _rollbackManager;
+}
+
+void Console::SetRollbackManager(shared_ptr<RollbackManager> rollbackManager)
+{
+	//Must be called while the console is locked
+	_rollbackManager = rollbackManager;
+}
+
 shared_ptr<DebugHud> Console::GetDebugHud()
 {
 	return _debugHud;
@@ -844,6 +914,7 @@ shared_ptr<Debugger> Console::GetDebugger(bool autoStart)
 		if(!debugger) {
 			debugger.reset(new Debugger(shared_from_this()));
 			_debugger = debugger;
+			_pauseEndSignal.Signal();
 		}
 	}
 	return debugger;
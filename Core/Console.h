@@ -7,6 +7,7 @@
 #include "../Utilities/Timer.h"
 #include "../Utilities/VirtualFile.h"
 #include "../Utilities/SimpleLock.h"
+#include "../Utilities/AutoResetEvent.h"
 
 class Cpu;
 class Ppu;
@@ -31,7 +32,10 @@ class MovieManager;
 class SpcHud;
 class FrameLimiter;
 class DebugStats;
+struct FramePacingStats;
 class Msu1;
+class Serializer;
+class RollbackManager;
 
 enum class MemoryOperationType;
 enum class SnesMemoryType;
@@ -66,6 +70,7 @@ private:
 	shared_ptr<EmuSettings> _settings;
 	shared_ptr<SaveStateManager> _saveStateManager;
 	shared_ptr<RewindManager> _rewindManager;
+	shared_ptr<RollbackManager> _rollbackManager;
 	shared_ptr<CheatManager> _cheatManager;
 	shared_ptr<MovieManager> _movieManager;
 	shared_ptr<SpcHud> _spcHud;
@@ -81,6 +86,7 @@ private:
 	atomic<bool> _paused;
 	atomic<bool> _pauseOnNextFrame;
 	atomic<bool> _threadPaused;
+	AutoResetEvent _pauseEndSignal;
 
 	ConsoleRegion _region;
 	ConsoleType _consoleType;
@@ -93,6 +99,7 @@ private:
 	unique_ptr<FrameLimiter> _frameLimiter;
 	Timer _lastFrameTimer;
 	double _frameDelay = 0;
+	steady_clock::time_point _inputPollTime;
 
 	double GetFrameDelay();
 	void UpdateRegion();
@@ -102,6 +109,9 @@ private:
 	void RunFrame();
 	bool ProcessSystemActions();
 	void RunFrameWithRunAhead();
+	void RunFrameWithRollback();
+
+	void StreamState(Serializer &serializer);
 
 public:
 	Console();
@@ -127,6 +137,9 @@ public:
 	void Resume();
 	bool IsPaused();
 
+	steady_clock::time_point GetInputPollTime();
+	FramePacingStats GetFramePacingStats();
+
 	bool LoadRom(VirtualFile romFile, VirtualFile patchFile, bool stopRom = true, bool forPowerCycle = false);
 	RomInfo GetRomInfo();
 	uint64_t GetMasterClock();
@@ -140,7 +153,9 @@ public:
 	bool IsThreadPaused();
 
 	void Serialize(ostream &out, int compressionLevel = 0);
+	uint32_t Serialize(uint8_t* buffer, uint32_t size);
 	void Deserialize(istream &in, uint32_t fileFormatVersion, bool compressed = false);
+	void Deserialize(const uint8_t* data, uint32_t size, uint32_t fileFormatVersion, bool sendNotification = true);
 
 	shared_ptr<SoundMixer> GetSoundMixer();
 	shared_ptr<VideoRenderer> GetVideoRenderer();
@@ -149,6 +164,8 @@ public:
 	shared_ptr<EmuSettings> GetSettings();
 	shared_ptr<SaveStateManager> GetSaveStateManager();
 	shared_ptr<RewindManager> GetRewindManager();
+	shared_ptr<RollbackManager> GetRollbackManager();
+	void SetRollbackManager(shared_ptr<RollbackManager> rollbackManager);
 	shared_ptr<DebugHud> GetDebugHud();
 	shared_ptr<BatteryManager> GetBatteryManager();
 	shared_ptr<CheatManager> GetCheatManager();
@@ -13,6 +13,45 @@ struct ControlDeviceState
 	}
 };
 
+//Fixed-size copy of a ControlDeviceState (inline storage, no heap allocation)
+//The largest device state is the SuperScope's (coordinates + 32 reserved bytes + buttons)
+struct PackedControlState
+{
+	static constexpr uint8_t MaxSize = 40;
+
+	uint8_t Size = 0;
+	uint8_t Data[PackedControlState::MaxSize];
+
+	PackedControlState() { }
+
+	PackedControlState(const ControlDeviceState &state)
+	{
+		Pack(state.State.data(), state.State.size());
+	}
+
+	void Pack(const uint8_t* data, size_t size)
+	{
+		Size = (uint8_t)std::min<size_t>(size, PackedControlState::MaxSize);
+		memcpy(Data, data, Size);
+	}
+
+	void Unpack(ControlDeviceState &state) const
+	{
+		//assign() reuses the vector's existing buffer
+		state.State.assign(Data, Data + Size);
+	}
+
+	bool operator==(const PackedControlState &other) const
+	{
+		return Size == other.Size && memcmp(Data, other.Data, Size) == 0;
+	}
+
+	bool operator!=(const PackedControlState &other) const
+	{
+		return !(*this == other);
+	}
+};
+
 struct ControllerData
 {
 	ControllerType Type;
@@ -91,6 +91,24 @@ vector<shared_ptr<BaseControlDevice>> ControlManager::GetControlDevices()
 	return _controlDevices;
 }
 
+vector<shared_ptr<BaseControlDevice>> ControlManager::CreateDetachedDevices()
+{
+	//Creates a device of the same type for each port (in the same order), used to convert input data without affecting emulation
+	auto lock = _deviceLock.AcquireSafe();
+	vector<shared_ptr<BaseControlDevice>> devices;
+	for(shared_ptr<BaseControlDevice> &device : _controlDevices) {
+		if(device->GetPort() == BaseControlDevice::ConsoleInputPort) {
+			devices.push_back(shared_ptr<BaseControlDevice>(new SystemActionManager(_console)));
+		} else {
+			shared_ptr<BaseControlDevice> copy = CreateControllerDevice(device->GetControllerType(), device->GetPort(), _console);
+			if(copy) {
+				devices.push_back(copy);
+			}
+		}
+	}
+	return devices;
+}
+
 void ControlManager::RegisterControlDevice(shared_ptr<BaseControlDevice> controlDevice)
 {
 	_controlDevices.push_back(controlDevice);
@@ -54,6 +54,7 @@ public:
 	SystemActionManager* GetSystemActionManager();
 	shared_ptr<BaseControlDevice> GetControlDevice(uint8_t port);
 	vector<shared_ptr<BaseControlDevice>> GetControlDevices();
+	vector<shared_ptr<BaseControlDevice>> CreateDetachedDevices();
 	
 	static shared_ptr<BaseControlDevice> CreateControllerDevice(ControllerType type, uint8_t port, Console* console);
 
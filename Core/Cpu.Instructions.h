@@ -70,9 +70,10 @@ void Cpu::Add16(uint16_t value)
 	_state.A = (uint16_t)result;
 }
 
+template<uint8_t mode>
 void Cpu::ADC()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		Add8(GetByteValue());
 	} else {
 		Add16(GetWordValue());
@@ -148,9 +149,10 @@ void Cpu::Sub16(uint16_t value)
 	_state.A = (uint16_t)result;
 }
 
+template<uint8_t mode>
 void Cpu::SBC()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		Sub8(~GetByteValue());
 	} else {
 		Sub16(~GetWordValue());
@@ -160,39 +162,46 @@ void Cpu::SBC()
 /****************
 Branch operations
 ****************/
+template<uint8_t mode>
 void Cpu::BCC()
 {
-	BranchRelative(!CheckFlag(ProcFlags::Carry));
+	BranchRelative<mode>(!CheckFlag(ProcFlags::Carry));
 }
 
+template<uint8_t mode>
 void Cpu::BCS()
 {
-	BranchRelative(CheckFlag(ProcFlags::Carry));
+	BranchRelative<mode>(CheckFlag(ProcFlags::Carry));
 }
 
+template<uint8_t mode>
 void Cpu::BEQ()
 {
-	BranchRelative(CheckFlag(ProcFlags::Zero));
+	BranchRelative<mode>(CheckFlag(ProcFlags::Zero));
 }
 
+template<uint8_t mode>
 void Cpu::BMI()
 {
-	BranchRelative(CheckFlag(ProcFlags::Negative));
+	BranchRelative<mode>(CheckFlag(ProcFlags::Negative));
 }
 
+template<uint8_t mode>
 void Cpu::BNE()
 {
-	BranchRelative(!CheckFlag(ProcFlags::Zero));
+	BranchRelative<mode>(!CheckFlag(ProcFlags::Zero));
 }
 
+template<uint8_t mode>
 void Cpu::BPL()
 {
-	BranchRelative(!CheckFlag(ProcFlags::Negative));
+	BranchRelative<mode>(!CheckFlag(ProcFlags::Negative));
 }
 
+template<uint8_t mode>
 void Cpu::BRA()
 {
-	BranchRelative(true);
+	BranchRelative<mode>(true);
 }
 
 void Cpu::BRL()
@@ -201,22 +210,25 @@ void Cpu::BRL()
 	IdleTakeBranch();
 }
 
+template<uint8_t mode>
 void Cpu::BVC()
 {
-	BranchRelative(!CheckFlag(ProcFlags::Overflow));
+	BranchRelative<mode>(!CheckFlag(ProcFlags::Overflow));
 }
 
+template<uint8_t mode>
 void Cpu::BVS()
 {
-	BranchRelative(CheckFlag(ProcFlags::Overflow));
+	BranchRelative<mode>(CheckFlag(ProcFlags::Overflow));
 }
 
+template<uint8_t mode>
 void Cpu::BranchRelative(bool branch)
 {
 	if(branch) {
 		int8_t offset = _operand;
 		Idle();
-		if(_state.EmulationMode && ((uint16_t)(_state.PC + offset) & 0xFF00) != (_state.PC & 0xFF00)) {
+		if((mode & CpuOpMode::Emulation) && ((uint16_t)(_state.PC + offset) & 0xFF00) != (_state.PC & 0xFF00)) {
 			//Extra cycle in emulation mode if crossing a page
 			Idle();
 		}
@@ -267,6 +279,7 @@ void Cpu::REP()
 {
 	Idle();
 	ClearFlags((uint8_t)_operand);
+	UpdateOpMode();
 }
 
 void Cpu::SEP()
@@ -278,59 +291,70 @@ void Cpu::SEP()
 		_state.Y &= 0xFF;
 		_state.X &= 0xFF;
 	}
+	UpdateOpMode();
 }
 
 /******************************
 Increment/decrement operations
 *******************************/
+template<uint8_t mode>
 void Cpu::DEX()
 {
-	IncDecReg(_state.X, -1);
+	IncDecReg<mode>(_state.X, -1);
 }
 
+template<uint8_t mode>
 void Cpu::DEY()
 {
-	IncDecReg(_state.Y, -1);
+	IncDecReg<mode>(_state.Y, -1);
 }
 
+template<uint8_t mode>
 void Cpu::INX()
 {
-	IncDecReg(_state.X, 1);
+	IncDecReg<mode>(_state.X, 1);
 }
 
+template<uint8_t mode>
 void Cpu::INY()
 {
-	IncDecReg(_state.Y, 1);
+	IncDecReg<mode>(_state.Y, 1);
 }
 
+template<uint8_t mode>
 void Cpu::DEC()
 {
-	IncDec(-1);
+	IncDec<mode>(-1);
 }
 
+template<uint8_t mode>
 void Cpu::INC()
 {
-	IncDec(1);
+	IncDec<mode>(1);
 }
 
+template<uint8_t mode>
 void Cpu::DEC_Acc()
 {
-	SetRegister(_state.A, _state.A - 1, CheckFlag(ProcFlags::MemoryMode8));
+	SetRegister(_state.A, _state.A - 1, mode & CpuOpMode::MemoryMode8);
 }
 
+template<uint8_t mode>
 void Cpu::INC_Acc()
 {
-	SetRegister(_state.A, _state.A + 1, CheckFlag(ProcFlags::MemoryMode8));
+	SetRegister(_state.A, _state.A + 1, mode & CpuOpMode::MemoryMode8);
 }
 
+template<uint8_t mode>
 void Cpu::IncDecReg(uint16_t &reg, int8_t offset)
 {
-	SetRegister(reg, reg + offset, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(reg, reg + offset, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::IncDec(int8_t offset)
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		uint8_t value = GetByteValue() + offset;
 		SetZeroNegativeFlags(value);
 		Idle();
@@ -370,19 +394,22 @@ void Cpu::Compare(uint16_t reg, bool eightBitMode)
 	}
 }
 
+template<uint8_t mode>
 void Cpu::CMP()
 {
-	Compare(_state.A, CheckFlag(ProcFlags::MemoryMode8));
+	Compare(_state.A, mode & CpuOpMode::MemoryMode8);
 }
 
+template<uint8_t mode>
 void Cpu::CPX()
 {
-	Compare(_state.X, CheckFlag(ProcFlags::IndexMode8));
+	Compare(_state.X, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::CPY()
 {
-	Compare(_state.Y, CheckFlag(ProcFlags::IndexMode8));
+	Compare(_state.Y, mode & CpuOpMode::IndexMode8);
 }
 
 /*****************
@@ -502,27 +529,30 @@ void Cpu::COP()
 /******************
 Bitwise operations
 *******************/
+template<uint8_t mode>
 void Cpu::AND()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		SetRegister(_state.A, _state.A & GetByteValue(), true);
 	} else {
 		SetRegister(_state.A, _state.A & GetWordValue(), false);
 	}
 }
 
+template<uint8_t mode>
 void Cpu::EOR()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		SetRegister(_state.A, _state.A ^ GetByteValue(), true);
 	} else {
 		SetRegister(_state.A, _state.A ^ GetWordValue(), false);
 	}
 }
 
+template<uint8_t mode>
 void Cpu::ORA()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		SetRegister(_state.A, _state.A | GetByteValue(), true);
 	} else {
 		SetRegister(_state.A, _state.A | GetWordValue(), false);
@@ -580,18 +610,20 @@ template<typename T> T Cpu::RollRight(T value)
 	return result;
 }
 
+template<uint8_t mode>
 void Cpu::ASL_Acc()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		_state.A = (_state.A & 0xFF00) | (ShiftLeft<uint8_t>((uint8_t)_state.A));
 	} else {
 		_state.A = ShiftLeft<uint16_t>(_state.A);
 	}
 }
 
+template<uint8_t mode>
 void Cpu::ASL()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		Idle();
 		Write(_operand, ShiftLeft<uint8_t>(value));
@@ -602,18 +634,20 @@ void Cpu::ASL()
 	}
 }
 
+template<uint8_t mode>
 void Cpu::LSR_Acc()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		_state.A = (_state.A & 0xFF00) | ShiftRight<uint8_t>((uint8_t)_state.A);
 	} else {
 		_state.A = ShiftRight<uint16_t>(_state.A);
 	}
 }
 
+template<uint8_t mode>
 void Cpu::LSR()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		Idle();
 		Write(_operand, ShiftRight<uint8_t>(value));
@@ -624,18 +658,20 @@ void Cpu::LSR()
 	}
 }
 
+template<uint8_t mode>
 void Cpu::ROL_Acc()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		_state.A = (_state.A & 0xFF00) | RollLeft<uint8_t>((uint8_t)_state.A);
 	} else {
 		_state.A = RollLeft<uint16_t>(_state.A);
 	}
 }
 
+template<uint8_t mode>
 void Cpu::ROL()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		Idle();
 		Write(_operand, RollLeft<uint8_t>(value));
@@ -646,18 +682,20 @@ void Cpu::ROL()
 	}
 }
 
+template<uint8_t mode>
 void Cpu::ROR_Acc()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		_state.A = (_state.A & 0xFF00) | RollRight<uint8_t>((uint8_t)_state.A);
 	} else {
 		_state.A = RollRight<uint16_t>(_state.A);
 	}
 }
 
+template<uint8_t mode>
 void Cpu::ROR()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		Idle();
 		Write(_operand, RollRight<uint8_t>(value));
@@ -671,6 +709,7 @@ void Cpu::ROR()
 /***************
 Move operations
 ****************/
+template<uint8_t mode>
 void Cpu::MVN()
 {
 	_state.DBR = _operand & 0xFF;
@@ -685,7 +724,7 @@ void Cpu::MVN()
 
 	_state.X++;
 	_state.Y++;
-	if(CheckFlag(ProcFlags::IndexMode8)) {
+	if(mode & CpuOpMode::IndexMode8) {
 		_state.X &= 0xFF;
 		_state.Y &= 0xFF;
 	}
@@ -698,6 +737,7 @@ void Cpu::MVN()
 	}
 }
 
+template<uint8_t mode>
 void Cpu::MVP()
 {
 	_state.DBR = _operand & 0xFF;
@@ -712,7 +752,7 @@ void Cpu::MVP()
 
 	_state.X--;
 	_state.Y--;
-	if(CheckFlag(ProcFlags::IndexMode8)) {
+	if(mode & CpuOpMode::IndexMode8) {
 		_state.X &= 0xFF;
 		_state.Y &= 0xFF;
 	}
@@ -800,45 +840,51 @@ void Cpu::PLP()
 	}
 }
 
+template<uint8_t mode>
 void Cpu::PHA()
 {
 	//"When the m flag is 0, PHA and PLA push and pull a 16-bit value, and when the m flag is 1, PHA and PLA push and pull an 8-bit value. "
 	Idle();
-	PushRegister(_state.A, CheckFlag(ProcFlags::MemoryMode8));
+	PushRegister(_state.A, mode & CpuOpMode::MemoryMode8);
 }
 
+template<uint8_t mode>
 void Cpu::PHX()
 {
 	Idle();
-	PushRegister(_state.X, CheckFlag(ProcFlags::IndexMode8));
+	PushRegister(_state.X, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::PHY()
 {
 	Idle();
-	PushRegister(_state.Y, CheckFlag(ProcFlags::IndexMode8));
+	PushRegister(_state.Y, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::PLA()
 {
 	//"When the m flag is 0, PHA and PLA push and pull a 16-bit value, and when the m flag is 1, PHA and PLA push and pull an 8-bit value."
 	Idle();
 	Idle();
-	PullRegister(_state.A, CheckFlag(ProcFlags::MemoryMode8));
+	PullRegister(_state.A, mode & CpuOpMode::MemoryMode8);
 }
 
+template<uint8_t mode>
 void Cpu::PLX()
 {
 	Idle();
 	Idle();
-	PullRegister(_state.X, CheckFlag(ProcFlags::IndexMode8));
+	PullRegister(_state.X, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::PLY()
 {
 	Idle();
 	Idle();
-	PullRegister(_state.Y, CheckFlag(ProcFlags::IndexMode8));
+	PullRegister(_state.Y, mode & CpuOpMode::IndexMode8);
 }
 
 void Cpu::PushRegister(uint16_t reg, bool eightBitMode)
@@ -882,46 +928,53 @@ void Cpu::StoreRegister(uint16_t val, bool eightBitMode)
 	}
 }
 
+template<uint8_t mode>
 void Cpu::LDA()
 {
 	//"When the m flag is 0, LDA, STA, and STZ are 16-bit operations"
-	LoadRegister(_state.A, CheckFlag(ProcFlags::MemoryMode8));
+	LoadRegister(_state.A, mode & CpuOpMode::MemoryMode8);
 }
 
+template<uint8_t mode>
 void Cpu::LDX()
 {
 	//"When the x flag is 0, LDX, LDY, STX, and STY are 16-bit operations"
-	LoadRegister(_state.X, CheckFlag(ProcFlags::IndexMode8));
+	LoadRegister(_state.X, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::LDY()
 {
 	//"When the x flag is 0, LDX, LDY, STX, and STY are 16-bit operations"
-	LoadRegister(_state.Y, CheckFlag(ProcFlags::IndexMode8));
+	LoadRegister(_state.Y, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::STA()
 {
 	//"When the m flag is 0, LDA, STA, and STZ are 16-bit operations"
-	StoreRegister(_state.A, CheckFlag(ProcFlags::MemoryMode8));
+	StoreRegister(_state.A, mode & CpuOpMode::MemoryMode8);
 }
 
+template<uint8_t mode>
 void Cpu::STX()
 {
 	//"When the x flag is 0, LDX, LDY, STX, and STY are 16-bit operations"
-	StoreRegister(_state.X, CheckFlag(ProcFlags::IndexMode8));
+	StoreRegister(_state.X, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::STY()
 {
 	//"When the x flag is 0, LDX, LDY, STX, and STY are 16-bit operations"
-	StoreRegister(_state.Y, CheckFlag(ProcFlags::IndexMode8));
+	StoreRegister(_state.Y, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::STZ()
 {
 	//"When the m flag is 0, LDA, STA, and STZ are 16-bit operations"
-	StoreRegister(0, CheckFlag(ProcFlags::MemoryMode8));
+	StoreRegister(0, mode & CpuOpMode::MemoryMode8);
 }
 
 /*******************
@@ -952,18 +1005,20 @@ template<typename T> void Cpu::TestBits(T value, bool alterZeroFlagOnly)
 	}
 }
 
+template<uint8_t mode>
 void Cpu::BIT()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		TestBits<uint8_t>(GetByteValue(), _immediateMode);
 	} else {
 		TestBits<uint16_t>(GetWordValue(), _immediateMode);
 	}
 }
 
+template<uint8_t mode>
 void Cpu::TRB()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		TestBits<uint8_t>(value, true);
 
@@ -982,9 +1037,10 @@ void Cpu::TRB()
 	}
 }
 
+template<uint8_t mode>
 void Cpu::TSB()
 {
-	if(CheckFlag(ProcFlags::MemoryMode8)) {
+	if(mode & CpuOpMode::MemoryMode8) {
 		uint8_t value = GetByteValue();
 		TestBits<uint8_t>(value, true);
 
@@ -1006,14 +1062,16 @@ void Cpu::TSB()
 /******************
 Transfer operations
 *******************/
+template<uint8_t mode>
 void Cpu::TAX()
 {
-	SetRegister(_state.X, _state.A, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(_state.X, _state.A, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::TAY()
 {
-	SetRegister(_state.Y, _state.A, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(_state.Y, _state.A, mode & CpuOpMode::IndexMode8);
 }
 
 void Cpu::TCD()
@@ -1036,14 +1094,16 @@ void Cpu::TSC()
 	SetRegister(_state.A, _state.SP, false);
 }
 
+template<uint8_t mode>
 void Cpu::TSX()
 {
-	SetRegister(_state.X, _state.SP, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(_state.X, _state.SP, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::TXA()
 {
-	SetRegister(_state.A, _state.X, CheckFlag(ProcFlags::MemoryMode8));
+	SetRegister(_state.A, _state.X, mode & CpuOpMode::MemoryMode8);
 }
 
 void Cpu::TXS()
@@ -1051,19 +1111,22 @@ void Cpu::TXS()
 	SetSP(_state.X);
 }
 
+template<uint8_t mode>
 void Cpu::TXY()
 {
-	SetRegister(_state.Y, _state.X, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(_state.Y, _state.X, mode & CpuOpMode::IndexMode8);
 }
 
+template<uint8_t mode>
 void Cpu::TYA()
 {
-	SetRegister(_state.A, _state.Y, CheckFlag(ProcFlags::MemoryMode8));
+	SetRegister(_state.A, _state.Y, mode & CpuOpMode::MemoryMode8);
 }
 
+template<uint8_t mode>
 void Cpu::TYX()
 {
-	SetRegister(_state.X, _state.Y, CheckFlag(ProcFlags::IndexMode8));
+	SetRegister(_state.X, _state.Y, mode & CpuOpMode::IndexMode8);
 }
 
 void Cpu::XBA()
@@ -1087,6 +1150,7 @@ void Cpu::XCE()
 		SetPS(_state.PS | ProcFlags::IndexMode8 | ProcFlags::MemoryMode8);
 		_state.SP = 0x100 | (_state.SP & 0xFF);
 	}
+	UpdateOpMode();
 }
 
 /*****************
@@ -1125,20 +1189,22 @@ void Cpu::AddrMode_Abs()
 	_operand = GetDataAddress(ReadOperandWord());
 }
 
+template<uint8_t mode>
 void Cpu::AddrMode_AbsIdxX(bool isWrite)
 {
 	uint32_t baseAddr = GetDataAddress(ReadOperandWord());
 	_operand = (baseAddr + _state.X) & 0xFFFFFF;
-	if(isWrite || !CheckFlag(ProcFlags::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
+	if(isWrite || !(mode & CpuOpMode::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
 		Idle();
 	}
 }
 
+template<uint8_t mode>
 void Cpu::AddrMode_AbsIdxY(bool isWrite)
 {
 	uint32_t baseAddr = GetDataAddress(ReadOperandWord());
 	_operand = (baseAddr + _state.Y) & 0xFFFFFF;
-	if(isWrite || !CheckFlag(ProcFlags::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
+	if(isWrite || !(mode & CpuOpMode::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
 		Idle();
 	}
 }
@@ -1228,12 +1294,13 @@ void Cpu::AddrMode_DirIdxIndX()
 	_operand = GetDataAddress(GetDirectAddressIndirectWord(operandByte + _state.X));
 }
 
+template<uint8_t mode>
 void Cpu::AddrMode_DirIndIdxY(bool isWrite)
 {
 	uint32_t baseAddr = GetDataAddress(GetDirectAddressIndirectWord(ReadDirectOperandByte()));
 	_operand = (baseAddr + _state.Y) & 0xFFFFFF;
 	
-	if(isWrite || !CheckFlag(ProcFlags::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
+	if(isWrite || !(mode & CpuOpMode::IndexMode8) || (_operand & 0xFF00) != (baseAddr & 0xFF00)) {
 		Idle();
 	}
 }
@@ -1260,16 +1327,18 @@ void Cpu::AddrMode_Imm16()
 	_operand = ReadOperandWord();
 }
 
+template<uint8_t mode>
 void Cpu::AddrMode_ImmX()
 {
 	_immediateMode = true;
-	_operand = CheckFlag(ProcFlags::IndexMode8) ? ReadOperandByte() : ReadOperandWord();
+	_operand = (mode & CpuOpMode::IndexMode8) ? ReadOperandByte() : ReadOperandWord();
 }
 
+template<uint8_t mode>
 void Cpu::AddrMode_ImmM()
 {
 	_immediateMode = true; 
-	_operand = CheckFlag(ProcFlags::MemoryMode8) ? ReadOperandByte() : ReadOperandWord();
+	_operand = (mode & CpuOpMode::MemoryMode8) ? ReadOperandByte() : ReadOperandWord();
 }
 
 void Cpu::AddrMode_Imp()
@@ -27,7 +27,24 @@ void Cpu::Exec()
 	_immediateMode = false;
 
 	switch(_state.StopState) {
-		case CpuStopState::Running: RunOp(); break;
+		case CpuStopState::Running:
+		#ifndef DUMMYCPU
+			{
+				uint16_t prevPc = _state.PC;
+				_opsSinceIdleLoopStart++;
+				_opCount++;
+				(this->*_runOp)();
+				uint16_t branchOffset = prevPc - _state.PC;
+				if(branchOffset < 8) {
+					//Branched/jumped back by less than 8 bytes (or to itself), this could be a polling loop
+					ProcessIdleLoop((uint8_t)branchOffset);
+				}
+			}
+		#else
+			(this->*_runOp)();
+		#endif
+			break;
+
 		case CpuStopState::Stopped:
 			//STP was executed, CPU no longer executes any code
 		#ifndef DUMMYCPU
@@ -43,6 +60,11 @@ void Cpu::Exec()
 				Idle();
 				_state.StopState = CpuStopState::Running;
 			}
+		#ifndef DUMMYCPU
+			else {
+				ProcessWaitForIrq();
+			}
+		#endif
 			break;
 	}
 
@@ -52,10 +74,12 @@ void Cpu::Exec()
 		_state.NeedNmi = false;
 		uint32_t originalPc = GetProgramAddress(_state.PC);
 		ProcessInterrupt(_state.EmulationMode ? Cpu::LegacyNmiVector : Cpu::NmiVector, true);
+		ResetIdleLoop();
 		_console->ProcessInterrupt<CpuType::Cpu>(originalPc, GetProgramAddress(_state.PC), true);
 	} else if(_state.PrevIrqSource) {
 		uint32_t originalPc = GetProgramAddress(_state.PC);
 		ProcessInterrupt(_state.EmulationMode ? Cpu::LegacyIrqVector : Cpu::IrqVector, true);
+		ResetIdleLoop();
 		_console->ProcessInterrupt<CpuType::Cpu>(originalPc, GetProgramAddress(_state.PC), false);
 	}
 #endif
@@ -116,4 +140,147 @@ void Cpu::Write(uint32_t addr, uint8_t value, MemoryOperationType type)
 	_memoryManager->Write(addr, value, type);
 	UpdateIrqNmiFlags();
 }
+
+bool Cpu::CanSkipIdleCycles()
+{
+	//No interrupt can be pending, otherwise it would be processed after the next instruction
+	return !_state.NeedNmi && !_state.PrevNeedNmi && !_state.PrevIrqSource && !_state.IrqLock;
+}
+
+bool Cpu::DecodeIdleLoop(uint8_t branchOffset)
+{
+	//Recognizes loops that wait for an interrupt or for a value in memory to change:
+	//-A branch/jump to itself (e.g "BRA *" or "JMP *")
+	//-A load/compare/bit test from memory, an optional immediate operation on the loaded register and a conditional branch back to the load
+	//Every iteration then writes the same values to the same registers/flags, until the value in memory changes
+	uint8_t code[9];
+	for(int i = 0; i < 9; i++) {
+		code[i] = _memoryManager->Peek(GetProgramAddress(_state.PC + i));
+	}
+
+	auto isBranchTo = [&code](uint8_t offset, bool allowBra) {
+		//All conditional branches have opcodes $10, $30, ..., $F0 - BRA is $80
+		bool isBranch = (code[offset] & 0x1F) == 0x10 || (allowBra && code[offset] == 0x80);
+		return isBranch && (int8_t)code[offset + 1] == -(offset + 2);
+	};
+
+	_idleLoopReadSize = 0;
+	_idleLoopOpCount = 1;
+	if(branchOffset == 0) {
+		return isBranchTo(0, true) || (code[0] == 0x4C && (code[1] | (code[2] << 8)) == _state.PC);
+	}
+
+	bool memoryMode8 = CheckFlag(ProcFlags::MemoryMode8);
+	bool indexMode8 = CheckFlag(ProcFlags::IndexMode8);
+	bool eightBitMode;
+	uint8_t reg; //0: A, 1: X, 2: Y, 3: only sets flags
+	uint32_t addr;
+	uint8_t length;
+	switch(code[0]) {
+		case 0xA5: case 0xA6: case 0xA4: case 0x24: case 0xC5: case 0xE4: case 0xC4:
+			//LDA/LDX/LDY/BIT/CMP/CPX/CPY dp
+			addr = GetDirectAddress(code[1]);
+			length = 2;
+			break;
+
+		case 0xAD: case 0xAE: case 0xAC: case 0x2C: case 0xCD: case 0xEC: case 0xCC:
+			//LDA/LDX/LDY/BIT/CMP/CPX/CPY abs
+			addr = GetDataAddress(code[1] | (code[2] << 8));
+			length = 3;
+			break;
+
+		case 0xAF:
+			//LDA long
+			addr = code[1] | (code[2] << 8) | (code[3] << 16);
+			length = 4;
+			break;
+
+		default:
+			return false;
+	}
+
+	switch(code[0]) {
+		case 0xA5: case 0xAD: case 0xAF: reg = 0; eightBitMode = memoryMode8; break;
+		case 0xA6: case 0xAE: reg = 1; eightBitMode = indexMode8; break;
+		case 0xA4: case 0xAC: reg = 2; eightBitMode = indexMode8; break;
+		case 0xE4: case 0xEC: case 0xC4: case 0xCC: reg = 3; eightBitMode = indexMode8; break;
+		default: reg = 3; eightBitMode = memoryMode8; break;
+	}
+
+	//AND/ORA/EOR/CMP/BIT #imm after LDA, CPX #imm after LDX, CPY #imm after LDY
+	uint8_t op = code[length];
+	bool immOp = (
+		(reg == 0 && (op == 0x29 || op == 0x09 || op == 0x49 || op == 0xC9 || op == 0x89)) ||
+		(reg == 1 && op == 0xE0) ||
+		(reg == 2 && op == 0xC0)
+	);
+	if(immOp) {
+		length += eightBitMode ? 2 : 3;
+	}
+	_idleLoopOpCount = immOp ? 3 : 2;
+
+	if(length != branchOffset || !isBranchTo(length, false)) {
+		return false;
+	}
+
+	_idleLoopReadAddr[0] = addr;
+	_idleLoopReadAddr[1] = (addr + 1) & 0xFFFFFF;
+	_idleLoopReadSize = eightBitMode ? 1 : 2;
+	return true;
+}
+
+void Cpu::ProcessIdleLoop(uint8_t branchOffset)
+{
+	//The offset of the branch is part of the key: only iterations that end with the loop's own branch are counted
+	uint64_t key = (
+		GetProgramAddress(_state.PC) | ((uint64_t)_state.D << 24) | ((uint64_t)_state.DBR << 40) |
+		((uint64_t)(_state.PS & (ProcFlags::MemoryMode8 | ProcFlags::IndexMode8)) << 48) |
+		((uint64_t)_state.EmulationMode << 56) | ((uint64_t)branchOffset << 57)
+	);
+
+	uint64_t clock = _memoryManager->GetMasterClock();
+	uint16_t hClock = _memoryManager->GetHClock();
+	if(key != _idleLoopKey) {
+		_idleLoopKey = key;
+		_idleLoopValid = DecodeIdleLoop(branchOffset);
+		_idleLoopPeriod = 0;
+	} else if(!_idleLoopValid) {
+		return;
+	} else {
+		//An iteration is only used if it ran just the loop's instructions and didn't cross a scanline event (which could change the value the next iteration reads)
+		//The loop is skipped once 2 consecutive iterations took the same time (a DRAM refresh or a DMA during one of them changes its length)
+		uint32_t period = (uint32_t)(clock - _idleLoopStartClock);
+		uint32_t cycles = (uint32_t)(_state.CycleCount - _idleLoopStartCycle);
+		bool validIteration = _opsSinceIdleLoopStart == _idleLoopOpCount && hClock > _idleLoopStartHClock && (uint32_t)(hClock - _idleLoopStartHClock) == period;
+		if(validIteration && period == _idleLoopPeriod && cycles == _idleLoopCycles) {
+			if(CanSkipIdleCycles()) {
+				uint32_t count = _memoryManager->SkipIdleCycles(_idleLoopReadAddr, _idleLoopReadSize, period);
+				_state.CycleCount += (uint64_t)count * cycles;
+				_idleSkippedClocks += (uint64_t)count * period;
+				clock = _memoryManager->GetMasterClock();
+				hClock = _memoryManager->GetHClock();
+			}
+		} else {
+			//Something else may have run during this iteration (e.g HDMA or other code) and modified the loop's code
+			_idleLoopValid = DecodeIdleLoop(branchOffset);
+		}
+		_idleLoopPeriod = validIteration ? period : 0;
+		_idleLoopCycles = cycles;
+	}
+
+	_idleLoopStartClock = clock;
+	_idleLoopStartCycle = _state.CycleCount;
+	_idleLoopStartHClock = hClock;
+	_opsSinceIdleLoopStart = 0;
+}
+
+void Cpu::ProcessWaitForIrq()
+{
+	//WAI runs 1 idle cycle (6 master clocks) at a time until an IRQ or NMI occurs
+	if(!_state.IrqSource && CanSkipIdleCycles()) {
+		uint32_t count = _memoryManager->SkipIdleCycles(nullptr, 0, 6);
+		_state.CycleCount += count;
+		_idleSkippedClocks += count * 6;
+	}
+}
 #endif
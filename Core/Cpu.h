@@ -38,6 +38,7 @@ private:
 	bool _immediateMode = false;
 
 	CpuState _state = {};
+	Func _runOp = nullptr;
 	uint32_t _operand = -1;
 
 	uint32_t GetProgramAddress(uint16_t addr);
@@ -104,24 +105,24 @@ private:
 	//Add/substract instructions
 	void Add8(uint8_t value);
 	void Add16(uint16_t value);
-	void ADC();
+	template<uint8_t mode> void ADC();
 
 	void Sub8(uint8_t value);
 	void Sub16(uint16_t value);
-	void SBC();
+	template<uint8_t mode> void SBC();
 	
 	//Branch instructions
-	void BCC();
-	void BCS();
-	void BEQ();
-	void BMI();
-	void BNE();
-	void BPL();
-	void BRA();
+	template<uint8_t mode> void BCC();
+	template<uint8_t mode> void BCS();
+	template<uint8_t mode> void BEQ();
+	template<uint8_t mode> void BMI();
+	template<uint8_t mode> void BNE();
+	template<uint8_t mode> void BPL();
+	template<uint8_t mode> void BRA();
 	void BRL();
-	void BVC();
-	void BVS();
-	void BranchRelative(bool branch);
+	template<uint8_t mode> void BVC();
+	template<uint8_t mode> void BVS();
+	template<uint8_t mode> void BranchRelative(bool branch);
 	
 	//Set/clear flag instructions
 	void CLC();
@@ -136,24 +137,24 @@ private:
 	void SEP();
 
 	//Increment/decrement instructions
-	void DEX();
-	void DEY();
-	void INX();
-	void INY();
-	void DEC();
-	void INC();
+	template<uint8_t mode> void DEX();
+	template<uint8_t mode> void DEY();
+	template<uint8_t mode> void INX();
+	template<uint8_t mode> void INY();
+	template<uint8_t mode> void DEC();
+	template<uint8_t mode> void INC();
 
-	void DEC_Acc();
-	void INC_Acc();
+	template<uint8_t mode> void DEC_Acc();
+	template<uint8_t mode> void INC_Acc();
 
-	void IncDecReg(uint16_t & reg, int8_t offset);
-	void IncDec(int8_t offset);
+	template<uint8_t mode> void IncDecReg(uint16_t & reg, int8_t offset);
+	template<uint8_t mode> void IncDec(int8_t offset);
 
 	//Compare instructions
 	void Compare(uint16_t reg, bool eightBitMode);
-	void CMP();
-	void CPX();
-	void CPY();
+	template<uint8_t mode> void CMP();
+	template<uint8_t mode> void CPX();
+	template<uint8_t mode> void CPY();
 
 	//Jump instructions
 	void JML();
@@ -170,9 +171,9 @@ private:
 	void COP();
 
 	//Bitwise operations
-	void AND();
-	void EOR();
-	void ORA();
+	template<uint8_t mode> void AND();
+	template<uint8_t mode> void EOR();
+	template<uint8_t mode> void ORA();
 
 	template<typename T> T ShiftLeft(T value);
 	template<typename T> T RollLeft(T value);
@@ -180,18 +181,18 @@ private:
 	template<typename T> T RollRight(T value);
 
 	//Shift operations
-	void ASL_Acc();
-	void ASL();
-	void LSR_Acc();
-	void LSR();
-	void ROL_Acc();
-	void ROL();
-	void ROR_Acc();
-	void ROR();
+	template<uint8_t mode> void ASL_Acc();
+	template<uint8_t mode> void ASL();
+	template<uint8_t mode> void LSR_Acc();
+	template<uint8_t mode> void LSR();
+	template<uint8_t mode> void ROL_Acc();
+	template<uint8_t mode> void ROL();
+	template<uint8_t mode> void ROR_Acc();
+	template<uint8_t mode> void ROR();
 
 	//Move operations
-	void MVN();
-	void MVP();
+	template<uint8_t mode> void MVN();
+	template<uint8_t mode> void MVP();
 
 	//Push/pull instructions
 	void PEA();
@@ -205,12 +206,12 @@ private:
 	void PLD();
 	void PLP();
 
-	void PHA();
-	void PHX();
-	void PHY();
-	void PLA();
-	void PLX();
-	void PLY();
+	template<uint8_t mode> void PHA();
+	template<uint8_t mode> void PHX();
+	template<uint8_t mode> void PHY();
+	template<uint8_t mode> void PLA();
+	template<uint8_t mode> void PLX();
+	template<uint8_t mode> void PLY();
 
 	void PushRegister(uint16_t reg, bool eightBitMode);
 	void PullRegister(uint16_t &reg, bool eightBitMode);
@@ -219,35 +220,35 @@ private:
 	void LoadRegister(uint16_t &reg, bool eightBitMode);
 	void StoreRegister(uint16_t val, bool eightBitMode);
 
-	void LDA();
-	void LDX();
-	void LDY();
+	template<uint8_t mode> void LDA();
+	template<uint8_t mode> void LDX();
+	template<uint8_t mode> void LDY();
 
-	void STA();
-	void STX();
-	void STY();
-	void STZ();
+	template<uint8_t mode> void STA();
+	template<uint8_t mode> void STX();
+	template<uint8_t mode> void STY();
+	template<uint8_t mode> void STZ();
 		
 	//Test bits
 	template<typename T> void TestBits(T value, bool alterZeroFlagOnly);
-	void BIT();
+	template<uint8_t mode> void BIT();
 
-	void TRB();
-	void TSB();
+	template<uint8_t mode> void TRB();
+	template<uint8_t mode> void TSB();
 
 	//Transfer registers
-	void TAX();
-	void TAY();
+	template<uint8_t mode> void TAX();
+	template<uint8_t mode> void TAY();
 	void TCD();
 	void TCS();
 	void TDC();
 	void TSC();
-	void TSX();
-	void TXA();
+	template<uint8_t mode> void TSX();
+	template<uint8_t mode> void TXA();
 	void TXS();
-	void TXY();
-	void TYA();
-	void TYX();
+	template<uint8_t mode> void TXY();
+	template<uint8_t mode> void TYA();
+	template<uint8_t mode> void TYX();
 	void XBA();
 	void XCE();
 
@@ -263,9 +264,9 @@ private:
 	//Absolute: a
 	void AddrMode_Abs();
 	//Absolute Indexed: a,x
-	void AddrMode_AbsIdxX(bool isWrite);
+	template<uint8_t mode> void AddrMode_AbsIdxX(bool isWrite);
 	//Absolute Indexed: a,y
-	void AddrMode_AbsIdxY(bool isWrite);
+	template<uint8_t mode> void AddrMode_AbsIdxY(bool isWrite);
 	//Absolute Long: al
 	void AddrMode_AbsLng();
 	//Absolute Long Indexed: al,x
@@ -295,7 +296,7 @@ private:
 	//Direct Indexed Indirect: (d,x)
 	void AddrMode_DirIdxIndX();
 	//Direct Indirect Indexed: (d),y
-	void AddrMode_DirIndIdxY(bool isWrite);
+	template<uint8_t mode> void AddrMode_DirIndIdxY(bool isWrite);
 	//Direct Indirect Long: [d]
 	void AddrMode_DirIndLng();
 	//Direct Indirect Indexed Long: [d],y
@@ -303,8 +304,8 @@ private:
 
 	void AddrMode_Imm8();
 	void AddrMode_Imm16();
-	void AddrMode_ImmX();
-	void AddrMode_ImmM();
+	template<uint8_t mode> void AddrMode_ImmX();
+	template<uint8_t mode> void AddrMode_ImmM();
 
 	void AddrMode_Imp();
 
@@ -314,7 +315,31 @@ private:
 	void AddrMode_StkRel();
 	void AddrMode_StkRelIndIdxY();
 	
-	void RunOp();
+	template<uint8_t mode> void RunOp();
+	void UpdateOpMode();
+
+#ifndef DUMMYCPU
+	//Polling loop currently executed by the CPU (see ProcessIdleLoop)
+	uint64_t _idleLoopKey = -1;
+	bool _idleLoopValid = false;
+	uint32_t _idleLoopReadAddr[2] = {};
+	uint8_t _idleLoopReadSize = 0;
+	uint8_t _idleLoopOpCount = 0;
+	uint32_t _opsSinceIdleLoopStart = 0;
+	uint64_t _idleLoopStartClock = 0;
+	uint64_t _idleLoopStartCycle = 0;
+	uint16_t _idleLoopStartHClock = 0;
+	uint32_t _idleLoopPeriod = 0;
+	uint32_t _idleLoopCycles = 0;
+
+	uint64_t _idleSkippedClocks = 0;
+	uint64_t _opCount = 0;
+
+	bool CanSkipIdleCycles();
+	bool DecodeIdleLoop(uint8_t branchOffset);
+	void ProcessIdleLoop(uint8_t branchOffset);
+	void ProcessWaitForIrq();
+#endif
 
 public:
 #ifndef DUMMYCPU
@@ -332,9 +357,15 @@ public:
 
 	CpuState GetState();
 	uint64_t GetCycleCount();
+#ifndef DUMMYCPU
+	uint64_t GetIdleSkippedClocks() { return _idleSkippedClocks; }
+	uint64_t GetOpCount() { return _opCount; }
+	void ResetIdleLoop() { _idleLoopKey = -1; }
+#endif
 	void SetState(CpuState& state)
 	{
 		_state = state;
+		UpdateOpMode();
 	}
 
 	template<uint64_t value>
@@ -71,6 +71,17 @@ namespace ProcFlags
 	};
 }
 
+namespace CpuOpMode
+{
+	//Flag combination the instruction handlers are specialized for (see Cpu::UpdateOpMode)
+	enum CpuOpMode : uint8_t
+	{
+		IndexMode8 = 0x01,
+		MemoryMode8 = 0x02,
+		Emulation = 0x04
+	};
+}
+
 enum class MemoryOperationType
 {
 	Read = 0,
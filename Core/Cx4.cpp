@@ -45,13 +45,14 @@ Cx4::Cx4(Console* console) : BaseCoprocessor(SnesMemoryType::Register)
 	_mappings.RegisterHandler(0x00, 0x3F, 0x6000, 0x7FFF, this);
 	_mappings.RegisterHandler(0x80, 0xBF, 0x6000, 0x7FFF, this);
 
-	_clockRatio = (double)20000000 / console->GetMasterClockRate();
+	_clock.SetRatio(20000000, console->GetMasterClockRate());
 	Reset();
 }
 
 void Cx4::Reset()
 {
 	_state = {};
+	_clock.Reset();
 	_state.Stopped = true;
 	_state.SingleRom = true;
 	_state.RomAccessDelay = 3;
@@ -60,7 +61,7 @@ void Cx4::Reset()
 
 void Cx4::Run()
 {
-	uint64_t targetCycle = (uint64_t)(_memoryManager->GetMasterClock() * _clockRatio);
+	uint64_t targetCycle = _clock.GetCycle(_memoryManager->GetMasterClock());
 
 	while(_state.CycleCount < targetCycle) {
 		if(_state.Locked) {
@@ -141,7 +142,7 @@ void Cx4::SwitchCachePage()
 
 	_state.PB = _state.P;
 
-	uint64_t targetCycle = (uint64_t)(_memoryManager->GetMasterClock() * _clockRatio);
+	uint64_t targetCycle = _clock.GetCycle(_memoryManager->GetMasterClock());
 	if(!ProcessCache(targetCycle) && !_state.Cache.Enabled) {
 		Stop();
 	}
@@ -443,6 +444,7 @@ void Cx4::Serialize(Serializer &s)
 	s.StreamArray(_prgRam[0], 256);
 	s.StreamArray(_prgRam[1], 256);
 	s.StreamArray(_dataRam, Cx4::DataRamSize);
+	_clock.Serialize(s);
 }
 
 uint8_t Cx4::Peek(uint32_t addr)
@@ -3,6 +3,7 @@
 #include "BaseCoprocessor.h"
 #include "Cx4Types.h"
 #include "MemoryMappings.h"
+#include "ClockDomain.h"
 
 class Console;
 class MemoryManager;
@@ -17,7 +18,7 @@ private:
 	MemoryManager *_memoryManager;
 	Cpu *_cpu;
 	MemoryMappings _mappings;
-	double _clockRatio;
+	ClockDomain _clock;
 
 	Cx4State _state;
 	uint16_t _prgRam[2][256];
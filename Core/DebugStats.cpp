@@ -5,6 +5,8 @@
 #include "EmuSettings.h"
 #include "DebugHud.h"
 #include "IAudioDevice.h"
+#include "FrameLimiter.h"
+#include "VideoDecoder.h"
 
 void DebugStats::DisplayStats(Console *console, double lastFrameTime)
 {
@@ -64,4 +66,50 @@ void DebugStats::DisplayStats(Console *console, double lastFrameTime)
 	ss = std::stringstream();
 	ss << "Max Delay: " << std::fixed << std::setprecision(2) << _lastFrameMax << " ms";
 	hud->DrawString(134, 48, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+	//Lock contention since the last frame (spinning locks & locks that had to put the thread to sleep)
+	SimpleLockStats lockStats = SimpleLock::GetStats();
+	hud->DrawRectangle(8, 62, 115, 31, 0x40000000, true, 1, startFrame);
+	hud->DrawRectangle(8, 62, 115, 31, 0xFFFFFF, false, 1, startFrame);
+	hud->DrawString(10, 64, "Lock Stats", 0xFFFFFF, 0xFF000000, 1, startFrame);
+	hud->DrawString(10, 75, "Contended: " + std::to_string(lockStats.ContentionCount - _lastLockStats.ContentionCount), 0xFFFFFF, 0xFF000000, 1, startFrame);
+	hud->DrawString(10, 84, "Parked: " + std::to_string(lockStats.ParkCount - _lastLockStats.ParkCount), 0xFFFFFF, 0xFF000000, 1, startFrame);
+	_lastLockStats = lockStats;
+
+	//Average time spent in each stage of the video decoder (color conversion, HUD, scaling filter)
+	VideoFilterStats filterStats = console->GetVideoDecoder()->GetFilterStats();
+	hud->DrawRectangle(8, 98, 115, 40, 0x40000000, true, 1, startFrame);
+	hud->DrawRectangle(8, 98, 115, 40, 0xFFFFFF, false, 1, startFrame);
+	hud->DrawString(10, 100, "Filter Stats", 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+	ss = std::stringstream();
+	ss << "Filter: " << std::fixed << std::setprecision(2) << filterStats.FilterTime << " ms";
+	hud->DrawString(10, 111, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+	ss = std::stringstream();
+	ss << "HUD: " << std::fixed << std::setprecision(2) << filterStats.HudTime << " ms";
+	hud->DrawString(10, 120, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+	ss = std::stringstream();
+	ss << "Scale: " << std::fixed << std::setprecision(2) << filterStats.ScaleTime << " ms";
+	hud->DrawString(10, 129, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+	FramePacingStats pacing = console->GetFramePacingStats();
+	hud->DrawRectangle(132, 62, 115, 49, 0x40000000, true, 1, startFrame);
+	hud->DrawRectangle(132, 62, 115, 49, 0xFFFFFF, false, 1, startFrame);
+	hud->DrawString(134, 64, "Frame Pacing", 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+	ss = std::stringstream();
+	ss << "Jitter: " << std::fixed << std::setprecision(2) << pacing.AverageJitter << " ms";
+	hud->DrawString(134, 75, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+	ss = std::stringstream();
+	ss << "Max Jitter: " << std::fixed << std::setprecision(2) << pacing.MaxJitter << " ms";
+	hud->DrawString(134, 84, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+	hud->DrawString(134, 93, "Missed: " + std::to_string(pacing.MissedDeadlines), pacing.MissedDeadlines > 0 ? 0xFF0000 : 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+	ss = std::stringstream();
+	ss << "Input Lag: " << std::fixed << std::setprecision(2) << pacing.InputLatency << " ms";
+	hud->DrawString(134, 102, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
 }
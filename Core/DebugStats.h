@@ -1,5 +1,6 @@
 #pragma once
 #include "stdafx.h"
+#include "../Utilities/SimpleLock.h"
 
 class Console;
 
@@ -10,6 +11,7 @@ private:
 	uint32_t _frameDurationIndex = 0;
 	double _lastFrameMin = 9999;
 	double _lastFrameMax = 0;
+	SimpleLockStats _lastLockStats = {};
 
 public:
 	void DisplayStats(Console *console, double lastFrameTime);
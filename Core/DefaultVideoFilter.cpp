@@ -5,6 +5,7 @@
 #include "Console.h"
 #include "EmuSettings.h"
 #include "SettingTypes.h"
+#include "PixelKernels.h"
 
 const static double PI = 3.14159265358979323846;
 
@@ -79,6 +80,8 @@ void DefaultVideoFilter::InitLookupTable()
 		}
 	}
 
+	//Without any color adjustments, the palette is a plain 5-bit to 8-bit conversion that can be done without the lookup table
+	_useDirectConversion = !_gbcAdjustColors && config.Hue == 0 && config.Saturation == 0 && config.Brightness == 0 && config.Contrast == 0;
 	_videoConfig = config;
 }
 
@@ -123,60 +126,46 @@ void DefaultVideoFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 	uint32_t yOffset = overscan.Top * overscanMultiplier * width;
 
 	uint8_t scanlineIntensity = (uint8_t)((1.0 - _console->GetSettings()->GetVideoConfig().ScanlineIntensity) * 255);
-	if(scanlineIntensity < 255) {
-		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			if(i & 0x01) {
-				for(uint32_t j = 0; j < frameInfo.Width; j++) {
-					*out = ApplyScanlineEffect(GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset), scanlineIntensity);
-					out++;
-				}
-			} else {
-				for(uint32_t j = 0; j < frameInfo.Width; j++) {
-					*out = GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset);
-					out++;
-				}
+	bool blendHighRes = _baseFrameInfo.Width == 512 && _videoConfig.BlendHighResolutionModes;
+
+	//Bands start on even rows, so the high resolution blend's row pairs are never split between 2 bands
+	ProcessRows(frameInfo.Height, 2, [&](uint32_t firstRow, uint32_t lastRow) {
+		for(uint32_t i = firstRow; i < lastRow; i++) {
+			uint32_t* rowOut = out + i * frameInfo.Width;
+			ConvertRow(ppuOutputBuffer, i * width + yOffset + xOffset, rowOut, frameInfo.Width);
+			if((i & 0x01) && scanlineIntensity < 255) {
+				PixelKernels::ApplyScanlines(rowOut, frameInfo.Width, scanlineIntensity);
 			}
 		}
-	} else {
-		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			for(uint32_t j = 0; j < frameInfo.Width; j++) {
-				out[i*frameInfo.Width+j] = GetPixel(ppuOutputBuffer, i * width + j + yOffset + xOffset);
-			}
-		}
-	}
 
-	if(_baseFrameInfo.Width == 512 && _videoConfig.BlendHighResolutionModes) {
-		//Very basic blend effect for high resolution modes
-		for(uint32_t i = 0; i < frameInfo.Height; i+=2) {
-			for(uint32_t j = 0; j < frameInfo.Width; j+=2) {
-				uint32_t &pixel1 = out[i*frameInfo.Width + j];
-				uint32_t &pixel2 = out[i*frameInfo.Width + j + 1];
-				uint32_t &pixel3 = out[(i+1)*frameInfo.Width + j];
-				uint32_t &pixel4 = out[(i+1)*frameInfo.Width + j + 1];
-				pixel1 = pixel2 = pixel3 = pixel4 = BlendPixels(BlendPixels(BlendPixels(pixel1, pixel2), pixel3), pixel4);
+		if(blendHighRes) {
+			//Very basic blend effect for high resolution modes
+			for(uint32_t i = firstRow; i + 1 < lastRow; i += 2) {
+				PixelKernels::BlendHighResBlocks(out + i * frameInfo.Width, out + (i + 1) * frameInfo.Width, frameInfo.Width);
 			}
 		}
-	}
+	});
 
 	if(_gbBlendFrames) {
 		std::copy(ppuOutputBuffer, ppuOutputBuffer + 256 * 240, _prevFrame);
 	}
 }
 
-uint32_t DefaultVideoFilter::GetPixel(uint16_t* ppuFrame, uint32_t offset)
+void DefaultVideoFilter::ConvertRow(uint16_t* ppuFrame, uint32_t offset, uint32_t* out, uint32_t pixelCount)
 {
 	if(_gbBlendFrames) {
-		return BlendPixels(_calculatedPalette[_prevFrame[offset]], _calculatedPalette[ppuFrame[offset]]);
+		for(uint32_t i = 0; i < pixelCount; i++) {
+			out[i] = PixelKernels::BlendPixels(_calculatedPalette[_prevFrame[offset + i]], _calculatedPalette[ppuFrame[offset + i]]);
+		}
+	} else if(_useDirectConversion) {
+		PixelKernels::ConvertRgb555(ppuFrame + offset, out, pixelCount);
 	} else {
-		return _calculatedPalette[ppuFrame[offset]];
+		for(uint32_t i = 0; i < pixelCount; i++) {
+			out[i] = _calculatedPalette[ppuFrame[offset + i]];
+		}
 	}
 }
 
-uint32_t DefaultVideoFilter::BlendPixels(uint32_t a, uint32_t b)
-{
-	return ((((a) ^ (b)) & 0xfffefefeL) >> 1) + ((a) & (b));
-}
-
 void DefaultVideoFilter::RgbToYiq(double r, double g, double b, double &y, double &i, double &q)
 {
 	y = r * 0.299f + g * 0.587f + b * 0.114f;
@@ -14,6 +14,7 @@ private:
 	uint16_t* _prevFrame = nullptr;
 	bool _gbBlendFrames = false;
 	bool _gbcAdjustColors = false;
+	bool _useDirectConversion = false;
 
 	void InitConversionMatrix(double hueShift, double saturationShift);
 	void InitLookupTable();
@@ -21,8 +22,7 @@ private:
 	void RgbToYiq(double r, double g, double b, double &y, double &i, double &q);
 	void YiqToRgb(double y, double i, double q, double &r, double &g, double &b);
 	__forceinline static uint8_t To8Bit(uint8_t color);
-	__forceinline static uint32_t BlendPixels(uint32_t a, uint32_t b);
-	__forceinline uint32_t GetPixel(uint16_t* ppuFrame, uint32_t offset);
+	void ConvertRow(uint16_t* ppuFrame, uint32_t offset, uint32_t* out, uint32_t pixelCount);
 
 protected:
 	void OnBeforeApplyFilter();
@@ -74,6 +74,11 @@ void DmaController::RunDma(DmaChannelConfig &channel)
 
 	uint8_t i = 0;
 	do {
+		if(RunDmaBlock(channel, i)) {
+			ProcessPendingTransfers();
+			continue;
+		}
+
 		//Manual DMA transfers run to the end of the transfer when started
 		CopyDmaByte(
 			(channel.SrcBank << 16) | channel.SrcAddress,
@@ -93,6 +98,43 @@ void DmaController::RunDma(DmaChannelConfig &channel)
 	channel.DmaActive = false;
 }
 
+bool DmaController::RunDmaBlock(DmaChannelConfig &channel, uint8_t &transferIndex)
+{
+	//Fast path for large transfers to the PPU/WRAM data ports (e.g ROM->VRAM), see MemoryManager::RunDmaBlock
+	constexpr uint32_t minBlockSize = 8;
+
+	if(channel.InvertDirection || _needToProcess) {
+		return false;
+	}
+
+	uint32_t length = channel.TransferSize ? channel.TransferSize : 0x10000;
+	if(!channel.FixedTransfer) {
+		//Keep the block within the source's 4kb page (which also prevents wrapping around the bank)
+		uint32_t pageOffset = channel.SrcAddress & 0xFFF;
+		length = std::min(length, channel.Decrement ? pageOffset + 1 : 0x1000 - pageOffset);
+	}
+	length = std::min(length, _memoryManager->GetDmaBlockLimit());
+	if(length < minBlockSize) {
+		return false;
+	}
+
+	const uint8_t *transferOffsets = _transferOffset[channel.TransferMode];
+	uint16_t destAddr[4];
+	for(int i = 0; i < 4; i++) {
+		destAddr[i] = 0x2100 | (channel.DestAddress + transferOffsets[i]);
+	}
+
+	int8_t step = channel.FixedTransfer ? 0 : (channel.Decrement ? -1 : 1);
+	if(!_memoryManager->RunDmaBlock((channel.SrcBank << 16) | channel.SrcAddress, step, destAddr, transferIndex & 0x03, length)) {
+		return false;
+	}
+
+	channel.SrcAddress += step * (int32_t)length;
+	channel.TransferSize -= (uint16_t)length;
+	transferIndex += (uint8_t)length;
+	return true;
+}
+
 bool DmaController::InitHdmaChannels()
 {
 	_hdmaInitPending = false;
@@ -27,6 +27,7 @@ private:
 	void CopyDmaByte(uint32_t addressBusA, uint16_t addressBusB, bool fromBtoA);
 
 	void RunDma(DmaChannelConfig &channel);
+	bool RunDmaBlock(DmaChannelConfig &channel, uint8_t &transferIndex);
 	
 	void RunHdmaTransfer(DmaChannelConfig &channel);
 	bool ProcessHdmaChannels();
@@ -48,6 +49,7 @@ public:
 	void BeginHdmaInit();
 
 	bool ProcessPendingTransfers();
+	bool HasPendingTransfers() { return _needToProcess; }
 
 	void Write(uint16_t addr, uint8_t value);
 	uint8_t Read(uint16_t addr);
@@ -37,6 +37,7 @@ void DummyCpu::SetDummyState(CpuState &state)
 {
 	_state = state;
 	_state.StopState = CpuStopState::Running;
+	UpdateOpMode();
 	_writeCounter = 0;
 	_readCounter = 0;
 }
@@ -7,6 +7,7 @@
 #include "SpcDisUtils.h"
 #include "NotificationManager.h"
 #include "../Utilities/FolderUtilities.h"
+#include "../Utilities/VirtualFile.h"
 
 EmuSettings::EmuSettings(Console* console)
 {
@@ -149,6 +150,8 @@ void EmuSettings::SetPreferences(PreferencesConfig config)
 		""
 	);
 
+	VirtualFile::SetCacheFolder(config.CacheDecompressedRoms ? FolderUtilities::GetRomCacheFolder() : "");
+
 	_preferences = config;
 }
 
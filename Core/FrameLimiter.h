@@ -1,19 +1,34 @@
 #pragma once
 #include "../Utilities/Timer.h"
 
+struct FramePacingStats
+{
+	double LastJitter = 0;
+	double AverageJitter = 0;
+	double MaxJitter = 0;
+	uint32_t MissedDeadlines = 0;
+	double InputLatency = 0;
+};
+
 class FrameLimiter
 {
 private:
+	//A frame that starts more than this many ms after its target time is counted as a missed deadline
+	static constexpr double MissedDeadlineThreshold = 2.0;
+
 	Timer _clockTimer;
 	double _targetTime;
 	double _delay;
+	double _clockAdjustment;
 	bool _resetRunTimers;
+	FramePacingStats _stats;
 
 public:
 	FrameLimiter(double delay)
 	{
 		_delay = delay;
 		_targetTime = _delay;
+		_clockAdjustment = 1.0;
 		_resetRunTimers = false;
 	}
 
@@ -23,6 +38,12 @@ public:
 		_resetRunTimers = true;
 	}
 
+	void SetClockAdjustment(double adjustment)
+	{
+		//Used to slave the frame rate to the audio device's clock (> 1 slows down emulation)
+		_clockAdjustment = adjustment;
+	}
+
 	void ProcessFrame()
 	{
 		if(_resetRunTimers || (_clockTimer.GetElapsedMS() - _targetTime) > 300) {
@@ -36,7 +57,7 @@ public:
 			_resetRunTimers = false;
 		}
 
-		_targetTime += _delay;
+		_targetTime += _delay * _clockAdjustment;
 	}
 
 	bool WaitForNextFrame()
@@ -48,6 +69,22 @@ public:
 		}
 
 		_clockTimer.WaitUntil(_targetTime);
+		UpdateStats(_clockTimer.GetElapsedMS() - _targetTime);
 		return false;
 	}
-};
\ No newline at end of file
+
+	void UpdateStats(double jitter)
+	{
+		_stats.LastJitter = jitter;
+		_stats.AverageJitter = _stats.AverageJitter * 0.95 + jitter * 0.05;
+		_stats.MaxJitter = std::max(_stats.MaxJitter, jitter);
+		if(jitter > FrameLimiter::MissedDeadlineThreshold) {
+			_stats.MissedDeadlines++;
+		}
+	}
+
+	FramePacingStats GetStats()
+	{
+		return _stats;
+	}
+};
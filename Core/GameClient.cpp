@@ -72,6 +72,8 @@ void GameClient::PrivateConnect(ClientConnectionData &connectionData)
 void GameClient::Exec()
 {
 	if(_connected) {
+		vector<Socket*> sockets = { _connection->GetSocket() };
+		vector<bool> ready;
 		while(!_stop) {
 			if(!_connection->ConnectionError()) {
 				_connection->ProcessMessages();
@@ -82,7 +84,9 @@ void GameClient::Exec()
 				_connection.reset();
 				break;
 			}
-			std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+
+			//Wake up as soon as the server sends something, the timeout is used to poll the local input
+			Socket::Poll(sockets, ready, 1);
 		}
 	}
 }
@@ -16,6 +16,8 @@
 #include "ServerInformationMessage.h"
 #include "NotificationManager.h"
 #include "RomFinder.h"
+#include "RollbackInputMessage.h"
+#include "RollbackManager.h"
 
 GameClientConnection::GameClientConnection(shared_ptr<Console> console, shared_ptr<Socket> socket, ClientConnectionData &connectionData) : GameConnection(console, socket)
 {
@@ -38,9 +40,12 @@ void GameClientConnection::Shutdown()
 		_shutdown = true;
 		DisableControllers();
 
-		shared_ptr<ControlManager> controlManager = _console->GetControlManager();
-		if(controlManager) {
-			controlManager->UnregisterInputProvider(this);
+		UnregisterInputProvider();
+
+		if(_rollbackManager) {
+			_console->Lock();
+			_console->SetRollbackManager(nullptr);
+			_console->Unlock();
 		}
 
 		MessageManager::DisplayMessage("NetPlay", "ConnectionLost");
@@ -65,8 +70,8 @@ void GameClientConnection::ClearInputData()
 	LockHandler lock = _writeLock.AcquireSafe();
 	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
 		_inputSize[i] = 0;
-		_inputData[i].clear();
 	}
+	_inputData.Clear();
 }
 
 void GameClientConnection::ProcessMessage(NetMessage* message)
@@ -87,6 +92,11 @@ void GameClientConnection::ProcessMessage(NetMessage* message)
 				((SaveStateMessage*)message)->LoadState(_console);
 				_enableControllers = true;
 				InitControlDevice();
+				if(_rollbackManager) {
+					//The state is the server's sync point, inputs from that frame onward follow this message
+					_rollbackManager->Reset(_rollbackSyncId, ((SaveStateMessage*)message)->GetRollbackFrame());
+					_console->SetRollbackManager(_rollbackManager);
+				}
 				_console->Unlock();
 			}
 			break;
@@ -97,6 +107,13 @@ void GameClientConnection::ProcessMessage(NetMessage* message)
 			}
 			break;
 
+		case MessageType::RollbackInput:
+			if(_gameLoaded && _rollbackManager) {
+				RollbackInputMessage* input = (RollbackInputMessage*)message;
+				_rollbackManager->AddRemoteInput(input->GetSyncId(), input->GetFrame(), input->GetPortNumber(), input->GetInputState());
+			}
+			break;
+
 		case MessageType::ForceDisconnect:
 			MessageManager::DisplayMessage("NetPlay", ((ForceDisconnectMessage*)message)->GetMessage());
 			break;
@@ -120,14 +137,26 @@ void GameClientConnection::ProcessMessage(NetMessage* message)
 			}
 
 			ClearInputData();
+
+			_useRollback = gameInfo->IsRollbackEnabled();
+			_rollbackSyncId = gameInfo->GetRollbackSyncId();
+			if(_useRollback) {
+				if(!_rollbackManager) {
+					_rollbackManager.reset(new RollbackManager(_console.get(), this));
+				}
+				_rollbackManager->SetLocalPorts(_controllerPort == GameConnection::SpectatorPort ? 0 : (1 << _controllerPort));
+			}
+
+			//Stop running frames until the server's state has been received
+			_console->SetRollbackManager(nullptr);
 			_console->Unlock();
 
 			_gameLoaded = AttemptLoadGame(gameInfo->GetRomFilename(), gameInfo->GetSha1Hash());
 			if(!_gameLoaded) {
 				_console->Stop(true);
 			} else {
-				_console->GetControlManager()->UnregisterInputProvider(this);
-				_console->GetControlManager()->RegisterInputProvider(this);
+				UnregisterInputProvider();
+				RegisterInputProvider();
 				if(gameInfo->IsPaused()) {
 					_console->Pause();
 				} else {
@@ -140,6 +169,29 @@ void GameClientConnection::ProcessMessage(NetMessage* message)
 	}
 }
 
+void GameClientConnection::RegisterInputProvider()
+{
+	shared_ptr<ControlManager> controlManager = _console->GetControlManager();
+	if(controlManager) {
+		if(_useRollback) {
+			controlManager->RegisterInputProvider(_rollbackManager.get());
+		} else {
+			controlManager->RegisterInputProvider(this);
+		}
+	}
+}
+
+void GameClientConnection::UnregisterInputProvider()
+{
+	shared_ptr<ControlManager> controlManager = _console->GetControlManager();
+	if(controlManager) {
+		controlManager->UnregisterInputProvider(this);
+		if(_rollbackManager) {
+			controlManager->UnregisterInputProvider(_rollbackManager.get());
+		}
+	}
+}
+
 bool GameClientConnection::AttemptLoadGame(string filename, string sha1Hash)
 {
 	if(filename.size() > 0) {
@@ -155,11 +207,15 @@ bool GameClientConnection::AttemptLoadGame(string filename, string sha1Hash)
 
 void GameClientConnection::PushControllerState(uint8_t port, ControlDeviceState state)
 {
+	if(port >= BaseControlDevice::PortCount) {
+		return;
+	}
+
 	LockHandler lock = _writeLock.AcquireSafe();
-	_inputData[port].push_back(state);
+	_inputData.PushBack(port, PackedControlState(state));
 	_inputSize[port]++;
 
-	if(_inputData[port].size() >= _minimumQueueSize) {
+	if(_inputData.GetCount(port) >= _minimumQueueSize) {
 		_waitForInput[port].Signal();
 	}
 }
@@ -196,11 +252,11 @@ bool GameClientConnection::SetInput(BaseControlDevice *device)
 			return true;
 		}
 
-		ControlDeviceState state = _inputData[port].front();
-		_inputData[port].pop_front();
+		PackedControlState state;
+		_inputData.PopFront(port, state);
 		_inputSize[port]--;
 
-		if(_inputData[port].size() > _minimumQueueSize) {
+		if(_inputData.GetCount(port) > _minimumQueueSize) {
 			//Too much data, catch up
 			_console->GetSettings()->SetFlag(EmulationFlags::MaximumSpeed);
 		} else {
@@ -223,13 +279,13 @@ void GameClientConnection::ProcessNotification(ConsoleNotificationType type, voi
 	if(type == ConsoleNotificationType::ConfigChanged) {
 		InitControlDevice();
 	} else if(type == ConsoleNotificationType::GameLoaded) {
-		_console->GetControlManager()->RegisterInputProvider(this);
+		RegisterInputProvider();
 	}
 }
 
 void GameClientConnection::SendInput()
 {
-	if(_gameLoaded) {
+	if(_gameLoaded && !_useRollback) {
 		if(_newControlDevice) {
 			_controlDevice = _newControlDevice;
 			_newControlDevice.reset();
@@ -249,6 +305,27 @@ void GameClientConnection::SendInput()
 	}
 }
 
+void GameClientConnection::SendRollbackInput(uint32_t syncId, uint32_t frame, uint8_t port, ControlDeviceState &state)
+{
+	RollbackInputMessage message(syncId, frame, port, state);
+	SendNetMessage(message);
+}
+
+bool GameClientConnection::GetLocalInput(uint8_t port, ControlDeviceState &state)
+{
+	//Called on the emulation thread - the client thread doesn't poll the device in rollback mode
+	if(_newControlDevice) {
+		_controlDevice = _newControlDevice;
+		_newControlDevice.reset();
+	}
+
+	if(_controlDevice) {
+		_controlDevice->SetStateFromInput();
+		state = _controlDevice->GetRawState();
+	}
+	return true;
+}
+
 void GameClientConnection::SelectController(uint8_t port)
 {
 	SendControllerSelection(port);
@@ -8,14 +8,17 @@
 #include "INotificationListener.h"
 #include "IInputProvider.h"
 #include "ControlDeviceState.h"
+#include "PackedInputLog.h"
 #include "ClientConnectionData.h"
+#include "IRollbackTransport.h"
 
 class Console;
+class RollbackManager;
 
-class GameClientConnection : public GameConnection, public INotificationListener, public IInputProvider
+class GameClientConnection : public GameConnection, public INotificationListener, public IInputProvider, public IRollbackTransport
 {
 private:
-	std::deque<ControlDeviceState> _inputData[BaseControlDevice::PortCount];
+	PackedInputLog _inputData;
 	atomic<uint32_t> _inputSize[BaseControlDevice::PortCount];
 	AutoResetEvent _waitForInput[BaseControlDevice::PortCount];
 	SimpleLock _writeLock;
@@ -33,6 +36,10 @@ private:
 	ClientConnectionData _connectionData;
 	string _serverSalt;
 
+	bool _useRollback = false;
+	uint32_t _rollbackSyncId = 0;
+	shared_ptr<RollbackManager> _rollbackManager;
+
 private:
 	void SendHandshake();
 	void SendControllerSelection(uint8_t port);
@@ -40,6 +47,8 @@ private:
 	void PushControllerState(uint8_t port, ControlDeviceState state);
 	void DisableControllers();
 	bool AttemptLoadGame(string filename, string sha1Hash);
+	void RegisterInputProvider();
+	void UnregisterInputProvider();
 
 protected:
 	void ProcessMessage(NetMessage* message) override;
@@ -56,6 +65,9 @@ public:
 	void InitControlDevice();
 	void SendInput();
 
+	void SendRollbackInput(uint32_t syncId, uint32_t frame, uint8_t port, ControlDeviceState &state) override;
+	bool GetLocalInput(uint8_t port, ControlDeviceState &state) override;
+
 	void SelectController(uint8_t port);
 	uint8_t GetAvailableControllers();
 	uint8_t GetControllerPort();
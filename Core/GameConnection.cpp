@@ -10,6 +10,9 @@
 #include "ClientConnectionData.h"
 #include "ForceDisconnectMessage.h"
 #include "ServerInformationMessage.h"
+#include "RollbackInputMessage.h"
+
+thread_local vector<uint8_t> GameConnection::_receiveBuffer;
 
 GameConnection::GameConnection(shared_ptr<Console> console, shared_ptr<Socket> socket)
 {
@@ -19,29 +22,54 @@ GameConnection::GameConnection(shared_ptr<Console> console, shared_ptr<Socket> s
 
 void GameConnection::ReadSocket()
 {
+	if(_receiveBuffer.empty()) {
+		_receiveBuffer.resize(GameConnection::ReceiveBufferSize);
+	}
+
 	auto lock = _socketLock.AcquireSafe();
-	int bytesReceived = _socket->Recv((char*)_readBuffer + _readPosition, GameConnection::MaxMsgLength - _readPosition, 0);
-	if(bytesReceived > 0) {
-		_readPosition += bytesReceived;
+	int bytesReceived;
+	while((bytesReceived = _socket->Recv((char*)_receiveBuffer.data(), GameConnection::ReceiveBufferSize, 0)) > 0) {
+		_readBuffer.insert(_readBuffer.end(), _receiveBuffer.begin(), _receiveBuffer.begin() + bytesReceived);
+		if(bytesReceived < GameConnection::ReceiveBufferSize) {
+			//Socket has been drained
+			break;
+		}
+	}
+}
+
+void GameConnection::CompactReadBuffer()
+{
+	if(_readPosition > 0) {
+		_readBuffer.erase(_readBuffer.begin(), _readBuffer.begin() + _readPosition);
+		_readPosition = 0;
+	}
+
+	if(_readBuffer.size() < GameConnection::MaxIdleBufferSize && _readBuffer.capacity() > GameConnection::ReceiveBufferSize) {
+		//Release the memory used to receive a large message (e.g save state)
+		_readBuffer.shrink_to_fit();
 	}
 }
 
-bool GameConnection::ExtractMessage(void *buffer, uint32_t &messageLength)
+bool GameConnection::ExtractMessage(uint8_t* &messageData, uint32_t &messageLength)
 {
-	messageLength = _readBuffer[0] | (_readBuffer[1] << 8) | (_readBuffer[2] << 16) | (_readBuffer[3] << 24);
+	uint32_t available = (uint32_t)_readBuffer.size() - _readPosition;
+	if(available <= sizeof(messageLength)) {
+		return false;
+	}
+
+	uint8_t* data = _readBuffer.data() + _readPosition;
+	messageLength = data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
 
-	if(messageLength > GameConnection::MaxMsgLength) {
+	if(messageLength == 0 || messageLength > GameConnection::MaxMsgLength) {
 		MessageManager::Log("[Netplay] Invalid data received, closing connection.");
 		Disconnect();
 		return false;
 	}
 
-	int packetLength = messageLength + sizeof(messageLength);
-
-	if(_readPosition >= packetLength) {
-		memcpy(buffer, _readBuffer+sizeof(messageLength), messageLength);
-		memmove(_readBuffer, _readBuffer + packetLength, _readPosition - packetLength);
-		_readPosition -= packetLength;
+	uint32_t packetLength = messageLength + sizeof(messageLength);
+	if(available >= packetLength) {
+		messageData = data + sizeof(messageLength);
+		_readPosition += packetLength;
 		return true;
 	}
 	return false;
@@ -49,22 +77,21 @@ bool GameConnection::ExtractMessage(void *buffer, uint32_t &messageLength)
 
 NetMessage* GameConnection::ReadMessage()
 {
-	ReadSocket();
-
-	if(_readPosition > 4) {
-		uint32_t messageLength;
-		if(ExtractMessage(_messageBuffer, messageLength)) {
-			switch((MessageType)_messageBuffer[0]) {
-				case MessageType::HandShake: return new HandShakeMessage(_messageBuffer, messageLength);
-				case MessageType::SaveState: return new SaveStateMessage(_messageBuffer, messageLength);
-				case MessageType::InputData: return new InputDataMessage(_messageBuffer, messageLength);
-				case MessageType::MovieData: return new MovieDataMessage(_messageBuffer, messageLength);
-				case MessageType::GameInformation: return new GameInformationMessage(_messageBuffer, messageLength);
-				case MessageType::PlayerList: return new PlayerListMessage(_messageBuffer, messageLength);
-				case MessageType::SelectController: return new SelectControllerMessage(_messageBuffer, messageLength);
-				case MessageType::ForceDisconnect: return new ForceDisconnectMessage(_messageBuffer, messageLength);
-				case MessageType::ServerInformation: return new ServerInformationMessage(_messageBuffer, messageLength);
-			}
+	uint8_t* messageData;
+	uint32_t messageLength;
+	while(ExtractMessage(messageData, messageLength)) {
+		//Unknown message types are skipped
+		switch((MessageType)messageData[0]) {
+			case MessageType::HandShake: return new HandShakeMessage(messageData, messageLength);
+			case MessageType::SaveState: return new SaveStateMessage(messageData, messageLength);
+			case MessageType::InputData: return new InputDataMessage(messageData, messageLength);
+			case MessageType::MovieData: return new MovieDataMessage(messageData, messageLength);
+			case MessageType::GameInformation: return new GameInformationMessage(messageData, messageLength);
+			case MessageType::PlayerList: return new PlayerListMessage(messageData, messageLength);
+			case MessageType::SelectController: return new SelectControllerMessage(messageData, messageLength);
+			case MessageType::ForceDisconnect: return new ForceDisconnectMessage(messageData, messageLength);
+			case MessageType::ServerInformation: return new ServerInformationMessage(messageData, messageLength);
+			case MessageType::RollbackInput: return new RollbackInputMessage(messageData, messageLength);
 		}
 	}
 	return nullptr;
@@ -76,6 +103,12 @@ void GameConnection::SendNetMessage(NetMessage &message)
 	message.Send(*_socket.get());
 }
 
+void GameConnection::SendPacket(const string &packet)
+{
+	auto lock = _socketLock.AcquireSafe();
+	_socket->Send((char*)packet.c_str(), (int)packet.size(), 0);
+}
+
 void GameConnection::Disconnect()
 {
 	auto lock = _socketLock.AcquireSafe();
@@ -87,13 +120,22 @@ bool GameConnection::ConnectionError()
 	return _socket->ConnectionError();
 }
 
+Socket* GameConnection::GetSocket()
+{
+	return _socket.get();
+}
+
 void GameConnection::ProcessMessages()
 {
+	ReadSocket();
+
 	NetMessage* message;
 	while((message = ReadMessage()) != nullptr) {
 		//Loop until all messages have been processed
 		message->Initialize();
 		ProcessMessage(message);
 		delete message;
-	}		
+	}
+
+	CompactReadBuffer();
 }
\ No newline at end of file
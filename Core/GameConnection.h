@@ -17,20 +17,24 @@ class GameConnection
 {
 protected:
 	static constexpr int MaxMsgLength = 1500000;
+	static constexpr int ReceiveBufferSize = 0x10000;
+	static constexpr int MaxIdleBufferSize = 0x1000;
 
 	shared_ptr<Socket> _socket;
 	shared_ptr<Console> _console;
 
-	uint8_t _readBuffer[GameConnection::MaxMsgLength] = {};
-	uint8_t _messageBuffer[GameConnection::MaxMsgLength] = {};
-	int _readPosition = 0;
+	//Only holds data that hasn't been processed yet (usually a partial message), data is received in a buffer shared by all connections on the thread
+	thread_local static vector<uint8_t> _receiveBuffer;
+	vector<uint8_t> _readBuffer;
+	uint32_t _readPosition = 0;
 	SimpleLock _socketLock;
 
 private:
 
 	void ReadSocket();
+	void CompactReadBuffer();
 
-	bool ExtractMessage(void *buffer, uint32_t &messageLength);
+	bool ExtractMessage(uint8_t* &messageData, uint32_t &messageLength);
 	NetMessage* ReadMessage();
 
 	virtual void ProcessMessage(NetMessage* message) = 0;
@@ -43,6 +47,8 @@ public:
 	GameConnection(shared_ptr<Console> console, shared_ptr<Socket> socket);
 
 	bool ConnectionError();
+	Socket* GetSocket();
 	void ProcessMessages();
 	void SendNetMessage(NetMessage &message);
+	void SendPacket(const string &packet);
 };
\ No newline at end of file
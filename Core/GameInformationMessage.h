@@ -11,22 +11,26 @@ private:
 	string _sha1Hash;
 	uint8_t _controllerPort = 0;
 	bool _paused = false;
+	bool _useRollback = false;
+	uint32_t _rollbackSyncId = 0;
 
 protected:
 	void Serialize(Serializer &s) override
 	{
-		s.Stream(_romFilename, _sha1Hash, _controllerPort, _paused);
+		s.Stream(_romFilename, _sha1Hash, _controllerPort, _paused, _useRollback, _rollbackSyncId);
 	}
 
 public:
 	GameInformationMessage(void* buffer, uint32_t length) : NetMessage(buffer, length) { }
 
-	GameInformationMessage(string filepath, string sha1Hash, uint8_t port, bool paused) : NetMessage(MessageType::GameInformation)
+	GameInformationMessage(string filepath, string sha1Hash, uint8_t port, bool paused, bool useRollback = false, uint32_t rollbackSyncId = 0) : NetMessage(MessageType::GameInformation)
 	{
 		_romFilename = FolderUtilities::GetFilename(filepath, true);
 		_sha1Hash = sha1Hash;
 		_controllerPort = port;
 		_paused = paused;
+		_useRollback = useRollback;
+		_rollbackSyncId = rollbackSyncId;
 	}
 	
 	uint8_t GetPort()
@@ -48,4 +52,14 @@ public:
 	{
 		return _paused;
 	}
+
+	bool IsRollbackEnabled()
+	{
+		return _useRollback;
+	}
+
+	uint32_t GetRollbackSyncId()
+	{
+		return _rollbackSyncId;
+	}
 };
\ No newline at end of file
@@ -8,12 +8,16 @@ using std::thread;
 #include "ControlManager.h"
 #include "Multitap.h"
 #include "PlayerListMessage.h"
+#include "MovieDataMessage.h"
+#include "RollbackInputMessage.h"
+#include "RollbackManager.h"
 #include "NotificationManager.h"
+#include "EmuSettings.h"
 #include "../Utilities/Socket.h"
 
 shared_ptr<GameServer> GameServer::Instance;
 
-GameServer::GameServer(shared_ptr<Console> console, uint16_t listenPort, string password, string hostPlayerName)
+GameServer::GameServer(shared_ptr<Console> console, uint16_t listenPort, string password, string hostPlayerName, bool useRollback)
 {
 	_console = console;
 	_stop = false;
@@ -21,6 +25,16 @@ GameServer::GameServer(shared_ptr<Console> console, uint16_t listenPort, string
 	_password = password;
 	_hostPlayerName = hostPlayerName;
 	_hostControllerPort = 0;
+	_useRollback = useRollback;
+
+	if(_useRollback) {
+		//Every port that isn't owned by a client is predicted-free on the host
+		_rollbackManager.reset(new RollbackManager(console.get(), this));
+		_rollbackManager->SetLocalPorts((1 << BaseControlDevice::PortCount) - 1);
+		_console->Lock();
+		_console->SetRollbackManager(_rollbackManager);
+		_console->Unlock();
+	}
 
 	//If a game is already running, register ourselves as an input recorder/provider right away
 	RegisterServerInput();
@@ -37,6 +51,16 @@ GameServer::~GameServer()
 	if(controlManager) {
 		controlManager->UnregisterInputRecorder(this);
 		controlManager->UnregisterInputProvider(this);
+		if(_rollbackManager) {
+			controlManager->UnregisterInputProvider(_rollbackManager.get());
+		}
+	}
+
+	if(_rollbackManager) {
+		_console->Lock();
+		_console->SetRollbackManager(nullptr);
+		_console->Unlock();
+		_console->GetSettings()->ClearFlag(EmulationFlags::MaximumSpeed);
 	}
 }
 
@@ -44,8 +68,13 @@ void GameServer::RegisterServerInput()
 {
 	shared_ptr<ControlManager> controlManager = _console->GetControlManager();
 	if(controlManager) {
-		controlManager->RegisterInputRecorder(this);
-		controlManager->RegisterInputProvider(this);
+		if(_rollbackManager) {
+			//Inputs are exchanged frame by frame by the rollback manager, movie data isn't needed
+			controlManager->RegisterInputProvider(_rollbackManager.get());
+		} else {
+			controlManager->RegisterInputRecorder(this);
+			controlManager->RegisterInputProvider(this);
+		}
 	}
 }
 
@@ -56,6 +85,7 @@ void GameServer::AcceptConnections()
 		if(!socket->ConnectionError()) {
 			auto connection = shared_ptr<GameServerConnection>(new GameServerConnection(_console, socket, _password));
 			_console->GetNotificationManager()->RegisterNotificationListener(connection);
+			auto lock = _connectionLock.AcquireSafe();
 			_openConnections.push_back(connection);
 		} else {
 			break;
@@ -64,46 +94,63 @@ void GameServer::AcceptConnections()
 	_listener->Listen(10);
 }
 
-void GameServer::UpdateConnections()
+void GameServer::UpdateConnections(vector<shared_ptr<GameServerConnection>> &connections, vector<bool> &ready)
 {
 	vector<shared_ptr<GameServerConnection>> connectionsToRemove;
-	for(shared_ptr<GameServerConnection> connection : _openConnections) {
+	for(size_t i = 0; i < connections.size(); i++) {
+		shared_ptr<GameServerConnection> &connection = connections[i];
 		if(connection->ConnectionError()) {
 			connectionsToRemove.push_back(connection);
-		} else {
+		} else if(ready[i]) {
 			connection->ProcessMessages();
 		}
 	}
 
-	for(shared_ptr<GameServerConnection> gameConnection : connectionsToRemove) {
-		_openConnections.remove(gameConnection);
+	if(!connectionsToRemove.empty()) {
+		auto lock = _connectionLock.AcquireSafe();
+		for(shared_ptr<GameServerConnection> gameConnection : connectionsToRemove) {
+			_openConnections.remove(gameConnection);
+		}
 	}
 }
 
 list<shared_ptr<GameServerConnection>> GameServer::GetConnectionList()
 {
 	if(GameServer::Started()) {
+		auto lock = Instance->_connectionLock.AcquireSafe();
 		return Instance->_openConnections;
 	} else {
 		return list<shared_ptr<GameServerConnection>>();
 	}
 }
 
+void GameServer::SendPacket(const string &packet, GameServerConnection* excludedConnection)
+{
+	for(shared_ptr<GameServerConnection> &connection : GetConnectionList()) {
+		if(connection.get() != excludedConnection && !connection->ConnectionError() && connection->IsHandshakeCompleted()) {
+			connection->SendPacket(packet);
+		}
+	}
+}
+
 bool GameServer::SetInput(BaseControlDevice *device)
 {
 	uint8_t port = device->GetPort();
 
 	if(device->GetControllerType() == ControllerType::Multitap) {
 		//Need special handling for the multitap, merge data from P3/4/5 with P1 (or P2, depending which port the multitap is plugged into)
+		ControlDeviceState state;
 		GameServerConnection* connection = GameServerConnection::GetNetPlayDevice(port);
 		if(connection) {
-			((Multitap*)device)->SetControllerState(0, connection->GetState());
+			connection->GetState().Unpack(state);
+			((Multitap*)device)->SetControllerState(0, state);
 		}
 
 		for(int i = 2; i < 5; i++) {
 			GameServerConnection* connection = GameServerConnection::GetNetPlayDevice(i);
 			if(connection) {
-				((Multitap*)device)->SetControllerState(i - 1, connection->GetState());
+				connection->GetState().Unpack(state);
+				((Multitap*)device)->SetControllerState(i - 1, state);
 			}
 		}
 	} else {
@@ -121,14 +168,21 @@ bool GameServer::SetInput(BaseControlDevice *device)
 
 void GameServer::RecordInput(vector<shared_ptr<BaseControlDevice>> devices)
 {
+	//Serialize the frame's input once and send it to every client in a single call
+	string packet;
 	for(shared_ptr<BaseControlDevice> &device : devices) {
-		for(shared_ptr<GameServerConnection> connection : _openConnections) {
-			if(!connection->ConnectionError()) {
-				//Send movie stream
-				connection->SendMovieData(device->GetPort(), device->GetRawState());
-			}
-		}
+		MovieDataMessage message(device->GetRawState(), device->GetPort());
+		packet += message.GetPacket();
 	}
+
+	//Send movie stream
+	SendPacket(packet);
+}
+
+void GameServer::SendRollbackInput(uint32_t syncId, uint32_t frame, uint8_t port, ControlDeviceState &state)
+{
+	RollbackInputMessage message(syncId, frame, port, state);
+	SendPacket(message.GetPacket());
 }
 
 void GameServer::ProcessNotification(ConsoleNotificationType type, void * parameter)
@@ -137,6 +191,22 @@ void GameServer::ProcessNotification(ConsoleNotificationType type, void * parame
 		//Register the server as an input provider/recorder
 		RegisterServerInput();
 	}
+
+	if(_rollbackManager) {
+		switch(type) {
+			case ConsoleNotificationType::GameLoaded:
+			case ConsoleNotificationType::GameReset:
+			case ConsoleNotificationType::StateLoaded:
+			case ConsoleNotificationType::CheatsChanged:
+			case ConsoleNotificationType::ConfigChanged:
+				//Emulation state changed outside of the rollback history, start a new sync point (the connections send it to the clients)
+				_rollbackManager->Reset(_rollbackManager->GetSyncId() + 1, _rollbackManager->GetFrame());
+				break;
+
+			default:
+				break;
+		}
+	}
 }
 
 void GameServer::Exec()
@@ -148,11 +218,30 @@ void GameServer::Exec()
 	_initialized = true;
 	MessageManager::DisplayMessage("NetPlay" , "ServerStarted", std::to_string(_port));
 
+	vector<shared_ptr<GameServerConnection>> connections;
+	vector<Socket*> sockets;
+	vector<bool> ready;
 	while(!_stop) {
-		AcceptConnections();
-		UpdateConnections();
+		connections.clear();
+		sockets.clear();
+		sockets.push_back(_listener.get());
+		{
+			auto lock = _connectionLock.AcquireSafe();
+			for(shared_ptr<GameServerConnection> &connection : _openConnections) {
+				connections.push_back(connection);
+				sockets.push_back(connection->GetSocket());
+			}
+		}
+
+		//Sleep until a connection request or a message is received (the timeout only serves to check the stop flag)
+		Socket::Poll(sockets, ready, 50);
 
-		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+		if(ready[0]) {
+			AcceptConnections();
+		}
+
+		ready.erase(ready.begin());
+		UpdateConnections(connections, ready);
 	}
 }
 
@@ -163,9 +252,9 @@ void GameServer::Stop()
 	MessageManager::DisplayMessage("NetPlay", "ServerStopped");
 }
 
-void GameServer::StartServer(shared_ptr<Console> console, uint16_t port, string password, string hostPlayerName)
+void GameServer::StartServer(shared_ptr<Console> console, uint16_t port, string password, string hostPlayerName, bool useRollback)
 {
-	Instance.reset(new GameServer(console, port, password, hostPlayerName));
+	Instance.reset(new GameServer(console, port, password, hostPlayerName, useRollback));
 	console->GetNotificationManager()->RegisterNotificationListener(Instance);
 	Instance->_serverThread.reset(new thread(&GameServer::Exec, Instance.get()));
 }
@@ -177,6 +266,42 @@ void GameServer::StopServer()
 	}
 }
 
+shared_ptr<RollbackManager> GameServer::GetRollbackManager()
+{
+	if(Instance) {
+		return Instance->_rollbackManager;
+	}
+	return nullptr;
+}
+
+void GameServer::UpdateRollbackPorts()
+{
+	shared_ptr<RollbackManager> rollbackManager = GetRollbackManager();
+	if(rollbackManager) {
+		uint8_t localPorts = 0;
+		for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+			if(GameServerConnection::GetNetPlayDevice(i) == nullptr) {
+				localPorts |= (1 << i);
+			}
+		}
+		rollbackManager->SetLocalPorts(localPorts);
+	}
+}
+
+void GameServer::ProcessRollbackInput(GameServerConnection* sender, RollbackInputMessage* message)
+{
+	shared_ptr<RollbackManager> rollbackManager = GetRollbackManager();
+	if(!rollbackManager || message->GetPortNumber() != sender->GetControllerPort()) {
+		//Clients can only send input for the port they control
+		return;
+	}
+
+	rollbackManager->AddRemoteInput(message->GetSyncId(), message->GetFrame(), message->GetPortNumber(), message->GetInputState());
+
+	//Relay the input to the other clients
+	SendPacket(message->GetPacket(), sender);
+}
+
 bool GameServer::Started()
 {
 	if(Instance) {
@@ -248,11 +373,10 @@ vector<PlayerInfo> GameServer::GetPlayerList()
 
 void GameServer::SendPlayerList()
 {
-	vector<PlayerInfo> playerList = GetPlayerList();
-
+	//Send player list update to all connections
+	PlayerListMessage message(GetPlayerList());
+	string packet = message.GetPacket();
 	for(shared_ptr<GameServerConnection> &connection : GetConnectionList()) {
-		//Send player list update to all connections
-		PlayerListMessage message(playerList);
-		connection->SendNetMessage(message);
+		connection->SendPacket(packet);
 	}
 }
\ No newline at end of file
@@ -5,11 +5,15 @@
 #include "INotificationListener.h"
 #include "IInputProvider.h"
 #include "IInputRecorder.h"
+#include "IRollbackTransport.h"
+#include "../Utilities/SimpleLock.h"
 
 using std::thread;
 class Console;
+class RollbackManager;
+class RollbackInputMessage;
 
-class GameServer : public IInputRecorder, public IInputProvider, public INotificationListener
+class GameServer : public IInputRecorder, public IInputProvider, public INotificationListener, public IRollbackTransport
 {
 private:
 	static shared_ptr<GameServer> Instance;
@@ -20,24 +24,29 @@ private:
 	uint16_t _port;
 	string _password;
 	list<shared_ptr<GameServerConnection>> _openConnections;
+	SimpleLock _connectionLock;
 	bool _initialized = false;
 
 	string _hostPlayerName;
 	uint8_t _hostControllerPort;
 
+	bool _useRollback = false;
+	shared_ptr<RollbackManager> _rollbackManager;
+
 	void AcceptConnections();
-	void UpdateConnections();
+	void UpdateConnections(vector<shared_ptr<GameServerConnection>> &connections, vector<bool> &ready);
+	static void SendPacket(const string &packet, GameServerConnection* excludedConnection = nullptr);
 
 	void Exec();
 	void Stop();
 
 public:
-	GameServer(shared_ptr<Console> console, uint16_t port, string password, string hostPlayerName);
+	GameServer(shared_ptr<Console> console, uint16_t port, string password, string hostPlayerName, bool useRollback);
 	virtual ~GameServer();
 
 	void RegisterServerInput();
 
-	static void StartServer(shared_ptr<Console> console, uint16_t port, string password, string hostPlayerName);
+	static void StartServer(shared_ptr<Console> console, uint16_t port, string password, string hostPlayerName, bool useRollback = false);
 	static void StopServer();
 	static bool Started();
 
@@ -50,9 +59,15 @@ public:
 
 	static list<shared_ptr<GameServerConnection>> GetConnectionList();
 
+	static shared_ptr<RollbackManager> GetRollbackManager();
+	static void UpdateRollbackPorts();
+	static void ProcessRollbackInput(GameServerConnection* sender, RollbackInputMessage* message);
+
 	bool SetInput(BaseControlDevice *device) override;
 	void RecordInput(vector<shared_ptr<BaseControlDevice>> devices) override;
 
+	void SendRollbackInput(uint32_t syncId, uint32_t frame, uint8_t port, ControlDeviceState &state) override;
+
 	// Inherited via INotificationListener
 	virtual void ProcessNotification(ConsoleNotificationType type, void * parameter) override;
 };
\ No newline at end of file
@@ -4,7 +4,6 @@
 #include "GameServerConnection.h"
 #include "HandShakeMessage.h"
 #include "InputDataMessage.h"
-#include "MovieDataMessage.h"
 #include "GameInformationMessage.h"
 #include "SaveStateMessage.h"
 #include "Console.h"
@@ -18,6 +17,8 @@
 #include "ForceDisconnectMessage.h"
 #include "BaseControlDevice.h"
 #include "ServerInformationMessage.h"
+#include "RollbackInputMessage.h"
+#include "RollbackManager.h"
 
 GameServerConnection* GameServerConnection::_netPlayDevices[BaseControlDevice::PortCount] = { };
 
@@ -59,19 +60,31 @@ void GameServerConnection::SendGameInformation()
 {
 	_console->Lock();
 	RomInfo romInfo = _console->GetRomInfo();
-	GameInformationMessage gameInfo(romInfo.RomFile.GetFileName(), _console->GetCartridge()->GetSha1Hash(), _controllerPort, _console->IsPaused());
-	SendNetMessage(gameInfo);
-	SaveStateMessage saveState(_console);
-	SendNetMessage(saveState);
-	_console->Unlock();
-}
-
-void GameServerConnection::SendMovieData(uint8_t port, ControlDeviceState state)
-{
-	if(_handshakeCompleted) {
-		MovieDataMessage message(state, port);
-		SendNetMessage(message);
+	shared_ptr<RollbackManager> rollbackManager = GameServer::GetRollbackManager();
+	if(rollbackManager) {
+		GameInformationMessage gameInfo(romInfo.RomFile.GetFileName(), _console->GetCartridge()->GetSha1Hash(), _controllerPort, _console->IsPaused(), true, rollbackManager->GetSyncId());
+		SendNetMessage(gameInfo);
+
+		//Send the last frame for which all inputs are known, followed by every input confirmed since then
+		vector<uint8_t> stateData;
+		vector<RollbackInput> inputs;
+		uint32_t frame;
+		rollbackManager->GetSyncState(stateData, frame, inputs);
+
+		SaveStateMessage saveState(_console, stateData, frame);
+		SendNetMessage(saveState);
+
+		for(RollbackInput &input : inputs) {
+			RollbackInputMessage message(rollbackManager->GetSyncId(), input.Frame, input.Port, input.State);
+			SendNetMessage(message);
+		}
+	} else {
+		GameInformationMessage gameInfo(romInfo.RomFile.GetFileName(), _console->GetCartridge()->GetSha1Hash(), _controllerPort, _console->IsPaused());
+		SendNetMessage(gameInfo);
+		SaveStateMessage saveState(_console);
+		SendNetMessage(saveState);
 	}
+	_console->Unlock();
 }
 
 void GameServerConnection::SendForceDisconnectMessage(string disconnectMessage)
@@ -81,26 +94,17 @@ void GameServerConnection::SendForceDisconnectMessage(string disconnectMessage)
 	Disconnect();
 }
 
-void GameServerConnection::PushState(ControlDeviceState state)
+void GameServerConnection::PushState(const ControlDeviceState &state)
 {
-	if(_inputData.size() == 0 || state != _inputData.back()) {
-		_inputData.clear();
-		_inputData.push_back(state);
-	}
+	//Only the latest state is kept, it will be used until a new one is received
+	auto lock = _inputLock.AcquireSafe();
+	_inputState = PackedControlState(state);
 }
 
-ControlDeviceState GameServerConnection::GetState()
+PackedControlState GameServerConnection::GetState()
 {
-	size_t inputBufferSize = _inputData.size();
-	ControlDeviceState stateData;
-	if(inputBufferSize > 0) {
-		stateData = _inputData.front();
-		if(inputBufferSize > 1) {
-			//Always keep the last one the client sent, it will be used until a new one is received
-			_inputData.pop_front();
-		}
-	}
-	return stateData;
+	auto lock = _inputLock.AcquireSafe();
+	return _inputState;
 }
 
 void GameServerConnection::ProcessHandshakeResponse(HandShakeMessage* message)
@@ -157,6 +161,14 @@ void GameServerConnection::ProcessMessage(NetMessage* message)
 			SelectControllerPort(((SelectControllerMessage*)message)->GetPortNumber());
 			break;
 
+		case MessageType::RollbackInput:
+			if(!_handshakeCompleted) {
+				SendForceDisconnectMessage("Handshake has not been completed - invalid packet");
+				return;
+			}
+			GameServer::ProcessRollbackInput(this, (RollbackInputMessage*)message);
+			break;
+
 		default:
 			break;
 	}
@@ -215,6 +227,7 @@ void GameServerConnection::ProcessNotification(ConsoleNotificationType type, voi
 void GameServerConnection::RegisterNetPlayDevice(GameServerConnection* device, uint8_t port)
 {
 	GameServerConnection::_netPlayDevices[port] = device;
+	GameServer::UpdateRollbackPorts();
 }
 
 void GameServerConnection::UnregisterNetPlayDevice(GameServerConnection* device)
@@ -226,6 +239,7 @@ void GameServerConnection::UnregisterNetPlayDevice(GameServerConnection* device)
 				break;
 			}
 		}
+		GameServer::UpdateRollbackPorts();
 	}
 }
 
@@ -253,4 +267,9 @@ string GameServerConnection::GetPlayerName()
 uint8_t GameServerConnection::GetControllerPort()
 {
 	return _controllerPort;
+}
+
+bool GameServerConnection::IsHandshakeCompleted()
+{
+	return _handshakeCompleted;
 }
\ No newline at end of file
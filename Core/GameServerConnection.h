@@ -13,14 +13,15 @@ class GameServerConnection : public GameConnection, public INotificationListener
 private:
 	static GameServerConnection* _netPlayDevices[BaseControlDevice::PortCount];
 
-	list<ControlDeviceState> _inputData;
+	PackedControlState _inputState;
+	SimpleLock _inputLock;
 	string _playerName;
 	int _controllerPort;	
 	string _connectionHash;
 	string _serverPassword;
 	bool _handshakeCompleted = false;
 
-	void PushState(ControlDeviceState state);
+	void PushState(const ControlDeviceState &state);
 	void SendServerInformation();
 	void SendGameInformation();
 	void SelectControllerPort(uint8_t port);
@@ -40,11 +41,11 @@ public:
 	GameServerConnection(shared_ptr<Console> console, shared_ptr<Socket> socket, string serverPassword);
 	virtual ~GameServerConnection();
 
-	ControlDeviceState GetState();
-	void SendMovieData(uint8_t port, ControlDeviceState state);
+	PackedControlState GetState();
 
 	string GetPlayerName();
 	uint8_t GetControllerPort();
+	bool IsHandshakeCompleted();
 
 	virtual void ProcessNotification(ConsoleNotificationType type, void* parameter) override;
 
@@ -0,0 +1,60 @@
+#pragma once
+#include "stdafx.h"
+#include "IRenderingDevice.h"
+#include "VideoRenderer.h"
+#include "Console.h"
+#include "../Utilities/SimpleLock.h"
+
+//Rendering device that keeps the last frame in memory without displaying it (benchmarks, automated tests)
+class HeadlessRenderer : public IRenderingDevice
+{
+private:
+	shared_ptr<Console> _console;
+	SimpleLock _frameLock;
+	shared_ptr<FrameBuffer> _lastFrame;
+	atomic<uint32_t> _frameCount;
+
+public:
+	HeadlessRenderer(shared_ptr<Console> console)
+	{
+		_console = console;
+		_frameCount = 0;
+		_console->GetVideoRenderer()->RegisterRenderingDevice(this);
+	}
+
+	~HeadlessRenderer()
+	{
+		_console->GetVideoRenderer()->UnregisterRenderingDevice(this);
+	}
+
+	virtual void UpdateFrame(shared_ptr<FrameBuffer> frame) override
+	{
+		//Only one reference is kept, the frame's buffer goes back to the decoder's pool when the next frame arrives
+		auto lock = _frameLock.AcquireSafe();
+		_lastFrame = frame;
+		_frameCount++;
+	}
+
+	shared_ptr<FrameBuffer> GetLastFrame()
+	{
+		auto lock = _frameLock.AcquireSafe();
+		return _lastFrame;
+	}
+
+	uint32_t GetFrameCount()
+	{
+		return _frameCount;
+	}
+
+	virtual void Render() override
+	{
+	}
+
+	virtual void Reset() override
+	{
+	}
+
+	virtual void SetFullscreenMode(bool fullscreen, void* windowHandle, uint32_t monitorWidth, uint32_t monitorHeight) override
+	{
+	}
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include "stdafx.h"
+#include "IAudioDevice.h"
+#include "SoundMixer.h"
+#include "Console.h"
+
+//Audio device that discards the mixed audio (benchmarks, automated tests)
+class HeadlessSoundManager : public IAudioDevice
+{
+private:
+	shared_ptr<Console> _console;
+	uint64_t _sampleCount = 0;
+
+public:
+	HeadlessSoundManager(shared_ptr<Console> console)
+	{
+		_console = console;
+		_console->GetSoundMixer()->RegisterAudioDevice(this);
+	}
+
+	~HeadlessSoundManager()
+	{
+		_console->GetSoundMixer()->RegisterAudioDevice(nullptr);
+	}
+
+	virtual void PlayBuffer(int16_t *soundBuffer, uint32_t sampleCount, uint32_t sampleRate, bool isStereo) override
+	{
+		_sampleCount += sampleCount;
+	}
+
+	uint64_t GetSampleCount()
+	{
+		return _sampleCount;
+	}
+
+	virtual void Stop() override
+	{
+	}
+
+	virtual void Pause() override
+	{
+	}
+
+	virtual string GetAvailableDevices() override
+	{
+		return string();
+	}
+
+	virtual void SetAudioDevice(string deviceName) override
+	{
+	}
+
+	virtual void ProcessEndOfFrame() override
+	{
+	}
+
+	virtual AudioStatistics GetStatistics() override
+	{
+		return AudioStatistics();
+	}
+};
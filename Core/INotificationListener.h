@@ -19,7 +19,8 @@ enum class ConsoleNotificationType
 	EventViewerRefresh = 14,
 	MissingFirmware = 15,
 	BeforeGameUnload = 16,
-	CheatsChanged = 17
+	CheatsChanged = 17,
+	StateSaved = 18
 };
 
 class INotificationListener
@@ -0,0 +1,13 @@
+#pragma once
+#include "stdafx.h"
+#include "ControlDeviceState.h"
+
+class IRollbackTransport
+{
+public:
+	//Called on the emulation thread whenever an input produced by this instance (local player, or a port nobody else controls) is confirmed
+	virtual void SendRollbackInput(uint32_t syncId, uint32_t frame, uint8_t port, ControlDeviceState &state) = 0;
+
+	//Allows the transport to supply the local player's input (e.g to use player 1's key bindings on clients)
+	virtual bool GetLocalInput(uint8_t port, ControlDeviceState &state) { return false; }
+};
@@ -37,6 +37,9 @@ public:
 
 	__forceinline void ProcessIrqCounters();
 
+	//True when calling ProcessIrqCounters() repeatedly has the same effect as calling it once (no H/V IRQ enabled or pending)
+	bool IsIrqCounterIdle() { return _needIrq == 0 && !_state.EnableHorizontalIrq && !_state.EnableVerticalIrq; }
+
 	uint8_t GetIoPortOutput();
 	void SetNmiFlag(bool nmiFlag);
 
@@ -8,6 +8,7 @@
 #include "RegisterHandlerA.h"
 #include "RegisterHandlerB.h"
 #include "RamHandler.h"
+#include "RomHandler.h"
 #include "MessageManager.h"
 #include "DebugTypes.h"
 #include "EmuSettings.h"
@@ -353,6 +354,96 @@ void MemoryManager::WriteDma(uint32_t addr, uint8_t value, bool forBusA)
 	}
 }
 
+uint32_t MemoryManager::GetDmaBlockLimit()
+{
+	//Number of DMA bytes (8 master clocks each) that can be transferred before the next scanline event
+	return _nextEventClock > _hClock ? (_nextEventClock - _hClock - 1) / 8 : 0;
+}
+
+bool MemoryManager::RunDmaBlock(uint32_t srcAddr, int8_t step, uint16_t destAddr[4], uint8_t destIndex, uint32_t length)
+{
+	//Runs "length" bytes of a bus A -> bus B DMA transfer at once and then advances the clock in a single step
+	//This is only done when nothing can observe the state of the system between the individual bytes:
+	//no debugger, no coprocessor to sync, no IRQ counter, no scanline/HDMA event and no PPU rendering during the block
+	if(length == 0 || length > GetDmaBlockLimit() || _console->GetDebugger(false) || _cart->IsCoprocessorSyncNeeded() || !_regs->IsIrqCounterIdle()) {
+		return false;
+	}
+
+	//Source must be plain ROM/RAM (other handlers can have side effects on read, e.g S-DD1 decompression) within a single 4kb page
+	IMemoryHandler* handler = _mappings.GetHandler(srcAddr);
+	if(!handler || (typeid(*handler) != typeid(RamHandler) && typeid(*handler) != typeid(RomHandler))) {
+		return false;
+	}
+
+	for(int i = 0; i < 4; i++) {
+		switch(destAddr[i]) {
+			case 0x2104: case 0x2118: case 0x2119: case 0x2122:
+				if(!_ppu->CanAccessVideoMemory()) {
+					return false;
+				}
+				break;
+
+			case 0x2180:
+				if(handler->GetMemoryType() == SnesMemoryType::WorkRam) {
+					//WRAM->$2180 does not cause a write to occur
+					return false;
+				}
+				break;
+
+			default:
+				return false;
+		}
+	}
+
+	uint8_t value = _openBus;
+	for(uint32_t i = 0; i < length; i++) {
+		uint32_t addr = (srcAddr & 0xFF0000) | ((srcAddr + i * step) & 0xFFFF);
+		value = handler->Read(addr);
+		_cheatManager->ApplyCheat(addr, value);
+		_registerHandlerB->Write(destAddr[(destIndex + i) & 0x03], value);
+	}
+	_openBus = value;
+	_memTypeBusA = handler->GetMemoryType();
+
+	_masterClock += length * 8;
+	_hClock += length * 8;
+	_regs->ProcessIrqCounters();
+	_cpu->DetectNmiSignalEdge();
+	return true;
+}
+
+uint32_t MemoryManager::SkipIdleCycles(uint32_t readAddr[2], uint8_t readSize, uint32_t period)
+{
+	//Advances the clock by a whole number of iterations of a polling loop (or of WAI's idle cycles) without running them
+	//The CPU checks that the loop itself doesn't change anything between iterations, this checks that nothing else can either:
+	//same restrictions as RunDmaBlock, no pending DMA/HDMA and the values read by the loop must stay the same
+	if(period == 0 || period > _hClock || _nextEventClock <= _hClock || _console->GetDebugger(false) || _cart->IsCoprocessorSyncNeeded() || !_regs->IsIrqCounterIdle() || _console->GetDmaController()->HasPendingTransfers()) {
+		return 0;
+	}
+
+	//Highest value _hClock can reach (the last skipped iteration must end before the next scanline event)
+	uint16_t limit = _nextEventClock - 1;
+	for(int i = 0; i < readSize; i++) {
+		IMemoryHandler* handler = _mappings.GetHandler(readAddr[i]);
+		if(readSize == 1 && handler == _registerHandlerA.get() && (readAddr[i] & 0xFFFF) == 0x4212) {
+			//Only the hblank flag can change before the next event: the last iteration and the skipped ones must all be on the same side of its transitions
+			uint16_t start = _hClock - period;
+			limit = std::min<uint16_t>(limit, start < 1 * 4 ? 1 * 4 - 1 : (start <= 274 * 4 ? 274 * 4 : 0xFFFF));
+		} else if(!handler || (typeid(*handler) != typeid(RamHandler) && typeid(*handler) != typeid(RomHandler))) {
+			return 0;
+		}
+	}
+
+	uint32_t count = limit > _hClock ? (limit - _hClock) / period : 0;
+	if(count) {
+		_masterClock += count * period;
+		_hClock += count * period;
+		_regs->ProcessIrqCounters();
+		_cpu->DetectNmiSignalEdge();
+	}
+	return count;
+}
+
 void MemoryManager::Poke(uint32_t addr, uint8_t value)
 {
 	_mappings.DebugWrite(addr, value);
@@ -84,6 +84,9 @@ public:
 
 	void Write(uint32_t addr, uint8_t value, MemoryOperationType type);
 	void WriteDma(uint32_t addr, uint8_t value, bool forBusA);
+	uint32_t GetDmaBlockLimit();
+	bool RunDmaBlock(uint32_t srcAddr, int8_t step, uint16_t destAddr[4], uint8_t destIndex, uint32_t length);
+	uint32_t SkipIdleCycles(uint32_t readAddr[2], uint8_t readSize, uint32_t period);
 	
 	void Poke(uint32_t addr, uint8_t value);
 
@@ -50,14 +50,9 @@ bool MesenMovie::SetInput(BaseControlDevice *device)
 	uint32_t inputRowIndex = _console->GetControlManager()->GetPollCounter();
 	_lastPollCounter = inputRowIndex;
 
-	if(_inputData.size() > inputRowIndex && _inputData[inputRowIndex].size() > _deviceIndex) {
-		device->SetTextState(_inputData[inputRowIndex][_deviceIndex]);
-
-		_deviceIndex++;
-		if(_deviceIndex >= _inputData[inputRowIndex].size()) {
-			//Move to the next frame's data
-			_deviceIndex = 0;
-		}
+	PackedControlState state;
+	if(_inputLog.GetEntry(device->GetPort(), inputRowIndex, state)) {
+		device->SetRawState(state);
 	} else {
 		_console->GetMovieManager()->Stop();
 	}
@@ -94,25 +89,11 @@ bool MesenMovie::Play(VirtualFile &file)
 	_reader.reset(new ZipReader());
 	_reader->LoadArchive(ss);
 
-	stringstream settingsData, inputData;
+	stringstream settingsData;
 	if(!_reader->GetStream("GameSettings.txt", settingsData)) {
 		MessageManager::Log("[Movie] File not found: GameSettings.txt");
 		return false;
 	}
-	if(!_reader->GetStream("Input.txt", inputData)) {
-		MessageManager::Log("[Movie] File not found: Input.txt");
-		return false;
-	}
-
-	while(inputData) {
-		string line;
-		std::getline(inputData, line);
-		if(line.substr(0, 1) == "|") {
-			_inputData.push_back(StringUtilities::Split(line.substr(1), '|'));
-		}
-	}
-
-	_deviceIndex = 0;
 
 	ParseSettings(settingsData);
 	
@@ -145,6 +126,11 @@ bool MesenMovie::Play(VirtualFile &file)
 	_originalCheats = _console->GetCheatManager()->GetCheats();
 
 	controlManager->UpdateControlDevices();
+	if(!LoadInput()) {
+		_console->Unlock();
+		return false;
+	}
+
 	if(!_forTest) {
 		_console->PowerCycle();
 	} else {
@@ -170,6 +156,43 @@ bool MesenMovie::Play(VirtualFile &file)
 	return true;
 }
 
+bool MesenMovie::LoadInput()
+{
+	_inputLog.Clear();
+
+	stringstream inputData;
+	if(_reader->GetStream("Input.bin", inputData)) {
+		vector<uint8_t> ports;
+		if(_inputLog.Load(inputData, ports)) {
+			return true;
+		}
+		MessageManager::Log("[Movie] Invalid Input.bin file, using Input.txt instead");
+		_inputLog.Clear();
+		inputData = stringstream();
+	}
+
+	if(!_reader->GetStream("Input.txt", inputData)) {
+		MessageManager::Log("[Movie] File not found: Input.txt");
+		return false;
+	}
+
+	//Convert the text input to the packed format once, using devices that match the movie's controller setup
+	vector<shared_ptr<BaseControlDevice>> devices = _console->GetControlManager()->CreateDetachedDevices();
+	PackedControlState state;
+	string line;
+	while(std::getline(inputData, line)) {
+		if(line.substr(0, 1) == "|") {
+			vector<string> row = StringUtilities::Split(line.substr(1), '|');
+			for(size_t i = 0; i < row.size() && i < devices.size(); i++) {
+				devices[i]->SetTextState(row[i]);
+				devices[i]->GetRawState(state);
+				_inputLog.PushBack(devices[i]->GetPort(), state);
+			}
+		}
+	}
+	return true;
+}
+
 template<typename T>
 T FromString(string name, const vector<string> &enumNames, T defaultValue)
 {
@@ -5,6 +5,7 @@
 #include "../Utilities/VirtualFile.h"
 #include "BatteryManager.h"
 #include "INotificationListener.h"
+#include "PackedInputLog.h"
 
 class ZipReader;
 class Console;
@@ -18,9 +19,8 @@ private:
 	VirtualFile _movieFile;
 	shared_ptr<ZipReader> _reader;
 	bool _playing = false;
-	size_t _deviceIndex = 0;
 	uint32_t _lastPollCounter = 0;
-	vector<vector<string>> _inputData;
+	PackedInputLog _inputLog;
 	vector<string> _cheats;
 	vector<CheatCode> _originalCheats;
 	std::unordered_map<string, string> _settings;
@@ -29,6 +29,7 @@ private:
 
 private:
 	void ParseSettings(stringstream &data);
+	bool LoadInput();
 	void ApplySettings();
 	bool LoadGame();
 	void Stop();
@@ -34,7 +34,8 @@ bool MovieRecorder::Record(RecordMovieOptions options)
 	_author = options.Author;
 	_description = options.Description;
 	_writer.reset(new ZipWriter());
-	_inputData = stringstream();
+	_inputLog.Clear();
+	_inputDevices.clear();
 	_saveStateData = stringstream();
 	_hasSaveState = false;
 
@@ -141,7 +142,18 @@ bool MovieRecorder::Stop()
 	if(_writer) {
 		_console->GetControlManager()->UnregisterInputRecorder(this);
 
-		_writer->AddFile(_inputData, "Input.txt");
+		stringstream inputText;
+		WriteInputText(inputText);
+		_writer->AddFile(inputText, "Input.txt");
+
+		//Binary copy of the input, loaded instead of Input.txt when present
+		stringstream inputTrack;
+		vector<uint8_t> ports;
+		for(shared_ptr<BaseControlDevice> &device : _inputDevices) {
+			ports.push_back(device->GetPort());
+		}
+		_inputLog.Save(inputTrack, ports);
+		_writer->AddFile(inputTrack, "Input.bin");
 
 		stringstream out;
 		GetGameSettings(out);
@@ -180,10 +192,33 @@ bool MovieRecorder::Stop()
 
 void MovieRecorder::RecordInput(vector<shared_ptr<BaseControlDevice>> devices)
 {
+	if(_inputDevices.empty()) {
+		//Input is kept in binary form while recording and converted to text with these devices when the movie is saved
+		_inputDevices = _console->GetControlManager()->CreateDetachedDevices();
+	}
+
+	PackedControlState state;
 	for(shared_ptr<BaseControlDevice> &device : devices) {
-		_inputData << ("|" + device->GetTextState());
+		device->GetRawState(state);
+		_inputLog.PushBack(device->GetPort(), state);
+	}
+}
+
+void MovieRecorder::WriteInputText(stringstream &out)
+{
+	PackedControlState state;
+	uint32_t rowCount = _inputLog.GetMaxCount();
+	for(uint32_t i = 0; i < rowCount; i++) {
+		for(shared_ptr<BaseControlDevice> &device : _inputDevices) {
+			if(_inputLog.GetEntry(device->GetPort(), i, state)) {
+				device->SetRawState(state);
+			} else {
+				device->ClearState();
+			}
+			out << "|" << device->GetTextState();
+		}
+		out << "\n";
 	}
-	_inputData << "\n";
 }
 
 void MovieRecorder::OnLoadBattery(string extension, vector<uint8_t> batteryData)
@@ -208,8 +243,6 @@ bool MovieRecorder::CreateMovie(string movieFile, std::deque<RewindData> &data,
 	_filename = movieFile;
 	_writer.reset(new ZipWriter());
 	if(startPosition < data.size() && endPosition <= data.size() && _writer->Initialize(_filename)) {
-		vector<shared_ptr<BaseControlDevice>> devices = _console->GetControlManager()->GetControlDevices();
-		
 		if(startPosition > 0 || _console->GetRomInfo().HasBattery || _console->GetSettings()->GetRamPowerOnState() == RamPowerOnState::Random) {
 			//Create a movie from a savestate if we don't start from the beginning (or if the game has save ram, or if the power on ram state is random)
 			_hasSaveState = true;
@@ -218,19 +251,19 @@ bool MovieRecorder::CreateMovie(string movieFile, std::deque<RewindData> &data,
 			data[startPosition].GetStateData(_saveStateData);
 		}
 
-		_inputData = stringstream();
+		_inputLog.Clear();
+		_inputDevices = _console->GetControlManager()->CreateDetachedDevices();
 
+		PackedControlState state;
 		for(uint32_t i = startPosition; i < endPosition; i++) {
 			RewindData rewindData = data[i];
 			for(uint32_t i = 0; i < 30; i++) {
-				for(shared_ptr<BaseControlDevice> &device : devices) {
+				for(shared_ptr<BaseControlDevice> &device : _inputDevices) {
 					uint8_t port = device->GetPort();
-					if(i < rewindData.InputLogs[port].size()) {
-						device->SetRawState(rewindData.InputLogs[port][i]);
-						_inputData << ("|" + device->GetTextState());
+					if(rewindData.InputLogs.GetEntry(port, i, state)) {
+						_inputLog.PushBack(port, state);
 					}
 				}
-				_inputData << "\n";
 			}
 		}
 
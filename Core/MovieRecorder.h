@@ -6,6 +6,7 @@
 #include "BatteryManager.h"
 #include "INotificationListener.h"
 #include "MovieTypes.h"
+#include "PackedInputLog.h"
 
 class ZipWriter;
 class Console;
@@ -23,7 +24,8 @@ private:
 	string _description;
 	unique_ptr<ZipWriter> _writer;
 	std::unordered_map<string, vector<uint8_t>> _batteryData;
-	stringstream _inputData;
+	PackedInputLog _inputLog;
+	vector<shared_ptr<BaseControlDevice>> _inputDevices;
 	bool _hasSaveState = false;
 	stringstream _saveStateData;
 
@@ -32,6 +34,7 @@ private:
 	void WriteString(stringstream &out, string name, string value);
 	void WriteInt(stringstream &out, string name, uint32_t value);
 	void WriteBool(stringstream &out, string name, bool enabled);
+	void WriteInputText(stringstream &out);
 
 public:
 	MovieRecorder(shared_ptr<Console> console);
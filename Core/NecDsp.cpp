@@ -67,6 +67,8 @@ NecDsp::NecDsp(CoprocessorType type, Console* console, vector<uint8_t> &programR
 
 	_stackMask = _stackSize - 1;
 
+	_clock.SetRatio(_frequency, console->GetMasterClockRate());
+
 	console->GetSettings()->InitializeRam(_ram, _ramSize * sizeof(uint16_t));
 	console->GetSettings()->InitializeRam(_stack, _stackSize * sizeof(uint16_t));
 
@@ -112,6 +114,7 @@ NecDsp* NecDsp::InitCoprocessor(CoprocessorType type, Console *console, vector<u
 void NecDsp::Reset()
 {
 	_cycleCount = 0;
+	_clock.Reset();
 	_state = {};
 }
 
@@ -145,7 +148,7 @@ void NecDsp::ReadOpCode()
 
 void NecDsp::Run()
 {
-	uint64_t targetCycle = (uint64_t)(_memoryManager->GetMasterClock() * (_frequency / _console->GetMasterClockRate()));
+	uint64_t targetCycle = _clock.GetCycle(_memoryManager->GetMasterClock());
 
 	if(_inRqmLoop && !_console->IsDebugging()) {
 		_cycleCount = targetCycle;
@@ -584,5 +587,6 @@ void NecDsp::Serialize(Serializer &s)
 	s.Stream(_opCode, _cycleCount, _inRqmLoop);
 	s.StreamArray<uint16_t>(_ram, _ramSize);
 	s.StreamArray<uint16_t>(_stack, _stackSize);
+	_clock.Serialize(s);
 }
 
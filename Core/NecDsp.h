@@ -2,6 +2,7 @@
 #include "stdafx.h"
 #include "NecDspTypes.h"
 #include "BaseCoprocessor.h"
+#include "ClockDomain.h"
 
 class Console;
 class MemoryManager;
@@ -17,7 +18,8 @@ private:
 	unique_ptr<RamHandler> _ramHandler;
 	CoprocessorType _type;
 
-	double _frequency = 7600000;
+	uint32_t _frequency = 7600000;
+	ClockDomain _clock;
 	uint32_t _opCode = 0;
 	uint8_t *_progRom = nullptr;
 	uint32_t *_prgCache = nullptr;
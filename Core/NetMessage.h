@@ -38,7 +38,9 @@ public:
 		return _type;
 	}
 
-	void Send(Socket &socket)
+	//Returns the message as it is sent on the wire (length + type + data)
+	//Messages sent to several connections only need to be serialized once, and can be concatenated to send them in a single call
+	string GetPacket()
 	{
 		Serializer s(SaveStateManager::FileFormatVersion);
 		Serialize(s);
@@ -48,7 +50,12 @@ public:
 
 		string data = out.str();
 		uint32_t messageLength = (uint32_t)data.size() + 1;
-		data = string((char*)&messageLength, 4) + (char)_type + data;
+		return string((char*)&messageLength, 4) + (char)_type + data;
+	}
+
+	void Send(Socket &socket)
+	{
+		string data = GetPacket();
 		socket.Send((char*)data.c_str(), (int)data.size(), 0);
 	}
 
@@ -3,6 +3,7 @@
 #include "EmuSettings.h"
 #include "SettingTypes.h"
 #include "Console.h"
+#include "PixelKernels.h"
 
 NtscFilter::NtscFilter(shared_ptr<Console> console) : BaseVideoFilter(console)
 {
@@ -55,34 +56,34 @@ void NtscFilter::ApplyFilter(uint16_t *ppuOutputBuffer)
 	bool useHighResOutput = _baseFrameInfo.Width == 512;
 	uint32_t baseWidth = SNES_NTSC_OUT_WIDTH(256);
 	uint32_t xOffset = overscan.Left * 2;
-	uint32_t yOffset = overscan.Top * 2 * baseWidth;
+	int burstPhase = IsOddFrame() ? 0 : 1;
 
-	if(useHighResOutput) {
-		snes_ntsc_blit_hires(&_ntscData, ppuOutputBuffer, 512, IsOddFrame() ? 0 : 1, 512, _baseFrameInfo.Height, _ntscBuffer, SNES_NTSC_OUT_WIDTH(256) * 4);
-	} else {
-		snes_ntsc_blit(&_ntscData, ppuOutputBuffer, 256, IsOddFrame() ? 0 : 1, 256, _baseFrameInfo.Height, _ntscBuffer, SNES_NTSC_OUT_WIDTH(256) * 8);
-	}
 	VideoConfig cfg = _console->GetSettings()->GetVideoConfig();
+	uint8_t intensity = (uint8_t)((1.0 - cfg.ScanlineIntensity) * 255);
+	uint32_t* out = GetOutputBuffer();
 
-	if(cfg.ScanlineIntensity == 0) {
-		for(uint32_t i = 0; i < frameInfo.Height; i+=2) {
-			memcpy(GetOutputBuffer()+i*frameInfo.Width, _ntscBuffer + yOffset + xOffset + i*baseWidth, frameInfo.Width * sizeof(uint32_t));
-			memcpy(GetOutputBuffer()+(i+1)*frameInfo.Width, _ntscBuffer + yOffset + xOffset + i*baseWidth, frameInfo.Width * sizeof(uint32_t));
-		}
-	} else {
-		uint8_t intensity = (uint8_t)((1.0 - cfg.ScanlineIntensity) * 255);
-		for(uint32_t i = 0; i < frameInfo.Height; i++) {
-			if(i & 0x01) {
-				uint32_t *in = _ntscBuffer + yOffset + xOffset + (i - 1) * baseWidth;
-				uint32_t *out = GetOutputBuffer() + i * frameInfo.Width;
-				for(uint32_t j = 0; j < frameInfo.Width; j++) {
-					out[j] = ApplyScanlineEffect(in[j], intensity);
-				}
+	//Each pair of output rows comes from a single NTSC row (low res rows are doubled, only the even rows of high res frames are displayed)
+	//Rows only depend on their own input and burst phase, so they can be processed in parallel bands
+	ProcessRows(frameInfo.Height / 2, 1, [&](uint32_t firstRow, uint32_t lastRow) {
+		for(uint32_t i = firstRow; i < lastRow; i++) {
+			uint32_t y = useHighResOutput ? (overscan.Top + i) * 2 : (overscan.Top + i);
+			int rowPhase = (burstPhase + y) % snes_ntsc_burst_count;
+			uint32_t* ntscRow = _ntscBuffer + i * baseWidth;
+			if(useHighResOutput) {
+				snes_ntsc_blit_hires(&_ntscData, ppuOutputBuffer + y * 512, 512, rowPhase, 512, 1, ntscRow, baseWidth * 4);
+			} else {
+				snes_ntsc_blit(&_ntscData, ppuOutputBuffer + y * 256, 256, rowPhase, 256, 1, ntscRow, baseWidth * 4);
+			}
+
+			uint32_t* rowOut = out + i * 2 * frameInfo.Width;
+			memcpy(rowOut, ntscRow + xOffset, frameInfo.Width * sizeof(uint32_t));
+			if(cfg.ScanlineIntensity > 0) {
+				PixelKernels::ApplyScanlines(ntscRow + xOffset, rowOut + frameInfo.Width, frameInfo.Width, intensity);
 			} else {
-				memcpy(GetOutputBuffer()+i*frameInfo.Width, _ntscBuffer + yOffset + xOffset + i*baseWidth, frameInfo.Width * sizeof(uint32_t));
+				memcpy(rowOut + frameInfo.Width, ntscRow + xOffset, frameInfo.Width * sizeof(uint32_t));
 			}
 		}
-	}
+	});
 }
 
 NtscFilter::~NtscFilter()
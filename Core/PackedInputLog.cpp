@@ -0,0 +1,149 @@
+#include "stdafx.h"
+#include "PackedInputLog.h"
+
+uint8_t* PackedInputLog::GetEntry(Column &column, uint32_t index)
+{
+	return column.Data.data() + ((column.Start + index) % column.Capacity) * (column.Width + 1);
+}
+
+void PackedInputLog::Resize(Column &column, uint32_t width, uint32_t capacity)
+{
+	//Rewrites the existing entries at the start of a new buffer (needed when the capacity or the entry width changes)
+	vector<uint8_t> data(capacity * (width + 1), 0);
+	for(uint32_t i = 0; i < column.Count; i++) {
+		uint8_t* entry = GetEntry(column, i);
+		memcpy(data.data() + i * (width + 1), entry, entry[0] + 1);
+	}
+
+	column.Data.swap(data);
+	column.Width = width;
+	column.Capacity = capacity;
+	column.Start = 0;
+}
+
+void PackedInputLog::PushBack(uint8_t port, const PackedControlState &state)
+{
+	Column &column = _columns[port];
+	if(state.Size > column.Width || column.Count == column.Capacity) {
+		Resize(column, std::max<uint32_t>(column.Width, state.Size), column.Count == column.Capacity ? std::max<uint32_t>(column.Capacity * 2, 16) : column.Capacity);
+	}
+
+	uint8_t* entry = GetEntry(column, column.Count);
+	entry[0] = state.Size;
+	memcpy(entry + 1, state.Data, state.Size);
+	column.Count++;
+}
+
+bool PackedInputLog::PopFront(uint8_t port, PackedControlState &state)
+{
+	Column &column = _columns[port];
+	if(column.Count == 0) {
+		return false;
+	}
+
+	uint8_t* entry = GetEntry(column, 0);
+	state.Pack(entry + 1, entry[0]);
+	column.Start = (column.Start + 1) % column.Capacity;
+	column.Count--;
+	return true;
+}
+
+void PackedInputLog::PopBack(uint8_t port)
+{
+	if(_columns[port].Count > 0) {
+		_columns[port].Count--;
+	}
+}
+
+bool PackedInputLog::GetEntry(uint8_t port, uint32_t index, PackedControlState &state)
+{
+	Column &column = _columns[port];
+	if(index >= column.Count) {
+		return false;
+	}
+
+	uint8_t* entry = GetEntry(column, index);
+	state.Pack(entry + 1, entry[0]);
+	return true;
+}
+
+uint32_t PackedInputLog::GetCount(uint8_t port)
+{
+	return _columns[port].Count;
+}
+
+uint32_t PackedInputLog::GetMaxCount()
+{
+	uint32_t count = 0;
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		count = std::max(count, _columns[i].Count);
+	}
+	return count;
+}
+
+void PackedInputLog::CopyPort(uint8_t port, PackedInputLog &source)
+{
+	_columns[port] = source._columns[port];
+}
+
+void PackedInputLog::Clear()
+{
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		_columns[i].Start = 0;
+		_columns[i].Count = 0;
+	}
+}
+
+void PackedInputLog::Save(ostream &out, vector<uint8_t> &ports)
+{
+	uint32_t rowCount = GetMaxCount();
+	uint8_t portCount = (uint8_t)ports.size();
+
+	out.write("MSIN", 4);
+	out.write((char*)&portCount, sizeof(portCount));
+	out.write((char*)ports.data(), portCount);
+	out.write((char*)&rowCount, sizeof(rowCount));
+
+	PackedControlState state;
+	for(uint32_t i = 0; i < rowCount; i++) {
+		for(uint8_t port : ports) {
+			if(!GetEntry(port, i, state)) {
+				state.Size = 0;
+			}
+			out.write((char*)&state.Size, sizeof(state.Size));
+			out.write((char*)state.Data, state.Size);
+		}
+	}
+}
+
+bool PackedInputLog::Load(istream &in, vector<uint8_t> &ports)
+{
+	Clear();
+
+	char header[4] = {};
+	uint8_t portCount = 0;
+	in.read(header, 4);
+	in.read((char*)&portCount, sizeof(portCount));
+	if(memcmp(header, "MSIN", 4) != 0 || portCount > BaseControlDevice::PortCount) {
+		return false;
+	}
+
+	ports.resize(portCount);
+	in.read((char*)ports.data(), portCount);
+
+	uint32_t rowCount = 0;
+	in.read((char*)&rowCount, sizeof(rowCount));
+
+	PackedControlState state;
+	for(uint32_t i = 0; i < rowCount && in.good(); i++) {
+		for(uint8_t port : ports) {
+			in.read((char*)&state.Size, sizeof(state.Size));
+			if(port >= BaseControlDevice::PortCount || state.Size > PackedControlState::MaxSize) {
+				return false;
+			}
+			in.read((char*)state.Data, state.Size);
+			PushBack(port, state);
+		}
+	}
+	return in.good();
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "stdafx.h"
+#include "ControlDeviceState.h"
+#include "BaseControlDevice.h"
+
+//Per-port input history stored as one ring buffer ("column") per port
+//Each entry is stored as a size byte followed by a fixed number of bytes (the largest state seen on that port), so
+//recording/replaying input does not allocate anything once the buffers have reached their working size
+class PackedInputLog
+{
+private:
+	struct Column
+	{
+		vector<uint8_t> Data;
+		uint32_t Width = 0;
+		uint32_t Capacity = 0;
+		uint32_t Start = 0;
+		uint32_t Count = 0;
+	};
+
+	Column _columns[BaseControlDevice::PortCount];
+
+	uint8_t* GetEntry(Column &column, uint32_t index);
+	void Resize(Column &column, uint32_t width, uint32_t capacity);
+
+public:
+	void PushBack(uint8_t port, const PackedControlState &state);
+	bool PopFront(uint8_t port, PackedControlState &state);
+	void PopBack(uint8_t port);
+	bool GetEntry(uint8_t port, uint32_t index, PackedControlState &state);
+
+	uint32_t GetCount(uint8_t port);
+	uint32_t GetMaxCount();
+
+	void CopyPort(uint8_t port, PackedInputLog &source);
+	void Clear();
+
+	//Binary movie track: one row per frame, each row contains one state per port (in the order given by "ports")
+	void Save(ostream &out, vector<uint8_t> &ports);
+	bool Load(istream &in, vector<uint8_t> &ports);
+};
@@ -0,0 +1,260 @@
+#include "stdafx.h"
+#include "PixelKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define PIXELKERNELS_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+	#define PIXELKERNELS_NEON
+	#include <arm_neon.h>
+#endif
+
+static __forceinline uint32_t ToArgb(uint16_t rgb555)
+{
+	uint32_t r = rgb555 & 0x1F;
+	uint32_t g = (rgb555 >> 5) & 0x1F;
+	uint32_t b = (rgb555 >> 10) & 0x1F;
+	r = (r << 3) | (r >> 2);
+	g = (g << 3) | (g >> 2);
+	b = (b << 3) | (b >> 2);
+	return 0xFF000000 | (r << 16) | (g << 8) | b;
+}
+
+static __forceinline uint32_t GetMode7Lookup(int32_t xOffset, int32_t yOffset, uint32_t outsideMask)
+{
+	uint32_t lookup = ((yOffset & 0x3F8) << 4) | ((xOffset & 0x3FF) >> 3) | ((((yOffset & 0x07) << 3) | (xOffset & 0x07)) << 16);
+	if((xOffset | yOffset) & ~0x3FF) {
+		lookup |= outsideMask;
+	}
+	return lookup;
+}
+
+static __forceinline uint32_t ApplyScanline(uint32_t argb, uint8_t intensity)
+{
+	uint8_t r = ((argb & 0xFF0000) >> 16) * intensity / 255;
+	uint8_t g = ((argb & 0xFF00) >> 8) * intensity / 255;
+	uint8_t b = (argb & 0xFF) * intensity / 255;
+	return 0xFF000000 | (r << 16) | (g << 8) | b;
+}
+
+#if defined(PIXELKERNELS_SSE2)
+static __forceinline __m128i ConvertRgb555x4(__m128i rgb555)
+{
+	__m128i mask = _mm_set1_epi32(0x1F);
+	__m128i r = _mm_and_si128(rgb555, mask);
+	__m128i g = _mm_and_si128(_mm_srli_epi32(rgb555, 5), mask);
+	__m128i b = _mm_and_si128(_mm_srli_epi32(rgb555, 10), mask);
+	r = _mm_or_si128(_mm_slli_epi32(r, 3), _mm_srli_epi32(r, 2));
+	g = _mm_or_si128(_mm_slli_epi32(g, 3), _mm_srli_epi32(g, 2));
+	b = _mm_or_si128(_mm_slli_epi32(b, 3), _mm_srli_epi32(b, 2));
+	__m128i argb = _mm_or_si128(_mm_slli_epi32(r, 16), _mm_slli_epi32(g, 8));
+	return _mm_or_si128(_mm_or_si128(argb, b), _mm_set1_epi32((int)0xFF000000));
+}
+
+static __forceinline __m128i ScaleChannels(__m128i channels, __m128i intensity)
+{
+	//x * intensity / 255 for 16-bit values, exact for all 8-bit inputs
+	__m128i value = _mm_mullo_epi16(channels, intensity);
+	value = _mm_add_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), _mm_set1_epi16(1));
+	return _mm_srli_epi16(value, 8);
+}
+
+static __forceinline __m128i BlendPixelsx4(__m128i a, __m128i b)
+{
+	__m128i mask = _mm_set1_epi32((int)0xFFFEFEFE);
+	return _mm_add_epi32(_mm_srli_epi32(_mm_and_si128(_mm_xor_si128(a, b), mask), 1), _mm_and_si128(a, b));
+}
+
+static __forceinline __m128i EvenPixels(__m128i a, __m128i b)
+{
+	return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+static __forceinline __m128i OddPixels(__m128i a, __m128i b)
+{
+	return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(3, 1, 3, 1)));
+}
+#elif defined(PIXELKERNELS_NEON)
+static __forceinline uint32x4_t ConvertRgb555x4(uint32x4_t rgb555)
+{
+	uint32x4_t mask = vdupq_n_u32(0x1F);
+	uint32x4_t r = vandq_u32(rgb555, mask);
+	uint32x4_t g = vandq_u32(vshrq_n_u32(rgb555, 5), mask);
+	uint32x4_t b = vandq_u32(vshrq_n_u32(rgb555, 10), mask);
+	r = vorrq_u32(vshlq_n_u32(r, 3), vshrq_n_u32(r, 2));
+	g = vorrq_u32(vshlq_n_u32(g, 3), vshrq_n_u32(g, 2));
+	b = vorrq_u32(vshlq_n_u32(b, 3), vshrq_n_u32(b, 2));
+	uint32x4_t argb = vorrq_u32(vshlq_n_u32(r, 16), vshlq_n_u32(g, 8));
+	return vorrq_u32(vorrq_u32(argb, b), vdupq_n_u32(0xFF000000));
+}
+
+static __forceinline uint8x8_t ScaleChannels(uint8x8_t channels, uint8x8_t intensity)
+{
+	//x * intensity / 255, exact for all 8-bit inputs
+	uint16x8_t value = vmull_u8(channels, intensity);
+	value = vaddq_u16(vaddq_u16(value, vshrq_n_u16(value, 8)), vdupq_n_u16(1));
+	return vshrn_n_u16(value, 8);
+}
+
+static __forceinline uint32x4_t BlendPixelsx4(uint32x4_t a, uint32x4_t b)
+{
+	uint32x4_t mask = vdupq_n_u32(0xFFFEFEFE);
+	return vaddq_u32(vshrq_n_u32(vandq_u32(veorq_u32(a, b), mask), 1), vandq_u32(a, b));
+}
+#endif
+
+void PixelKernels::ConvertRgb555(uint16_t* src, uint32_t* dst, uint32_t pixelCount)
+{
+	uint32_t i = 0;
+#if defined(PIXELKERNELS_SSE2)
+	__m128i zero = _mm_setzero_si128();
+	for(; i + 8 <= pixelCount; i += 8) {
+		__m128i rgb555 = _mm_loadu_si128((__m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + i), ConvertRgb555x4(_mm_unpacklo_epi16(rgb555, zero)));
+		_mm_storeu_si128((__m128i*)(dst + i + 4), ConvertRgb555x4(_mm_unpackhi_epi16(rgb555, zero)));
+	}
+#elif defined(PIXELKERNELS_NEON)
+	for(; i + 8 <= pixelCount; i += 8) {
+		uint16x8_t rgb555 = vld1q_u16(src + i);
+		vst1q_u32(dst + i, ConvertRgb555x4(vmovl_u16(vget_low_u16(rgb555))));
+		vst1q_u32(dst + i + 4, ConvertRgb555x4(vmovl_u16(vget_high_u16(rgb555))));
+	}
+#endif
+
+	for(; i < pixelCount; i++) {
+		dst[i] = ToArgb(src[i]);
+	}
+}
+
+void PixelKernels::ApplyScanlines(uint32_t* pixels, uint32_t pixelCount, uint8_t intensity)
+{
+	ApplyScanlines(pixels, pixels, pixelCount, intensity);
+}
+
+void PixelKernels::ApplyScanlines(uint32_t* src, uint32_t* dst, uint32_t pixelCount, uint8_t intensity)
+{
+	uint32_t i = 0;
+#if defined(PIXELKERNELS_SSE2)
+	__m128i zero = _mm_setzero_si128();
+	__m128i multiplier = _mm_set1_epi16(intensity);
+	__m128i alpha = _mm_set1_epi32((int)0xFF000000);
+	for(; i + 4 <= pixelCount; i += 4) {
+		__m128i argb = _mm_loadu_si128((__m128i*)(src + i));
+		__m128i low = ScaleChannels(_mm_unpacklo_epi8(argb, zero), multiplier);
+		__m128i high = ScaleChannels(_mm_unpackhi_epi8(argb, zero), multiplier);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(_mm_packus_epi16(low, high), alpha));
+	}
+#elif defined(PIXELKERNELS_NEON)
+	uint8x8_t multiplier = vdup_n_u8(intensity);
+	uint32x4_t alpha = vdupq_n_u32(0xFF000000);
+	for(; i + 4 <= pixelCount; i += 4) {
+		uint8x16_t argb = vreinterpretq_u8_u32(vld1q_u32(src + i));
+		uint8x16_t result = vcombine_u8(ScaleChannels(vget_low_u8(argb), multiplier), ScaleChannels(vget_high_u8(argb), multiplier));
+		vst1q_u32(dst + i, vorrq_u32(vreinterpretq_u32_u8(result), alpha));
+	}
+#endif
+
+	for(; i < pixelCount; i++) {
+		dst[i] = ApplyScanline(src[i], intensity);
+	}
+}
+
+void PixelKernels::GetMode7Lookups(int32_t xValue, int32_t yValue, int32_t xStep, int32_t yStep, bool largeMap, uint32_t pixelCount, uint32_t* lookups)
+{
+	//The small map wraps around, so only the large map can have pixels outside of it
+	uint32_t outsideMask = largeMap ? 0x80000000 : 0;
+
+	uint32_t i = 0;
+#if defined(PIXELKERNELS_SSE2)
+	__m128i x = _mm_setr_epi32(xValue, xValue + xStep, xValue + xStep * 2, xValue + xStep * 3);
+	__m128i y = _mm_setr_epi32(yValue, yValue + yStep, yValue + yStep * 2, yValue + yStep * 3);
+	__m128i xInc = _mm_set1_epi32(xStep * 4);
+	__m128i yInc = _mm_set1_epi32(yStep * 4);
+	__m128i outside = _mm_set1_epi32((int)outsideMask);
+	__m128i coordMask = _mm_set1_epi32(0x3FF);
+	__m128i rowMask = _mm_set1_epi32(0x3F8);
+	__m128i fineMask = _mm_set1_epi32(0x07);
+	for(; i + 4 <= pixelCount; i += 4) {
+		__m128i xOffset = _mm_srai_epi32(x, 8);
+		__m128i yOffset = _mm_srai_epi32(y, 8);
+		__m128i tileAddr = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(yOffset, rowMask), 4), _mm_srli_epi32(_mm_and_si128(xOffset, coordMask), 3));
+		__m128i pixelOffset = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(yOffset, fineMask), 3), _mm_and_si128(xOffset, fineMask));
+		__m128i inside = _mm_cmpeq_epi32(_mm_andnot_si128(coordMask, _mm_or_si128(xOffset, yOffset)), _mm_setzero_si128());
+		__m128i lookup = _mm_or_si128(tileAddr, _mm_slli_epi32(pixelOffset, 16));
+		_mm_storeu_si128((__m128i*)(lookups + i), _mm_or_si128(lookup, _mm_andnot_si128(inside, outside)));
+		x = _mm_add_epi32(x, xInc);
+		y = _mm_add_epi32(y, yInc);
+	}
+	xValue += xStep * (int32_t)i;
+	yValue += yStep * (int32_t)i;
+#elif defined(PIXELKERNELS_NEON)
+	const int32_t laneSteps[4] = { 0, 1, 2, 3 };
+	int32x4_t lanes = vld1q_s32(laneSteps);
+	int32x4_t x = vmlaq_n_s32(vdupq_n_s32(xValue), lanes, xStep);
+	int32x4_t y = vmlaq_n_s32(vdupq_n_s32(yValue), lanes, yStep);
+	int32x4_t xInc = vdupq_n_s32(xStep * 4);
+	int32x4_t yInc = vdupq_n_s32(yStep * 4);
+	uint32x4_t outside = vdupq_n_u32(outsideMask);
+	uint32x4_t coordMask = vdupq_n_u32(0x3FF);
+	uint32x4_t rowMask = vdupq_n_u32(0x3F8);
+	uint32x4_t fineMask = vdupq_n_u32(0x07);
+	for(; i + 4 <= pixelCount; i += 4) {
+		uint32x4_t xOffset = vreinterpretq_u32_s32(vshrq_n_s32(x, 8));
+		uint32x4_t yOffset = vreinterpretq_u32_s32(vshrq_n_s32(y, 8));
+		uint32x4_t tileAddr = vorrq_u32(vshlq_n_u32(vandq_u32(yOffset, rowMask), 4), vshrq_n_u32(vandq_u32(xOffset, coordMask), 3));
+		uint32x4_t pixelOffset = vorrq_u32(vshlq_n_u32(vandq_u32(yOffset, fineMask), 3), vandq_u32(xOffset, fineMask));
+		uint32x4_t inside = vceqq_u32(vbicq_u32(vorrq_u32(xOffset, yOffset), coordMask), vdupq_n_u32(0));
+		uint32x4_t lookup = vorrq_u32(tileAddr, vshlq_n_u32(pixelOffset, 16));
+		vst1q_u32(lookups + i, vorrq_u32(lookup, vbicq_u32(outside, inside)));
+		x = vaddq_s32(x, xInc);
+		y = vaddq_s32(y, yInc);
+	}
+	xValue += xStep * (int32_t)i;
+	yValue += yStep * (int32_t)i;
+#endif
+
+	for(; i < pixelCount; i++) {
+		lookups[i] = GetMode7Lookup(xValue >> 8, yValue >> 8, outsideMask);
+		xValue += xStep;
+		yValue += yStep;
+	}
+}
+
+void PixelKernels::BlendHighResBlocks(uint32_t* row1, uint32_t* row2, uint32_t width)
+{
+	uint32_t x = 0;
+#if defined(PIXELKERNELS_SSE2)
+	for(; x + 8 <= width; x += 8) {
+		__m128i a1 = _mm_loadu_si128((__m128i*)(row1 + x));
+		__m128i a2 = _mm_loadu_si128((__m128i*)(row1 + x + 4));
+		__m128i b1 = _mm_loadu_si128((__m128i*)(row2 + x));
+		__m128i b2 = _mm_loadu_si128((__m128i*)(row2 + x + 4));
+
+		//Same blend order as the scalar version: ((top left + top right) + bottom left) + bottom right
+		__m128i result = BlendPixelsx4(BlendPixelsx4(BlendPixelsx4(EvenPixels(a1, a2), OddPixels(a1, a2)), EvenPixels(b1, b2)), OddPixels(b1, b2));
+		__m128i low = _mm_unpacklo_epi32(result, result);
+		__m128i high = _mm_unpackhi_epi32(result, result);
+		_mm_storeu_si128((__m128i*)(row1 + x), low);
+		_mm_storeu_si128((__m128i*)(row1 + x + 4), high);
+		_mm_storeu_si128((__m128i*)(row2 + x), low);
+		_mm_storeu_si128((__m128i*)(row2 + x + 4), high);
+	}
+#elif defined(PIXELKERNELS_NEON)
+	for(; x + 8 <= width; x += 8) {
+		//vld2 splits the pixels into even/odd columns
+		uint32x4x2_t top = vld2q_u32(row1 + x);
+		uint32x4x2_t bottom = vld2q_u32(row2 + x);
+		uint32x4_t result = BlendPixelsx4(BlendPixelsx4(BlendPixelsx4(top.val[0], top.val[1]), bottom.val[0]), bottom.val[1]);
+		uint32x4x2_t output;
+		output.val[0] = result;
+		output.val[1] = result;
+		vst2q_u32(row1 + x, output);
+		vst2q_u32(row2 + x, output);
+	}
+#endif
+
+	for(; x + 1 < width; x += 2) {
+		uint32_t result = BlendPixels(BlendPixels(BlendPixels(row1[x], row1[x + 1]), row2[x]), row2[x + 1]);
+		row1[x] = row1[x + 1] = row2[x] = row2[x + 1] = result;
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "stdafx.h"
+
+//Row-level pixel operations used by the video filters and the PPU (SSE2/NEON with a scalar fallback)
+class PixelKernels
+{
+public:
+	//15-bit BGR (PPU output) to 32-bit ARGB, without any color adjustments
+	static void ConvertRgb555(uint16_t* src, uint32_t* dst, uint32_t pixelCount);
+
+	//Multiplies each color channel by intensity/255 (same result as BaseVideoFilter::ApplyScanlineEffect)
+	static void ApplyScanlines(uint32_t* pixels, uint32_t pixelCount, uint8_t intensity);
+	static void ApplyScanlines(uint32_t* src, uint32_t* dst, uint32_t pixelCount, uint8_t intensity);
+
+	//Replaces every 2x2 block (2 pixels on both rows) by the blend of its 4 pixels - width must be even
+	static void BlendHighResBlocks(uint32_t* row1, uint32_t* row2, uint32_t width);
+
+	//Calculates the VRAM lookups for a row of mode 7 pixels, starting at (xValue, yValue) in 16.8 fixed point:
+	//bits 0-13: tilemap word address, bits 16-21: pixel offset in the tile, bit 31: pixel is outside the map (large map only)
+	static void GetMode7Lookups(int32_t xValue, int32_t yValue, int32_t xStep, int32_t yStep, bool largeMap, uint32_t pixelCount, uint32_t* lookups);
+
+	__forceinline static uint32_t BlendPixels(uint32_t a, uint32_t b)
+	{
+		return (((a ^ b) & 0xFFFEFEFE) >> 1) + (a & b);
+	}
+};
\ No newline at end of file
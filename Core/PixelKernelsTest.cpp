@@ -0,0 +1,347 @@
+#include "stdafx.h"
+#include "PixelKernelsTest.h"
+#include "PixelKernels.h"
+#include "Ppu.h"
+#include "PpuTypes.h"
+#include "MessageManager.h"
+
+int32_t PixelKernelsTest::Run()
+{
+	_random.seed(0x4D375337);
+	_failCount = 0;
+
+	TestMode7Lookups();
+	TestMode7Rendering();
+
+	return _failCount;
+}
+
+int32_t PixelKernelsTest::GetRandom(int32_t min, int32_t max)
+{
+	return std::uniform_int_distribution<int32_t>(min, max)(_random);
+}
+
+void PixelKernelsTest::ReportFailure(string testName, uint32_t testIndex)
+{
+	if(_failCount < 10) {
+		MessageManager::Log("[Test] " + testName + " failed (case " + std::to_string(testIndex) + ")");
+	}
+	_failCount++;
+}
+
+void PixelKernelsTest::TestMode7Lookups()
+{
+	uint32_t lookups[256];
+	uint32_t expected[256];
+
+	for(uint32_t i = 0; i < 100000; i++) {
+		//Same ranges as the PPU: 13-bit scroll/center values multiplied by the 16-bit matrix
+		int32_t xValue = GetRandom(-0x8000000, 0x8000000);
+		int32_t yValue = GetRandom(-0x8000000, 0x8000000);
+		int32_t xStep = GetRandom(-0x8000, 0x7FFF);
+		int32_t yStep = GetRandom(-0x8000, 0x7FFF);
+		bool largeMap = (i & 0x01) != 0;
+
+		//Mostly counts that aren't multiples of 4, to cover the scalar loop after the SIMD one
+		uint32_t pixelCount = (i & 0x06) ? GetRandom(1, 256) : GetRandom(1, 64) * 4;
+		if(i & 0x08) {
+			//Coordinates close to the edges of the map, where the large map's outside flag changes
+			xValue = GetRandom(-0x400, 0x400) << 8;
+			yValue = GetRandom(-0x400, 0x400) << 8;
+			xStep = GetRandom(-0x200, 0x200);
+			yStep = GetRandom(-0x200, 0x200);
+		}
+
+		PixelKernels::GetMode7Lookups(xValue, yValue, xStep, yStep, largeMap, pixelCount, lookups);
+		for(uint32_t j = 0; j < pixelCount; j++) {
+			//A single pixel never reaches the SIMD loop, so this uses the scalar version
+			PixelKernels::GetMode7Lookups(xValue + xStep * (int32_t)j, yValue + yStep * (int32_t)j, xStep, yStep, largeMap, 1, expected + j);
+		}
+
+		if(memcmp(lookups, expected, pixelCount * sizeof(uint32_t)) != 0) {
+			ReportFailure("GetMode7Lookups", i);
+		}
+	}
+}
+
+void PixelKernelsTest::TestMode7Rendering()
+{
+	unique_ptr<Ppu> ppu(new Ppu(nullptr));
+	unique_ptr<Ppu> reference(new Ppu(nullptr));
+
+	for(uint32_t i = 0; i < 50000; i++) {
+		if((i & 0xFF) == 0) {
+			//Random tilemap and pixel data (the pixel data is in the high bytes), with some transparent pixels
+			for(uint32_t j = 0; j < Ppu::VideoRamSize >> 1; j++) {
+				uint32_t value = (uint32_t)_random();
+				ppu->_vram[j] = (value & 0x30000) ? (uint16_t)value : (uint8_t)value;
+			}
+			for(uint32_t j = 0; j < Ppu::CgRamSize >> 1; j++) {
+				ppu->_cgram[j] = (uint16_t)_random() & 0x7FFF;
+			}
+			memcpy(reference->_vram, ppu->_vram, Ppu::VideoRamSize);
+			memcpy(reference->_cgram, ppu->_cgram, Ppu::CgRamSize);
+		}
+
+		uint32_t seed = (uint32_t)_random();
+		InitMode7Scanline(ppu.get(), seed);
+		InitMode7Scanline(reference.get(), seed);
+
+		ppu->RenderMode7();
+		RenderMode7Scanline(reference.get());
+
+		bool match = (
+			memcmp(ppu->_mainScreenBuffer, reference->_mainScreenBuffer, sizeof(ppu->_mainScreenBuffer)) == 0 &&
+			memcmp(ppu->_mainScreenFlags, reference->_mainScreenFlags, sizeof(ppu->_mainScreenFlags)) == 0 &&
+			memcmp(ppu->_subScreenBuffer, reference->_subScreenBuffer, sizeof(ppu->_subScreenBuffer)) == 0 &&
+			memcmp(ppu->_subScreenPriority, reference->_subScreenPriority, sizeof(ppu->_subScreenPriority)) == 0 &&
+			memcmp(ppu->_mosaicColor, reference->_mosaicColor, sizeof(ppu->_mosaicColor)) == 0 &&
+			memcmp(ppu->_mosaicPriority, reference->_mosaicPriority, sizeof(ppu->_mosaicPriority)) == 0 &&
+			ppu->_state.Mode7.HScrollLatch == reference->_state.Mode7.HScrollLatch &&
+			ppu->_state.Mode7.VScrollLatch == reference->_state.Mode7.VScrollLatch
+		);
+
+		if(!match) {
+			ReportFailure("RenderTilemapMode7", i);
+		}
+	}
+}
+
+void PixelKernelsTest::InitMode7Scanline(Ppu* ppu, uint32_t seed)
+{
+	std::mt19937 random(seed);
+	auto getRandom = [&random](int32_t min, int32_t max) { return std::uniform_int_distribution<int32_t>(min, max)(random); };
+
+	PpuState &state = ppu->_state;
+	state = {};
+	state.BgMode = 7;
+
+	Mode7Config &mode7 = state.Mode7;
+	for(int i = 0; i < 4; i++) {
+		//Mix of regular scaling/rotation values and random ones
+		mode7.Matrix[i] = getRandom(0, 1) ? getRandom(-0x8000, 0x7FFF) : getRandom(-0x200, 0x200);
+	}
+	mode7.HScroll = getRandom(-0x1000, 0xFFF);
+	mode7.VScroll = getRandom(-0x1000, 0xFFF);
+	mode7.CenterX = getRandom(-0x1000, 0xFFF);
+	mode7.CenterY = getRandom(-0x1000, 0xFFF);
+	mode7.HScrollLatch = getRandom(-0x1000, 0xFFF);
+	mode7.VScrollLatch = getRandom(-0x1000, 0xFFF);
+	mode7.LargeMap = getRandom(0, 1) != 0;
+	mode7.FillWithTile0 = getRandom(0, 1) != 0;
+	mode7.HorizontalMirroring = getRandom(0, 1) != 0;
+	mode7.VerticalMirroring = getRandom(0, 1) != 0;
+
+	state.ExtBgEnabled = getRandom(0, 1) != 0;
+	state.DirectColorMode = getRandom(0, 3) == 0;
+	state.MosaicEnabled = getRandom(0, 1) ? getRandom(0, 3) : 0;
+	state.MosaicSize = getRandom(1, 16);
+	state.MainScreenLayers = getRandom(0, 0x1F);
+	state.SubScreenLayers = getRandom(0, 0x1F);
+	state.ColorMathEnabled = getRandom(0, 0x3F);
+
+	for(int i = 0; i < 2; i++) {
+		state.Window[i].Left = getRandom(0, 255);
+		state.Window[i].Right = getRandom(0, 255);
+		for(int j = 0; j < 6; j++) {
+			state.Window[i].ActiveLayers[j] = getRandom(0, 1) != 0;
+			state.Window[i].InvertedLayers[j] = getRandom(0, 1) != 0;
+		}
+	}
+	for(int i = 0; i < 6; i++) {
+		state.MaskLogic[i] = (WindowMaskLogic)getRandom(0, 3);
+	}
+	for(int i = 0; i < 5; i++) {
+		state.WindowMaskMain[i] = getRandom(0, 1) != 0;
+		state.WindowMaskSub[i] = getRandom(0, 1) != 0;
+	}
+	ppu->UpdateWindowMasks();
+
+	ppu->_configVisibleLayers = getRandom(0, 3) ? 0xFF : getRandom(0, 0xFF);
+	ppu->_scanline = getRandom(1, 239);
+	ppu->_mosaicScanlineCounter = getRandom(1, state.MosaicSize);
+
+	//Either the whole scanline, or a segment of it (e.g when a register is written mid-scanline)
+	if(getRandom(0, 1)) {
+		ppu->_drawStartX = 0;
+		ppu->_drawEndX = 255;
+	} else {
+		ppu->_drawStartX = getRandom(0, 255);
+		ppu->_drawEndX = getRandom(ppu->_drawStartX, 255);
+	}
+
+	for(int i = 0; i < 256; i++) {
+		ppu->_mainScreenBuffer[i] = getRandom(0, 0x7FFF);
+		ppu->_mainScreenFlags[i] = getRandom(0, 7) | (getRandom(0, 1) ? PixelFlags::AllowColorMath : 0);
+		ppu->_subScreenBuffer[i] = getRandom(0, 0x7FFF);
+		ppu->_subScreenPriority[i] = getRandom(0, 7);
+	}
+
+	//Mosaic values left by a previous segment of the scanline
+	for(int i = 0; i < 4; i++) {
+		ppu->_mosaicColor[i] = getRandom(0, 255);
+		ppu->_mosaicPriority[i] = getRandom(0, 7);
+	}
+
+	//No sprites on this scanline
+	memset(ppu->_spritePriority, 0xFF, sizeof(ppu->_spritePriority));
+}
+
+void PixelKernelsTest::RenderMode7Scanline(Ppu* ppu)
+{
+	RenderMode7Layer(ppu, 0, 3, 3);
+	if(ppu->_state.ExtBgEnabled) {
+		RenderMode7Layer(ppu, 1, 1, 5);
+	}
+}
+
+static bool IsMasked(PpuState &state, uint8_t layerIndex, bool maskEnabled, int x)
+{
+	WindowConfig &window1 = state.Window[0];
+	WindowConfig &window2 = state.Window[1];
+	if(!maskEnabled) {
+		return false;
+	} else if(window1.ActiveLayers[layerIndex] && window2.ActiveLayers[layerIndex]) {
+		bool mask1 = window1.PixelNeedsMasking(layerIndex, x);
+		bool mask2 = window2.PixelNeedsMasking(layerIndex, x);
+		switch(state.MaskLogic[layerIndex]) {
+			default:
+			case WindowMaskLogic::Or: return mask1 | mask2;
+			case WindowMaskLogic::And: return mask1 & mask2;
+			case WindowMaskLogic::Xor: return mask1 ^ mask2;
+			case WindowMaskLogic::Xnor: return !(mask1 ^ mask2);
+		}
+	} else if(window1.ActiveLayers[layerIndex]) {
+		return window1.PixelNeedsMasking(layerIndex, x);
+	} else if(window2.ActiveLayers[layerIndex]) {
+		return window2.PixelNeedsMasking(layerIndex, x);
+	}
+	return false;
+}
+
+void PixelKernelsTest::RenderMode7Layer(Ppu* ppu, uint8_t layerIndex, uint8_t normalPriority, uint8_t highPriority)
+{
+	//Reference version of Ppu::RenderTilemapMode7, calculating the coordinates of each pixel one at a time
+	PpuState &state = ppu->_state;
+	bool drawMain = (bool)(((state.MainScreenLayers & ppu->_configVisibleLayers) >> layerIndex) & 0x01);
+	bool drawSub = (bool)(((state.SubScreenLayers & ppu->_configVisibleLayers) >> layerIndex) & 0x01);
+	if(!drawMain && !drawSub) {
+		return;
+	}
+
+	bool applyMosaic = ((state.MosaicEnabled >> layerIndex) & 0x01) != 0;
+	uint16_t drawStartX = ppu->_drawStartX;
+	uint16_t drawEndX = ppu->_drawEndX;
+
+	auto clip = [](int32_t val) { return (val & 0x2000) ? (val | ~0x3ff) : (val & 0x3ff); };
+
+	if(drawStartX == 0) {
+		state.Mode7.HScrollLatch = state.Mode7.HScroll;
+		state.Mode7.VScrollLatch = state.Mode7.VScroll;
+	}
+
+	int32_t hScroll = ((int32_t)state.Mode7.HScrollLatch << 19) >> 19;
+	int32_t vScroll = ((int32_t)state.Mode7.VScrollLatch << 19) >> 19;
+	int32_t centerX = ((int32_t)state.Mode7.CenterX << 19) >> 19;
+	int32_t centerY = ((int32_t)state.Mode7.CenterY << 19) >> 19;
+	uint16_t realY = state.Mode7.VerticalMirroring ? (255 - ppu->_scanline) : ppu->_scanline;
+
+	if(applyMosaic) {
+		realY -= state.MosaicSize - ppu->_mosaicScanlineCounter;
+	}
+	uint8_t mosaicCounter = applyMosaic ? state.MosaicSize - (drawStartX % state.MosaicSize) : 0;
+
+	int32_t xValue = (
+		((state.Mode7.Matrix[0] * clip(hScroll - centerX)) & ~63) +
+		((state.Mode7.Matrix[1] * realY) & ~63) +
+		((state.Mode7.Matrix[1] * clip(vScroll - centerY)) & ~63) +
+		(centerX << 8)
+	);
+
+	int32_t yValue = (
+		((state.Mode7.Matrix[2] * clip(hScroll - centerX)) & ~63) +
+		((state.Mode7.Matrix[3] * realY) & ~63) +
+		((state.Mode7.Matrix[3] * clip(vScroll - centerY)) & ~63) +
+		(centerY << 8)
+	);
+
+	int16_t xStep = state.Mode7.Matrix[0];
+	int16_t yStep = state.Mode7.Matrix[2];
+	if(state.Mode7.HorizontalMirroring) {
+		xValue += xStep * drawEndX;
+		yValue += yStep * drawEndX;
+		xStep = -xStep;
+		yStep = -yStep;
+	}
+
+	xValue += xStep * drawStartX;
+	yValue += yStep * drawStartX;
+
+	uint8_t pixelFlags = ((state.ColorMathEnabled >> layerIndex) & 0x01) ? PixelFlags::AllowColorMath : 0;
+
+	for(int x = drawStartX; x <= drawEndX; x++) {
+		int32_t xOffset = xValue >> 8;
+		int32_t yOffset = yValue >> 8;
+		xValue += xStep;
+		yValue += yStep;
+
+		uint8_t tileIndex;
+		if(!state.Mode7.LargeMap) {
+			yOffset &= 0x3FF;
+			xOffset &= 0x3FF;
+			tileIndex = (uint8_t)ppu->_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
+		} else {
+			if(yOffset < 0 || yOffset > 0x3FF || xOffset < 0 || xOffset > 0x3FF) {
+				if(state.Mode7.FillWithTile0) {
+					tileIndex = 0;
+				} else {
+					continue;
+				}
+			} else {
+				tileIndex = (uint8_t)ppu->_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
+			}
+		}
+
+		uint16_t colorIndex;
+		uint8_t priority;
+		uint8_t color = ppu->_vram[((tileIndex << 6) + ((yOffset & 0x07) << 3) + (xOffset & 0x07))] >> 8;
+		if(layerIndex == 1) {
+			priority = (color & 0x80) ? highPriority : normalPriority;
+			colorIndex = (color & 0x7F);
+		} else {
+			priority = normalPriority;
+			colorIndex = color;
+		}
+
+		if(applyMosaic) {
+			if(mosaicCounter == state.MosaicSize) {
+				mosaicCounter = 1;
+				ppu->_mosaicColor[layerIndex] = colorIndex;
+				ppu->_mosaicPriority[layerIndex] = priority;
+			} else {
+				mosaicCounter++;
+				colorIndex = ppu->_mosaicColor[layerIndex];
+				priority = ppu->_mosaicPriority[layerIndex];
+			}
+		}
+
+		if(colorIndex > 0) {
+			uint16_t paletteColor;
+			if(state.DirectColorMode) {
+				paletteColor = ((colorIndex & 0x07) << 2) | ((colorIndex & 0x38) << 4) | ((colorIndex & 0xC0) << 7);
+			} else {
+				paletteColor = ppu->_cgram[colorIndex];
+			}
+
+			if(drawMain && (ppu->_mainScreenFlags[x] & 0x0F) < priority && !IsMasked(state, layerIndex, state.WindowMaskMain[layerIndex], x)) {
+				ppu->_mainScreenBuffer[x] = paletteColor;
+				ppu->_mainScreenFlags[x] = priority | pixelFlags;
+			}
+
+			if(drawSub && ppu->_subScreenPriority[x] < priority && !IsMasked(state, layerIndex, state.WindowMaskSub[layerIndex], x)) {
+				ppu->_subScreenBuffer[x] = paletteColor;
+				ppu->_subScreenPriority[x] = priority;
+			}
+		}
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "stdafx.h"
+#include <random>
+
+class Ppu;
+
+//Checks that the vectorized pixel kernels give the exact same results as the scalar code they replace
+class PixelKernelsTest
+{
+private:
+	std::mt19937 _random;
+	int32_t _failCount = 0;
+
+	int32_t GetRandom(int32_t min, int32_t max);
+	void ReportFailure(string testName, uint32_t testIndex);
+
+	void TestMode7Lookups();
+	void TestMode7Rendering();
+
+	void InitMode7Scanline(Ppu* ppu, uint32_t seed);
+	void RenderMode7Scanline(Ppu* ppu);
+	void RenderMode7Layer(Ppu* ppu, uint8_t layerIndex, uint8_t normalPriority, uint8_t highPriority);
+
+public:
+	//Returns 0 if all the checks passed, otherwise the number of failed checks
+	int32_t Run();
+};
@@ -14,6 +14,8 @@
 #include "MessageManager.h"
 #include "EventType.h"
 #include "RewindManager.h"
+#include "SubsystemProfiler.h"
+#include "PixelKernels.h"
 #include "../Utilities/HexUtilities.h"
 #include "../Utilities/Serializer.h"
 
@@ -69,6 +71,7 @@ void Ppu::PowerOn()
 	_settings->InitializeRam(_oamRam, Ppu::SpriteRamSize);
 
 	memset(_spriteIndexes, 0xFF, sizeof(_spriteIndexes));
+	_windowMaskDirty = true;
 	
 	UpdateNmiScanline();
 }
@@ -236,7 +239,7 @@ void Ppu::GetChrData(uint8_t layerIndex, uint8_t column, uint8_t plane)
 
 	uint8_t yOffset = vMirror ? (7 - baseYOffset) : baseYOffset;
 	uint16_t pixelStart = tileStart + yOffset + (plane << 3);
-	tileData.ChrData[plane + (secondTile ? bpp / 2 : 0)] = _vram[pixelStart & 0x7FFF];
+	tileData.ChrData[plane + (secondTile ? bpp / 2 : 0)] = DecodeChrWord(_vram[pixelStart & 0x7FFF]);
 }
 
 void Ppu::GetHorizontalOffsetByte(uint8_t columnIndex)
@@ -419,21 +422,24 @@ bool Ppu::ProcessEndOfScanline(uint16_t hClock)
 			_spriteEvalEnd = 0;
 			_spriteFetchingDone = false;
 
-			memset(_hasSpritePriority, 0, sizeof(_hasSpritePriority));
-			memcpy(_spritePriority, _spritePriorityCopy, sizeof(_spritePriority));
-			for(int i = 0; i < 255; i++) {
-				if(_spritePriority[i] < 4) {
-					_hasSpritePriority[_spritePriority[i]] = true;
+			if(!_skipRender) {
+				//The sprite and pixel buffers are only used to draw the next scanline
+				memset(_hasSpritePriority, 0, sizeof(_hasSpritePriority));
+				memcpy(_spritePriority, _spritePriorityCopy, sizeof(_spritePriority));
+				for(int i = 0; i < 255; i++) {
+					if(_spritePriority[i] < 4) {
+						_hasSpritePriority[_spritePriority[i]] = true;
+					}
 				}
-			}
 
-			memcpy(_spritePalette, _spritePaletteCopy, sizeof(_spritePalette));
-			memcpy(_spriteColors, _spriteColorsCopy, sizeof(_spriteColors));
+				memcpy(_spritePalette, _spritePaletteCopy, sizeof(_spritePalette));
+				memcpy(_spriteColors, _spriteColorsCopy, sizeof(_spriteColors));
 
-			memset(_spriteIndexes, 0xFF, sizeof(_spriteIndexes));
+				memset(_spriteIndexes, 0xFF, sizeof(_spriteIndexes));
 
-			memset(_mainScreenFlags, 0, sizeof(_mainScreenFlags));
-			memset(_subScreenPriority, 0, sizeof(_subScreenPriority));
+				memset(_mainScreenFlags, 0, sizeof(_mainScreenFlags));
+				memset(_subScreenPriority, 0, sizeof(_subScreenPriority));
+			}
 		}
 
 		_scanline++;
@@ -476,7 +482,7 @@ bool Ppu::ProcessEndOfScanline(uint16_t hClock)
 				_frameSkipTimer.GetElapsedMS() < 10
 			);
 			
-			if(_console->IsRunAheadFrame()) {
+			if(_console->IsRunAheadFrame() || _settings->CheckFlag(EmulationFlags::SkipRendering)) {
 				_skipRender = true;
 			}
 
@@ -597,7 +603,9 @@ void Ppu::FetchSpriteData()
 {
 	//From H=272 to 339, fetch a single word of CHR data on every cycle (for up to 34 sprites)
 	if(_fetchSpriteStart == 0) {
-		memset(_spritePriorityCopy, 0xFF, sizeof(_spritePriorityCopy));
+		if(!_skipRender) {
+			memset(_spritePriorityCopy, 0xFF, sizeof(_spritePriorityCopy));
+		}
 
 		_spriteTileCount = 0;
 		_currentSprite.Index = 0xFF;
@@ -613,7 +621,8 @@ void Ppu::FetchSpriteData()
 	for(int x = _fetchSpriteStart; x <= _fetchSpriteEnd; x++) {
 		if(x >= 2) {
 			//Fetch the tile using the OAM data loaded on the past 2 cycles, before overwriting it in FetchSpriteAttributes below
-			if(!_state.ForcedVblank) {
+			//When the frame isn't rendered, only the OAM fetches are needed (they set the time over flag and the OAM address)
+			if(!_state.ForcedVblank && !_skipRender) {
 				FetchSpriteTile(x & 0x01);
 			}
 
@@ -720,12 +729,17 @@ void Ppu::FetchSpriteAttributes(uint16_t oamAddress)
 void Ppu::FetchSpriteTile(bool secondCycle)
 {
 	//The timing for the fetches should be (mostly) accurate (H=272 to 339)
-	uint16_t chrData = _vram[_currentSprite.FetchAddress];
-	_currentSprite.ChrData[secondCycle] = chrData;
+	_currentSprite.ChrData[secondCycle] = DecodeChrWord(_vram[_currentSprite.FetchAddress]);
 
 	if(!secondCycle) {
 		_currentSprite.FetchAddress = (_currentSprite.FetchAddress + 8) & 0x7FFF;
 	} else {
+		uint64_t pixels = _currentSprite.ChrData[0] | (_currentSprite.ChrData[1] << 2);
+		if(pixels == 0) {
+			//All 8 pixels are transparent
+			return;
+		}
+
 		int16_t xPos = _currentSprite.DrawX;
 		for(int x = 0; x < 8; x++) {
 			if(xPos + x < 0 || xPos + x > 255) {
@@ -733,7 +747,7 @@ void Ppu::FetchSpriteTile(bool secondCycle)
 			}
 
 			uint8_t xOffset = _currentSprite.HorizontalMirror ? ((7 - x) & 0x07) : x;
-			uint8_t color = GetTilePixelColor<4>(_currentSprite.ChrData, 7 - xOffset);
+			uint8_t color = (uint8_t)(pixels >> (xOffset << 3));
 
 			if(color != 0) {
 				_spriteColorsCopy[xPos + x] = color;
@@ -826,6 +840,7 @@ void Ppu::RenderMode7()
 
 void Ppu::RenderScanline()
 {
+	SubsystemScope profilerScope(EmuSubsystem::PpuRender);
 	int32_t hPos = GetCycle();
 
 	if(hPos <= 255 || _spriteEvalEnd < 255) {
@@ -849,6 +864,10 @@ void Ppu::RenderScanline()
 	if(!_skipRender && _drawStartX <= 255 && hPos > 22 && _scanline > 0) {
 		_drawEndX = std::min(hPos - 22, 255);
 
+		if(_windowMaskDirty) {
+			UpdateWindowMasks();
+		}
+
 		if(_state.ForcedVblank) {
 			//Forced blank, output black
 			memset(_mainScreenBuffer + _drawStartX, 0, (_drawEndX - _drawStartX + 1) * 2);
@@ -908,25 +927,19 @@ void Ppu::RenderSprites(const uint8_t priority[4])
 	bool drawMain = (bool)(((_state.MainScreenLayers & _configVisibleLayers) >> Ppu::SpriteLayerIndex) & 0x01);
 	bool drawSub = (bool)(((_state.SubScreenLayers & _configVisibleLayers) >> Ppu::SpriteLayerIndex) & 0x01);
 
-	uint8_t mainWindowCount = 0;
-	uint8_t subWindowCount = 0;
-	if(_state.WindowMaskMain[Ppu::SpriteLayerIndex]) {
-		mainWindowCount = (uint8_t)_state.Window[0].ActiveLayers[Ppu::SpriteLayerIndex] + (uint8_t)_state.Window[1].ActiveLayers[Ppu::SpriteLayerIndex];
-	}
-	if(_state.WindowMaskSub[Ppu::SpriteLayerIndex]) {
-		subWindowCount = (uint8_t)_state.Window[0].ActiveLayers[Ppu::SpriteLayerIndex] + (uint8_t)_state.Window[1].ActiveLayers[Ppu::SpriteLayerIndex];
-	}
+	const uint8_t* mainWindowMask = GetWindowMask(Ppu::SpriteLayerIndex, _state.WindowMaskMain[Ppu::SpriteLayerIndex]);
+	const uint8_t* subWindowMask = GetWindowMask(Ppu::SpriteLayerIndex, _state.WindowMaskSub[Ppu::SpriteLayerIndex]);
 
 	for(int x = _drawStartX; x <= _drawEndX; x++) {
 		if(_spritePriority[x] <= 3) {
 			uint8_t spritePrio = priority[_spritePriority[x]];
-			if(drawMain && ((_mainScreenFlags[x] & 0x0F) < spritePrio) && !ProcessMaskWindow<Ppu::SpriteLayerIndex>(mainWindowCount, x)) {
+			if(drawMain && ((_mainScreenFlags[x] & 0x0F) < spritePrio) && !mainWindowMask[x]) {
 				uint16_t paletteRamOffset = 128 + (_spritePalette[x] << 4) + _spriteColors[x];
 				_mainScreenBuffer[x] = _cgram[paletteRamOffset];
 				_mainScreenFlags[x] = spritePrio | (((_state.ColorMathEnabled & 0x10) && _spritePalette[x] > 3) ? PixelFlags::AllowColorMath : 0);
 			}
 
-			if(drawSub && (_subScreenPriority[x] < spritePrio) && !ProcessMaskWindow<Ppu::SpriteLayerIndex>(subWindowCount, x)) {
+			if(drawSub && (_subScreenPriority[x] < spritePrio) && !subWindowMask[x]) {
 				uint16_t paletteRamOffset = 128 + (_spritePalette[x] << 4) + _spriteColors[x];
 				_subScreenBuffer[x] = _cgram[paletteRamOffset];
 				_subScreenPriority[x] = spritePrio;
@@ -941,8 +954,8 @@ void Ppu::RenderTilemap()
 	bool drawMain = (bool)(((_state.MainScreenLayers & _configVisibleLayers) >> layerIndex) & 0x01);
 	bool drawSub = (bool)(((_state.SubScreenLayers & _configVisibleLayers) >> layerIndex) & 0x01);
 
-	uint8_t mainWindowCount = _state.WindowMaskMain[layerIndex] ? (uint8_t)_state.Window[0].ActiveLayers[layerIndex] + (uint8_t)_state.Window[1].ActiveLayers[layerIndex] : 0;
-	uint8_t subWindowCount = _state.WindowMaskSub[layerIndex] ? (uint8_t)_state.Window[0].ActiveLayers[layerIndex] + (uint8_t)_state.Window[1].ActiveLayers[layerIndex] : 0;
+	const uint8_t* mainWindowMask = GetWindowMask(layerIndex, _state.WindowMaskMain[layerIndex]);
+	const uint8_t* subWindowMask = GetWindowMask(layerIndex, _state.WindowMaskSub[layerIndex]);
 
 	uint16_t hScrollOriginal = _state.Layers[layerIndex].HScroll;
 	uint16_t hScroll = hiResMode ? (hScrollOriginal << 1) : hScrollOriginal;
@@ -956,32 +969,44 @@ void Ppu::RenderTilemap()
 	uint8_t hiresSubColor;
 	uint8_t pixelFlags = (((_state.ColorMathEnabled >> layerIndex) & 0x01) ? PixelFlags::AllowColorMath : 0);
 
+	//Pixels for the current tile row, only rebuilt when x reaches the next tile
+	uint8_t fineScroll = hScrollOriginal & 0x07;
+	int pixelRowKey = -1;
+	uint64_t pixels = 0;
+
 	for(int x = _drawStartX; x <= _drawEndX; x++) {
+		int key = (x + fineScroll) >> (hiResMode ? 2 : 3);
 		if(hiResMode) {
-			lookupIndex = (x + (hScrollOriginal & 0x07)) >> 2;
-			chrDataOffset = (lookupIndex & 0x01) * bpp / 2;
-			lookupIndex >>= 1;
+			lookupIndex = key >> 1;
+			chrDataOffset = (key & 0x01) * bpp / 2;
 		} else {
-			lookupIndex = (x + (hScrollOriginal & 0x07)) >> 3;
+			lookupIndex = key;
+			chrDataOffset = 0;
+		}
+
+		if(key != pixelRowKey) {
+			pixelRowKey = key;
+			pixels = GetTilePixelRow<bpp>(tileData[lookupIndex].ChrData + chrDataOffset);
+			if(!applyMosaic && pixels == 0) {
+				//Nothing to draw for this tile, skip to the next one
+				x = ((x + fineScroll) | (hiResMode ? 0x03 : 0x07)) - fineScroll;
+				continue;
+			}
 		}
 
 		uint16_t tilemapData = tileData[lookupIndex].TilemapData;
-		uint16_t* chrData = tileData[lookupIndex].ChrData;
 		bool hMirror = (tilemapData & 0x4000) != 0;
 
 		uint8_t color;
 		if(hiResMode) {
 			uint8_t xOffset = ((x << 1) + 1 + hScroll) & 0x07;
-			uint8_t shift = hMirror ? xOffset : (7 - xOffset);
-			color = GetTilePixelColor<bpp>(chrData + chrDataOffset, shift);
+			color = (uint8_t)(pixels >> ((hMirror ? (7 - xOffset) : xOffset) << 3));
 			
 			xOffset = ((x << 1) + hScroll) & 0x07;
-			shift = hMirror ? xOffset : (7 - xOffset);
-			hiresSubColor = GetTilePixelColor<bpp>(chrData + chrDataOffset, shift);
+			hiresSubColor = (uint8_t)(pixels >> ((hMirror ? (7 - xOffset) : xOffset) << 3));
 		} else {
 			uint8_t xOffset = (x + hScroll) & 0x07;
-			uint8_t shift = hMirror ? xOffset : (7 - xOffset);
-			color = GetTilePixelColor<bpp>(chrData, shift);
+			color = (uint8_t)(pixels >> ((hMirror ? (7 - xOffset) : xOffset) << 3));
 		}
 
 		uint8_t paletteIndex = (tilemapData >> 10) & 0x07;
@@ -1008,16 +1033,16 @@ void Ppu::RenderTilemap()
 
 		if(color > 0) {
 			uint16_t rgbColor = GetRgbColor<bpp, directColorMode, basePaletteOffset>(paletteIndex, color);
-			if(drawMain && (_mainScreenFlags[x] & 0x0F) < priority && !ProcessMaskWindow<layerIndex>(mainWindowCount, x)) {
+			if(drawMain && (_mainScreenFlags[x] & 0x0F) < priority && !mainWindowMask[x]) {
 				DrawMainPixel(x, rgbColor, priority | pixelFlags);
 			}
-			if(!hiResMode && drawSub && _subScreenPriority[x] < priority && !ProcessMaskWindow<layerIndex>(subWindowCount, x)) {
+			if(!hiResMode && drawSub && _subScreenPriority[x] < priority && !subWindowMask[x]) {
 				DrawSubPixel(x, rgbColor, priority);
 			}
 		}
 
 		if(hiResMode) {
-			if(hiresSubColor > 0 && drawSub && _subScreenPriority[x] < priority && !ProcessMaskWindow<layerIndex>(subWindowCount, x)) {
+			if(hiresSubColor > 0 && drawSub && _subScreenPriority[x] < priority && !subWindowMask[x]) {
 				uint16_t hiresSubRgbColor = GetRgbColor<bpp, directColorMode, basePaletteOffset>(paletteIndex, hiresSubColor);
 				DrawSubPixel(x, hiresSubRgbColor, priority);
 			}
@@ -1054,38 +1079,46 @@ bool Ppu::IsRenderRequired(uint8_t layerIndex)
 	return false;
 }
 
+uint64_t Ppu::DecodeChrWord(uint16_t chrData)
+{
+	//Converts a pair of bitplanes (low byte = plane 0, high byte = plane 1) to 8 chunky pixels.
+	//The multiply moves bit 7-n of each plane to bit 7 of byte n (the bits never overlap, so there are no carries)
+	uint64_t plane0 = (((uint64_t)(chrData & 0xFF) * 0x8040201008040201ULL) & 0x8080808080808080ULL) >> 7;
+	uint64_t plane1 = (((uint64_t)(chrData >> 8) * 0x8040201008040201ULL) & 0x8080808080808080ULL) >> 6;
+	return plane0 | plane1;
+}
+
+uint16_t Ppu::EncodeChrWord(uint64_t pixels)
+{
+	//Inverse of DecodeChrWord (only used by save states)
+	uint16_t chrData = 0;
+	for(int i = 0; i < 8; i++) {
+		uint8_t color = (uint8_t)(pixels >> (i << 3));
+		chrData |= ((color & 0x01) << (7 - i)) | (((color >> 1) & 0x01) << (15 - i));
+	}
+	return chrData;
+}
+
 template<uint8_t bpp>
-uint8_t Ppu::GetTilePixelColor(const uint16_t chrData[4], const uint8_t shift)
+uint64_t Ppu::GetTilePixelRow(const uint64_t chrData[4])
 {
-	uint8_t color;
+	//Merges the decoded bitplane pairs into 8 color indexes (1 byte per pixel)
 	if(bpp == 2) {
-		color = (chrData[0] >> shift) & 0x01;
-		color |= (chrData[0] >> (7 + shift)) & 0x02;
+		return chrData[0];
 	} else if(bpp == 4) {
-		color = (chrData[0] >> shift) & 0x01;
-		color |= (chrData[0] >> (7 + shift)) & 0x02;
-		color |= ((chrData[1] >> shift) & 0x01) << 2;
-		color |= ((chrData[1] >> (7 + shift)) & 0x02) << 2;
+		return chrData[0] | (chrData[1] << 2);
 	} else if(bpp == 8) {
-		color = (chrData[0] >> shift) & 0x01;
-		color |= (chrData[0] >> (7 + shift)) & 0x02;
-		color |= ((chrData[1] >> shift) & 0x01) << 2;
-		color |= ((chrData[1] >> (7 + shift)) & 0x02) << 2;
-		color |= ((chrData[2] >> shift) & 0x01) << 4;
-		color |= ((chrData[2] >> (7 + shift)) & 0x02) << 4;
-		color |= ((chrData[3] >> shift) & 0x01) << 6;
-		color |= ((chrData[3] >> (7 + shift)) & 0x02) << 6;
+		return chrData[0] | (chrData[1] << 2) | (chrData[2] << 4) | (chrData[3] << 6);
 	} else {
 		throw std::runtime_error("unsupported bpp");
 	}
-	return color;
 }
 
 template<uint8_t layerIndex, uint8_t normalPriority, uint8_t highPriority, bool applyMosaic, bool directColorMode>
 void Ppu::RenderTilemapMode7()
 {
-	uint8_t mainWindowCount = _state.WindowMaskMain[layerIndex] ? (uint8_t)_state.Window[0].ActiveLayers[layerIndex] + (uint8_t)_state.Window[1].ActiveLayers[layerIndex] : 0;
-	uint8_t subWindowCount = _state.WindowMaskSub[layerIndex] ? (uint8_t)_state.Window[0].ActiveLayers[layerIndex] + (uint8_t)_state.Window[1].ActiveLayers[layerIndex] : 0;
+	const uint8_t* mainWindowMask = GetWindowMask(layerIndex, _state.WindowMaskMain[layerIndex]);
+	const uint8_t* subWindowMask = GetWindowMask(layerIndex, _state.WindowMaskSub[layerIndex]);
 	
 	bool drawMain = (bool)(((_state.MainScreenLayers & _configVisibleLayers) >> layerIndex) & 0x01);
 	bool drawSub = (bool)(((_state.SubScreenLayers & _configVisibleLayers) >> layerIndex) & 0x01);
@@ -1139,39 +1172,34 @@ void Ppu::RenderTilemapMode7()
 	
 	uint8_t pixelFlags = ((_state.ColorMathEnabled >> layerIndex) & 0x01) ? PixelFlags::AllowColorMath : 0;
 
+	//Calculate the tilemap & tile addresses for all pixels at once (vectorized), then fetch them from VRAM
+	uint32_t lookups[256];
+	PixelKernels::GetMode7Lookups(xValue, yValue, xStep, yStep, _state.Mode7.LargeMap, _drawEndX - _drawStartX + 1, lookups);
+
 	for(int x = _drawStartX; x <= _drawEndX; x++) {
-		int32_t xOffset = xValue >> 8;
-		int32_t yOffset = yValue >> 8;
-		xValue += xStep;
-		yValue += yStep;
+		uint32_t lookup = lookups[x - _drawStartX];
 
 		uint8_t tileIndex;
-		if(!_state.Mode7.LargeMap) {
-			yOffset &= 0x3FF;
-			xOffset &= 0x3FF;
-			tileIndex = (uint8_t)_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
-		} else {
-			if(yOffset < 0 || yOffset > 0x3FF || xOffset < 0 || xOffset > 0x3FF) {
-				if(_state.Mode7.FillWithTile0) {
-					tileIndex = 0;
-				} else {
-					//Draw nothing for this pixel, we're outside the map
-					continue;
-				}
+		if(lookup & 0x80000000) {
+			if(_state.Mode7.FillWithTile0) {
+				tileIndex = 0;
 			} else {
-				tileIndex = (uint8_t)_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
+				//Draw nothing for this pixel, we're outside the map
+				continue;
 			}
+		} else {
+			tileIndex = (uint8_t)_vram[lookup & 0x3FFF];
 		}
 
 		uint16_t colorIndex;
 		uint8_t priority;
+		uint8_t color = _vram[(tileIndex << 6) + ((lookup >> 16) & 0x3F)] >> 8;
 		if(layerIndex == 1) {
-			uint8_t color = _vram[((tileIndex << 6) + ((yOffset & 0x07) << 3) + (xOffset & 0x07))] >> 8;
 			priority = (color & 0x80) ? highPriority : normalPriority;
 			colorIndex = (color & 0x7F);
 		} else {
 			priority = normalPriority;
-			colorIndex = _vram[((tileIndex << 6) + ((yOffset & 0x07) << 3) + (xOffset & 0x07))] >> 8;
+			colorIndex = color;
 		}
 
 		if(applyMosaic) {
@@ -1194,11 +1222,11 @@ void Ppu::RenderTilemapMode7()
 				paletteColor = _cgram[colorIndex];
 			}
 			
-			if(drawMain && (_mainScreenFlags[x] & 0x0F) < priority && !ProcessMaskWindow<layerIndex>(mainWindowCount, x)) {
+			if(drawMain && (_mainScreenFlags[x] & 0x0F) < priority && !mainWindowMask[x]) {
 				DrawMainPixel(x, paletteColor, priority | pixelFlags);
 			} 
 
-			if(drawSub && _subScreenPriority[x] < priority && !ProcessMaskWindow<layerIndex>(subWindowCount, x)) {
+			if(drawSub && _subScreenPriority[x] < priority && !subWindowMask[x]) {
 				DrawSubPixel(x, paletteColor, priority);
 			}
 		}
@@ -1219,12 +1247,12 @@ void Ppu::DrawSubPixel(uint8_t x, uint16_t color, uint8_t priority)
 
 void Ppu::ApplyColorMath()
 {
-	uint8_t activeWindowCount = (uint8_t)_state.Window[0].ActiveLayers[Ppu::ColorWindowIndex] + (uint8_t)_state.Window[1].ActiveLayers[Ppu::ColorWindowIndex];
+	const uint8_t* windowMask = _windowMask[Ppu::ColorWindowIndex];
 	bool hiResMode = _state.HiResMode || _state.BgMode == 5 || _state.BgMode == 6;
 
 	if(hiResMode) {
 		for(int x = _drawStartX; x <= _drawEndX; x++) {
-			bool isInsideWindow = ProcessMaskWindow<Ppu::ColorWindowIndex>(activeWindowCount, x);
+			bool isInsideWindow = windowMask[x] != 0;
 
 			//Keep original subscreen color, which is used to apply color math to the main screen after
 			uint16_t subPixel = _subScreenBuffer[x];
@@ -1237,7 +1265,7 @@ void Ppu::ApplyColorMath()
 		}
 	} else {
 		for(int x = _drawStartX; x <= _drawEndX; x++) {
-			bool isInsideWindow = ProcessMaskWindow<Ppu::ColorWindowIndex>(activeWindowCount, x);
+			bool isInsideWindow = windowMask[x] != 0;
 			ApplyColorMathToPixel(_mainScreenBuffer[x], _subScreenBuffer[x], x, isInsideWindow);
 		}
 	}
@@ -1340,7 +1368,7 @@ void Ppu::ApplyBrightness()
 void Ppu::ConvertToHiRes()
 {
 	bool useHighResOutput = _useHighResOutput || IsDoubleWidth() || _state.ScreenInterlace;
-	if(!useHighResOutput || _useHighResOutput == useHighResOutput || _scanline >= _vblankStartScanline || _scanline == 0) {
+	if(_skipRender || !useHighResOutput || _useHighResOutput == useHighResOutput || _scanline >= _vblankStartScanline || _scanline == 0) {
 		return;
 	}
 
@@ -1402,30 +1430,50 @@ void Ppu::ApplyHiResMode()
 	}
 }
 
-template<uint8_t layerIndex>
-bool Ppu::ProcessMaskWindow(uint8_t activeWindowCount, int x)
+void Ppu::UpdateWindowMasks()
 {
-	switch(activeWindowCount) {
-		case 1: 
-			if(_state.Window[0].ActiveLayers[layerIndex]) {
-				return _state.Window[0].PixelNeedsMasking<layerIndex>(x);
-			}
-			return _state.Window[1].PixelNeedsMasking<layerIndex>(x);
+	//Evaluate both windows and the mask logic for each layer once, instead of for every pixel
+	_windowMaskDirty = false;
+
+	for(int layerIndex = 0; layerIndex < 6; layerIndex++) {
+		uint8_t* mask = _windowMask[layerIndex];
+		WindowConfig &window1 = _state.Window[0];
+		WindowConfig &window2 = _state.Window[1];
 
-		case 2:
-			switch(_state.MaskLogic[layerIndex]) {
-				default:
-				case WindowMaskLogic::Or: return _state.Window[0].PixelNeedsMasking<layerIndex>(x) | _state.Window[1].PixelNeedsMasking<layerIndex>(x);
-				case WindowMaskLogic::And: return _state.Window[0].PixelNeedsMasking<layerIndex>(x) & _state.Window[1].PixelNeedsMasking<layerIndex>(x);
-				case WindowMaskLogic::Xor: return _state.Window[0].PixelNeedsMasking<layerIndex>(x) ^ _state.Window[1].PixelNeedsMasking<layerIndex>(x);
-				case WindowMaskLogic::Xnor: return !(_state.Window[0].PixelNeedsMasking<layerIndex>(x) ^ _state.Window[1].PixelNeedsMasking<layerIndex>(x));
+		if(window1.ActiveLayers[layerIndex] && window2.ActiveLayers[layerIndex]) {
+			WindowMaskLogic logic = _state.MaskLogic[layerIndex];
+			for(int x = 0; x < 256; x++) {
+				bool mask1 = window1.PixelNeedsMasking(layerIndex, x);
+				bool mask2 = window2.PixelNeedsMasking(layerIndex, x);
+				switch(logic) {
+					default:
+					case WindowMaskLogic::Or: mask[x] = mask1 | mask2; break;
+					case WindowMaskLogic::And: mask[x] = mask1 & mask2; break;
+					case WindowMaskLogic::Xor: mask[x] = mask1 ^ mask2; break;
+					case WindowMaskLogic::Xnor: mask[x] = !(mask1 ^ mask2); break;
+				}
 			}
+		} else if(window1.ActiveLayers[layerIndex] || window2.ActiveLayers[layerIndex]) {
+			WindowConfig &window = window1.ActiveLayers[layerIndex] ? window1 : window2;
+			for(int x = 0; x < 256; x++) {
+				mask[x] = window.PixelNeedsMasking(layerIndex, x);
+			}
+		} else {
+			memset(mask, 0, 256);
+		}
 	}
-	return false;
+}
+
+const uint8_t* Ppu::GetWindowMask(uint8_t layerIndex, bool maskEnabled)
+{
+	static const uint8_t noMask[256] = {};
+	return maskEnabled ? _windowMask[layerIndex] : noMask;
 }
 
 void Ppu::ProcessWindowMaskSettings(uint8_t value, uint8_t offset)
 {
+	_windowMaskDirty = true;
+
 	_state.Window[0].ActiveLayers[0 + offset] = (value & 0x02) != 0;
 	_state.Window[0].ActiveLayers[1 + offset] = (value & 0x20) != 0;
 	_state.Window[0].InvertedLayers[0 + offset] = (value & 0x01) != 0;
@@ -1470,6 +1518,12 @@ void Ppu::SendFrame()
 }
 
 
+bool Ppu::CanAccessVideoMemory()
+{
+	//True when VRAM/OAM/CGRAM writes don't depend on the current rendering position
+	return _state.ForcedVblank || (_scanline >= _vblankStartScanline && _scanline >= _nmiScanline);
+}
+
 bool Ppu::IsHighResOutput()
 {
 	return _useHighResOutput;
@@ -2000,21 +2054,25 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 		case 0x2126:
 			//WH0 - Window 1 Left Position
 			_state.Window[0].Left = value;
+			_windowMaskDirty = true;
 			break;
 		
 		case 0x2127:
 			//WH1 - Window 1 Right Position
 			_state.Window[0].Right = value;
+			_windowMaskDirty = true;
 			break;
 
 		case 0x2128:
 			//WH2 - Window 2 Left Position
 			_state.Window[1].Left = value;
+			_windowMaskDirty = true;
 			break;
 
 		case 0x2129:
 			//WH3 - Window 2 Right Position
 			_state.Window[1].Right = value;
+			_windowMaskDirty = true;
 			break;
 
 		case 0x212A:
@@ -2023,12 +2081,14 @@ void Ppu::Write(uint32_t addr, uint8_t value)
 			_state.MaskLogic[1] = (WindowMaskLogic)((value >> 2) & 0x03);
 			_state.MaskLogic[2] = (WindowMaskLogic)((value >> 4) & 0x03);
 			_state.MaskLogic[3] = (WindowMaskLogic)((value >> 6) & 0x03);
+			_windowMaskDirty = true;
 			break;
 
 		case 0x212B:
 			//WOBJLOG - Window mask logic for OBJs and Color Window
 			_state.MaskLogic[4] = (WindowMaskLogic)((value >> 0) & 0x03);
 			_state.MaskLogic[5] = (WindowMaskLogic)((value >> 2) & 0x03);
+			_windowMaskDirty = true;
 			break;
 
 		case 0x212C:
@@ -2152,13 +2212,27 @@ void Ppu::Serialize(Serializer &s)
 	
 	for(int i = 0; i < 4; i++) {
 		for(int j = 0; j < 33; j++) {
-			s.Stream(
-				_layerData[i].Tiles[j].ChrData[0], _layerData[i].Tiles[j].ChrData[1], _layerData[i].Tiles[j].ChrData[2], _layerData[i].Tiles[j].ChrData[3],
-				_layerData[i].Tiles[j].TilemapData, _layerData[i].Tiles[j].VScroll
-			);
+			//The fetched CHR data is saved in its original (bitplane) format
+			TileData &tile = _layerData[i].Tiles[j];
+			uint16_t chrData[4] = {};
+			if(s.IsSaving()) {
+				for(int k = 0; k < 4; k++) {
+					chrData[k] = EncodeChrWord(tile.ChrData[k]);
+				}
+			}
+
+			s.Stream(chrData[0], chrData[1], chrData[2], chrData[3], tile.TilemapData, tile.VScroll);
+
+			if(!s.IsSaving()) {
+				for(int k = 0; k < 4; k++) {
+					tile.ChrData[k] = DecodeChrWord(chrData[k]);
+				}
+			}
 		}
 	}
 	s.Stream(_hOffset, _vOffset, _fetchBgStart, _fetchBgEnd, _fetchSpriteStart, _fetchSpriteEnd);
+
+	_windowMaskDirty = true;
 }
 
 void Ppu::RandomizeState()
@@ -12,6 +12,9 @@ class EmuSettings;
 
 class Ppu : public ISerializable
 {
+	friend class PixelKernelsTest;
+	friend class PpuRenderBenchmark;
+
 public:
 	constexpr static uint32_t SpriteRamSize = 544;
 	constexpr static uint32_t CgRamSize = 512;
@@ -81,6 +84,10 @@ private:
 	uint8_t _subScreenPriority[256] = {};
 	uint16_t _subScreenBuffer[256] = {};
 
+	//Window mask for each layer (BG1-4, sprites, color window) - 1 if the pixel is masked
+	uint8_t _windowMask[6][256] = {};
+	bool _windowMaskDirty = true;
+
 	uint32_t _mosaicColor[4] = {};
 	uint32_t _mosaicPriority[4] = {};
 	uint16_t _mosaicScanlineCounter = 0;
@@ -154,8 +161,11 @@ private:
 
 	__forceinline bool IsRenderRequired(uint8_t layerIndex);
 
+	__forceinline static uint64_t DecodeChrWord(uint16_t chrData);
+	static uint16_t EncodeChrWord(uint64_t pixels);
+
 	template<uint8_t bpp>
-	__forceinline uint8_t GetTilePixelColor(const uint16_t chrData[4], const uint8_t shift);
+	__forceinline uint64_t GetTilePixelRow(const uint64_t chrData[4]);
 
 	template<uint8_t layerIndex, uint8_t normalPriority, uint8_t highPriority>
 	__forceinline void RenderTilemapMode7();
@@ -178,8 +188,8 @@ private:
 	void ConvertToHiRes();
 	void ApplyHiResMode();
 
-	template<uint8_t layerIndex>
-	bool ProcessMaskWindow(uint8_t activeWindowCount, int x);
+	void UpdateWindowMasks();
+	__forceinline const uint8_t* GetWindowMask(uint8_t layerIndex, bool maskEnabled);
 
 	void ProcessWindowMaskSettings(uint8_t value, uint8_t offset);
 
@@ -228,6 +238,7 @@ public:
 	uint16_t GetLastScanline();
 
 	bool IsHighResOutput();
+	bool CanAccessVideoMemory();
 	uint16_t* GetScreenBuffer();
 	uint16_t* GetPreviousScreenBuffer();
 	uint8_t* GetVideoRam();
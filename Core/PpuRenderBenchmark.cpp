@@ -0,0 +1,236 @@
+#include "stdafx.h"
+#include "PpuRenderBenchmark.h"
+#include "Ppu.h"
+#include "PpuTypes.h"
+#include "../Utilities/Timer.h"
+
+static const uint8_t _noWindowMask[256] = {};
+
+Mode1RenderResult PpuRenderBenchmark::Run(uint32_t frameCount)
+{
+	Mode1RenderResult result;
+	unique_ptr<Ppu> ppu(new Ppu(nullptr));
+
+	_random.seed(0x4D315242);
+	InitScene(ppu.get());
+
+	uint16_t mainScreenBuffer[256];
+	uint8_t mainScreenFlags[256];
+	uint16_t subScreenBuffer[256];
+	uint8_t subScreenPriority[256];
+
+	constexpr uint8_t spritePriorities[4] = { 2, 4, 7, 10 };
+	constexpr uint8_t planeCount[3] = { 2, 2, 1 };
+
+	double fetchTime = 0;
+	double decodeTime = 0;
+	double renderTime = 0;
+	double planarRenderTime = 0;
+	bool identical = true;
+	Timer timer;
+
+	PpuState &state = ppu->_state;
+	for(uint32_t frame = 0; frame < frameCount; frame++) {
+		//Scrolling foreground and background, with a static status bar on BG3
+		state.Layers[0].HScroll = (frame * 2) & 0x3FF;
+		state.Layers[0].VScroll = (frame / 2) & 0x3FF;
+		state.Layers[1].HScroll = frame & 0x3FF;
+		state.Layers[1].VScroll = (frame / 4) & 0x3FF;
+
+		for(uint16_t scanline = 1; scanline <= 224; scanline++) {
+			ppu->_scanline = scanline;
+			ppu->_fetchBgStart = 0;
+			ppu->_fetchBgEnd = 263;
+			ppu->_drawStartX = 0;
+			ppu->_drawEndX = 255;
+
+			timer.Reset();
+			ppu->FetchTileData();
+			fetchTime += timer.GetElapsedMS();
+
+			//The raw bitplane words, as they were stored by the tile fetches before they decoded them
+			for(int i = 0; i < 3; i++) {
+				for(int j = 0; j < 33; j++) {
+					for(int k = 0; k < planeCount[i]; k++) {
+						_planarChrData[i][j][k] = Ppu::EncodeChrWord(ppu->_layerData[i].Tiles[j].ChrData[k]);
+					}
+				}
+			}
+
+			//Time spent decoding the words during the fetches (same conversion as Ppu::DecodeChrWord, which is only inlined in Ppu.cpp)
+			timer.Reset();
+			for(int i = 0; i < 3; i++) {
+				for(int j = 0; j < 33; j++) {
+					for(int k = 0; k < planeCount[i]; k++) {
+						uint16_t chrData = _planarChrData[i][j][k];
+						uint64_t plane0 = (((uint64_t)(chrData & 0xFF) * 0x8040201008040201ULL) & 0x8080808080808080ULL) >> 7;
+						uint64_t plane1 = (((uint64_t)(chrData >> 8) * 0x8040201008040201ULL) & 0x8080808080808080ULL) >> 6;
+						_decodedChrData[i][j][k] = plane0 | plane1;
+					}
+				}
+			}
+			decodeTime += timer.GetElapsedMS();
+
+			for(int i = 0; i < 3; i++) {
+				for(int j = 0; j < 33; j++) {
+					if(memcmp(_decodedChrData[i][j], ppu->_layerData[i].Tiles[j].ChrData, planeCount[i] * sizeof(uint64_t)) != 0) {
+						identical = false;
+					}
+				}
+			}
+
+			ClearScanline(ppu.get());
+			timer.Reset();
+			ppu->RenderMode1();
+			renderTime += timer.GetElapsedMS();
+
+			memcpy(mainScreenBuffer, ppu->_mainScreenBuffer, sizeof(mainScreenBuffer));
+			memcpy(mainScreenFlags, ppu->_mainScreenFlags, sizeof(mainScreenFlags));
+			memcpy(subScreenBuffer, ppu->_subScreenBuffer, sizeof(subScreenBuffer));
+			memcpy(subScreenPriority, ppu->_subScreenPriority, sizeof(subScreenPriority));
+
+			ClearScanline(ppu.get());
+			timer.Reset();
+			ppu->RenderSprites(spritePriorities);
+			RenderPlanarTilemap<0, 4, 6, 9>(ppu.get());
+			RenderPlanarTilemap<1, 4, 5, 8>(ppu.get());
+			RenderPlanarTilemap<2, 2, 1, 3>(ppu.get());
+			planarRenderTime += timer.GetElapsedMS();
+
+			if(
+				memcmp(mainScreenBuffer, ppu->_mainScreenBuffer, sizeof(mainScreenBuffer)) != 0 ||
+				memcmp(mainScreenFlags, ppu->_mainScreenFlags, sizeof(mainScreenFlags)) != 0 ||
+				memcmp(subScreenBuffer, ppu->_subScreenBuffer, sizeof(subScreenBuffer)) != 0 ||
+				memcmp(subScreenPriority, ppu->_subScreenPriority, sizeof(subScreenPriority)) != 0
+			) {
+				identical = false;
+			}
+		}
+	}
+
+	result.FrameCount = frameCount;
+	if(frameCount > 0) {
+		result.FetchNsPerFrame = fetchTime * 1000000 / frameCount;
+		result.DecodeNsPerFrame = decodeTime * 1000000 / frameCount;
+		result.RenderNsPerFrame = renderTime * 1000000 / frameCount;
+		result.PlanarRenderNsPerFrame = planarRenderTime * 1000000 / frameCount;
+	}
+	if(renderTime > 0) {
+		result.RenderSpeedup = planarRenderTime / renderTime;
+		result.Speedup = (fetchTime - decodeTime + planarRenderTime) / (fetchTime + renderTime);
+	}
+	result.Identical = identical;
+	return result;
+}
+
+void PpuRenderBenchmark::InitScene(Ppu* ppu)
+{
+	//Random tiles, palettes and tilemaps
+	for(uint32_t i = 0; i < Ppu::VideoRamSize >> 1; i++) {
+		ppu->_vram[i] = (uint16_t)_random();
+	}
+	for(uint32_t i = 0; i < Ppu::CgRamSize >> 1; i++) {
+		ppu->_cgram[i] = (uint16_t)_random() & 0x7FFF;
+	}
+
+	PpuState &state = ppu->_state;
+	state = {};
+	state.BgMode = 1;
+	state.MosaicSize = 1;
+	state.MainScreenLayers = 0x17;
+	state.SubScreenLayers = 0x04;
+	state.ColorMathEnabled = 0x24;
+
+	constexpr uint16_t tilemapAddresses[3] = { 0x0000, 0x1000, 0x1800 };
+	constexpr uint16_t chrAddresses[3] = { 0x2000, 0x4000, 0x6000 };
+	constexpr uint8_t tileSize[3] = { 16, 16, 8 };
+	for(int i = 0; i < 3; i++) {
+		LayerConfig &layer = state.Layers[i];
+		layer.TilemapAddress = tilemapAddresses[i];
+		layer.ChrAddress = chrAddresses[i];
+		layer.DoubleWidth = i < 2;
+		layer.DoubleHeight = i < 2;
+
+		//Tile 0 is fully transparent, and is used by 40% of the tilemap entries
+		memset(ppu->_vram + layer.ChrAddress, 0, tileSize[i] * sizeof(uint16_t));
+		for(int j = 0; j < (i < 2 ? 0x1000 : 0x400); j++) {
+			uint16_t tilemapData = (uint16_t)_random();
+			if(std::uniform_int_distribution<int>(0, 9)(_random) < 4) {
+				tilemapData &= ~0x3FF;
+			}
+			ppu->_vram[layer.TilemapAddress + j] = tilemapData;
+		}
+	}
+
+	//No windows, and no sprites on any scanline
+	ppu->_configVisibleLayers = 0xFF;
+	ppu->UpdateWindowMasks();
+	memset(ppu->_spritePriority, 0xFF, sizeof(ppu->_spritePriority));
+}
+
+void PpuRenderBenchmark::ClearScanline(Ppu* ppu)
+{
+	for(int x = 0; x < 256; x++) {
+		ppu->_mainScreenBuffer[x] = ppu->_cgram[0];
+		ppu->_mainScreenFlags[x] = 0;
+		ppu->_subScreenBuffer[x] = ppu->_cgram[0];
+		ppu->_subScreenPriority[x] = 0;
+	}
+}
+
+template<uint8_t layerIndex, uint8_t bpp, uint8_t normalPriority, uint8_t highPriority>
+void PpuRenderBenchmark::RenderPlanarTilemap(Ppu* ppu)
+{
+	//Copy of Ppu::RenderTilemap (without mosaic, hi-res and direct color) from before the tile rows were decoded at fetch time
+	PpuState &state = ppu->_state;
+	bool drawMain = (bool)(((state.MainScreenLayers & ppu->_configVisibleLayers) >> layerIndex) & 0x01);
+	bool drawSub = (bool)(((state.SubScreenLayers & ppu->_configVisibleLayers) >> layerIndex) & 0x01);
+	if(!drawMain && !drawSub) {
+		return;
+	}
+
+	const uint8_t* mainWindowMask = state.WindowMaskMain[layerIndex] ? ppu->_windowMask[layerIndex] : _noWindowMask;
+	const uint8_t* subWindowMask = state.WindowMaskSub[layerIndex] ? ppu->_windowMask[layerIndex] : _noWindowMask;
+
+	uint16_t hScroll = state.Layers[layerIndex].HScroll;
+	TileData* tileData = ppu->_layerData[layerIndex].Tiles;
+	uint8_t pixelFlags = (((state.ColorMathEnabled >> layerIndex) & 0x01) ? PixelFlags::AllowColorMath : 0);
+
+	for(int x = ppu->_drawStartX; x <= ppu->_drawEndX; x++) {
+		uint8_t lookupIndex = (x + (hScroll & 0x07)) >> 3;
+		uint16_t tilemapData = tileData[lookupIndex].TilemapData;
+		uint16_t* chrData = _planarChrData[layerIndex][lookupIndex];
+		bool hMirror = (tilemapData & 0x4000) != 0;
+
+		uint8_t xOffset = (x + hScroll) & 0x07;
+		uint8_t shift = hMirror ? xOffset : (7 - xOffset);
+		uint8_t color = GetTilePixelColor<bpp>(chrData, shift);
+
+		uint8_t paletteIndex = (tilemapData >> 10) & 0x07;
+		uint8_t priority = (tilemapData & 0x2000) ? highPriority : normalPriority;
+
+		if(color > 0) {
+			uint16_t rgbColor = ppu->_cgram[paletteIndex * (1 << bpp) + color];
+			if(drawMain && (ppu->_mainScreenFlags[x] & 0x0F) < priority && !mainWindowMask[x]) {
+				ppu->_mainScreenBuffer[x] = rgbColor;
+				ppu->_mainScreenFlags[x] = priority | pixelFlags;
+			}
+			if(drawSub && ppu->_subScreenPriority[x] < priority && !subWindowMask[x]) {
+				ppu->_subScreenBuffer[x] = rgbColor;
+				ppu->_subScreenPriority[x] = priority;
+			}
+		}
+	}
+}
+
+template<uint8_t bpp>
+uint8_t PpuRenderBenchmark::GetTilePixelColor(const uint16_t chrData[4], const uint8_t shift)
+{
+	uint8_t color = (chrData[0] >> shift) & 0x01;
+	color |= (chrData[0] >> (7 + shift)) & 0x02;
+	if(bpp >= 4) {
+		color |= ((chrData[1] >> shift) & 0x01) << 2;
+		color |= ((chrData[1] >> (7 + shift)) & 0x02) << 2;
+	}
+	return color;
+}
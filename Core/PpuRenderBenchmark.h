@@ -0,0 +1,46 @@
+#pragma once
+#include "stdafx.h"
+#include <random>
+
+class Ppu;
+
+struct Mode1RenderResult
+{
+	uint32_t FrameCount = 0;
+
+	//Average time spent on each frame (224 scanlines), in ns
+	double FetchNsPerFrame = 0;
+	double DecodeNsPerFrame = 0;
+	double RenderNsPerFrame = 0;
+	double PlanarRenderNsPerFrame = 0;
+
+	//Planar render time vs render time, and the same ratio with the tile fetches included
+	//(the fetch time includes the bitplane decoding, which the planar version didn't need)
+	double RenderSpeedup = 0;
+	double Speedup = 0;
+
+	//True if both versions drew exactly the same pixels on every scanline
+	bool Identical = false;
+};
+
+//Renders a synthetic mode 1 scene (3 scrolling layers, 4/4/2bpp, 40% empty tiles) with the PPU's renderer, which uses
+//tile rows decoded when they are fetched, and with a copy of the old renderer that extracted each pixel from the bitplanes
+class PpuRenderBenchmark
+{
+private:
+	std::mt19937 _random;
+	uint16_t _planarChrData[3][33][4] = {};
+	uint64_t _decodedChrData[3][33][4] = {};
+
+	void InitScene(Ppu* ppu);
+	void ClearScanline(Ppu* ppu);
+
+	template<uint8_t layerIndex, uint8_t bpp, uint8_t normalPriority, uint8_t highPriority>
+	void RenderPlanarTilemap(Ppu* ppu);
+
+	template<uint8_t bpp>
+	static uint8_t GetTilePixelColor(const uint16_t chrData[4], const uint8_t shift);
+
+public:
+	Mode1RenderResult Run(uint32_t frameCount);
+};
@@ -32,7 +32,7 @@ struct SpriteInfo
 
 	int16_t DrawX;
 	uint16_t FetchAddress;
-	uint16_t ChrData[2];
+	uint64_t ChrData[2];
 
 	bool IsVisible(uint16_t scanline, bool interlace)
 	{
@@ -51,7 +51,9 @@ struct TileData
 {
 	uint16_t TilemapData;
 	uint16_t VScroll;
-	uint16_t ChrData[4];
+
+	//Each entry holds 2 bitplanes for the tile's row, decoded to 1 byte per pixel (leftmost pixel in the lowest byte)
+	uint64_t ChrData[4];
 };
 
 struct LayerData
@@ -101,8 +103,7 @@ struct WindowConfig
 	uint8_t Left;
 	uint8_t Right;
 
-	template<uint8_t layerIndex>
-	bool PixelNeedsMasking(int x)
+	bool PixelNeedsMasking(uint8_t layerIndex, int x)
 	{
 		if(InvertedLayers[layerIndex]) {
 			if(Left > Right) {
@@ -1,7 +1,6 @@
 #pragma once
 #include "stdafx.h"
-#include <deque>
-#include "BaseControlDevice.h"
+#include "PackedInputLog.h"
 
 class Console;
 
@@ -11,7 +10,7 @@ private:
 	vector<uint8_t> SaveStateData;
 
 public:
-	std::deque<ControlDeviceState> InputLogs[BaseControlDevice::PortCount];
+	PackedInputLog InputLogs;
 	int32_t FrameCount = 0;
 	bool EndOfSegment = false;
 
@@ -4,7 +4,6 @@
 #include "Console.h"
 #include "EmuSettings.h"
 #include "ControlManager.h"
-#include "VideoRenderer.h"
 #include "SoundMixer.h"
 #include "BaseControlDevice.h"
 
@@ -34,10 +33,7 @@ void RewindManager::ClearBuffer()
 	_historyBackup.clear();
 	_currentHistory = RewindData();
 	_framesToFastForward = 0;
-	_videoHistory.clear();
-	_videoHistoryBuilder.clear();
-	_audioHistory.clear();
-	_audioHistoryBuilder.clear();
+	ClearFrameHistory();
 	_rewindState = RewindState::Stopped;
 	_currentHistory = RewindData();
 }
@@ -63,10 +59,10 @@ void RewindManager::ProcessNotification(ConsoleNotificationType type, void * par
 					_currentHistory.FrameCount++;
 					if(_framesToFastForward == 0) {
 						for(int i = 0; i < 4; i++) {
-							size_t numberToRemove = _currentHistory.InputLogs[i].size();
-							_currentHistory.InputLogs[i] = _historyBackup.front().InputLogs[i];
-							for(size_t j = 0; j < numberToRemove; j++) {
-								_currentHistory.InputLogs[i].pop_back();
+							uint32_t numberToRemove = _currentHistory.InputLogs.GetCount(i);
+							_currentHistory.InputLogs.CopyPort(i, _historyBackup.front().InputLogs);
+							for(uint32_t j = 0; j < numberToRemove; j++) {
+								_currentHistory.InputLogs.PopBack(i);
 							}
 						}
 						_historyBackup.clear();
@@ -120,7 +116,10 @@ void RewindManager::PopHistory()
 		_historyBackup.push_front(_currentHistory);
 		_currentHistory.LoadState(_console);
 		if(!_audioHistoryBuilder.empty()) {
-			_audioHistory.insert(_audioHistory.begin(), _audioHistoryBuilder.begin(), _audioHistoryBuilder.end());
+			for(vector<int16_t> &block : _audioHistoryBuilder) {
+				_audioHistorySize += block.size();
+			}
+			_audioHistory.insert(_audioHistory.begin(), std::make_move_iterator(_audioHistoryBuilder.begin()), std::make_move_iterator(_audioHistoryBuilder.end()));
 			_audioHistoryBuilder.clear();
 		}
 	}
@@ -132,10 +131,7 @@ void RewindManager::Start(bool forDebugger)
 		auto lock = _console->AcquireLock();
 
 		_rewindState = forDebugger ? RewindState::Debugging : RewindState::Starting;
-		_videoHistoryBuilder.clear();
-		_videoHistory.clear();
-		_audioHistoryBuilder.clear();
-		_audioHistory.clear();
+		ClearFrameHistory();
 		_historyBackup.clear();
 		
 		PopHistory();
@@ -200,10 +196,7 @@ void RewindManager::Stop()
 			_settings->ClearFlag(EmulationFlags::Rewind);
 		}
 
-		_videoHistoryBuilder.clear();
-		_videoHistory.clear();
-		_audioHistoryBuilder.clear();
-		_audioHistory.clear();
+		ClearFrameHistory();
 	}
 }
 
@@ -220,55 +213,169 @@ void RewindManager::ProcessEndOfFrame()
 	}
 }
 
-void RewindManager::ProcessFrame(void * frameBuffer, uint32_t width, uint32_t height, bool forRewind)
+void RewindManager::ClearFrameHistory()
+{
+	_videoHistoryBuilder.clear();
+	_videoHistory.clear();
+	_hasPendingFrame = false;
+	_audioHistoryBuilder.clear();
+	_audioHistory.clear();
+	_audioHistorySize = 0;
+}
+
+void RewindManager::EncodeVideoFrame(RewindVideoFrame &frame, uint16_t *frameBuffer, uint16_t *nextFrameBuffer)
+{
+	//Stored as a list of [zero count][literal count][literals...] blocks
+	//Consecutive frames are usually almost identical, so XORing them with the next frame leaves mostly zeroes
+	frame.IsKeyFrame = nextFrameBuffer == nullptr;
+	frame.Data.clear();
+
+	uint32_t size = frame.Width * frame.Height;
+	auto getValue = [=](uint32_t i) -> uint16_t {
+		return nextFrameBuffer ? (frameBuffer[i] ^ nextFrameBuffer[i]) : frameBuffer[i];
+	};
+
+	uint32_t i = 0;
+	while(i < size) {
+		uint32_t start = i;
+		while(i < size && i - start < 0xFFFF && getValue(i) == 0) {
+			i++;
+		}
+
+		size_t header = frame.Data.size();
+		frame.Data.push_back((uint16_t)(i - start));
+		frame.Data.push_back(0);
+
+		start = i;
+		while(i < size && i - start < 0xFFFF) {
+			uint16_t value = getValue(i);
+			if(value == 0 && (i + 1 >= size || getValue(i + 1) == 0)) {
+				//Start a new block when at least 2 zeroes follow
+				break;
+			}
+			frame.Data.push_back(value);
+			i++;
+		}
+		frame.Data[header + 1] = (uint16_t)(i - start);
+	}
+}
+
+void RewindManager::DecodeVideoFrame(RewindVideoFrame &frame)
+{
+	//Key frames are decoded as-is, other frames are XORed with the frame that followed them (the last one displayed)
+	uint32_t size = frame.Width * frame.Height;
+	if(frame.IsKeyFrame || _displayFrame.Data.size() != size) {
+		_displayFrame.Data.assign(size, 0);
+	}
+	_displayFrame.Width = frame.Width;
+	_displayFrame.Height = frame.Height;
+	_displayFrame.FrameNumber = frame.FrameNumber;
+
+	uint16_t* out = _displayFrame.Data.data();
+	uint32_t pos = 0;
+	size_t i = 0;
+	while(i + 1 < frame.Data.size()) {
+		pos += frame.Data[i];
+		uint16_t count = frame.Data[i + 1];
+		i += 2;
+		for(uint16_t j = 0; j < count && pos < size; j++) {
+			out[pos++] ^= frame.Data[i++];
+		}
+	}
+}
+
+void RewindManager::AddVideoFrame(uint16_t *frameBuffer, uint32_t width, uint32_t height, uint32_t frameNumber)
+{
+	if(_hasPendingFrame) {
+		//The previous frame can now be stored as a delta against this one
+		RewindVideoFrame frame;
+		frame.Width = _pendingFrame.Width;
+		frame.Height = _pendingFrame.Height;
+		frame.FrameNumber = _pendingFrame.FrameNumber;
+		bool sameSize = frame.Width == width && frame.Height == height;
+		EncodeVideoFrame(frame, _pendingFrame.Data.data(), sameSize ? frameBuffer : nullptr);
+		_videoHistoryBuilder.push_back(std::move(frame));
+	}
+
+	_pendingFrame.Data.assign(frameBuffer, frameBuffer + width * height);
+	_pendingFrame.Width = width;
+	_pendingFrame.Height = height;
+	_pendingFrame.FrameNumber = frameNumber;
+	_hasPendingFrame = true;
+
+	if(_videoHistoryBuilder.size() + 1 == (size_t)_historyBackup.front().FrameCount) {
+		//The block's last frame is stored as a key frame, it is the first one displayed when playing the block backwards
+		RewindVideoFrame frame;
+		frame.Width = width;
+		frame.Height = height;
+		frame.FrameNumber = frameNumber;
+		EncodeVideoFrame(frame, frameBuffer, nullptr);
+		_videoHistoryBuilder.push_back(std::move(frame));
+		_hasPendingFrame = false;
+
+		for(int i = (int)_videoHistoryBuilder.size() - 1; i >= 0; i--) {
+			_videoHistory.push_front(std::move(_videoHistoryBuilder[i]));
+		}
+		_videoHistoryBuilder.clear();
+	}
+}
+
+bool RewindManager::ProcessFrame(uint16_t* &frameBuffer, uint32_t &width, uint32_t &height, uint32_t &frameNumber, bool forRewind)
 {
 	if(_rewindState == RewindState::Starting || _rewindState == RewindState::Started) {
 		if(!forRewind) {
 			//Ignore any frames that occur between start of rewind process & first rewinded frame completed
 			//These are caused by the fact that VideoDecoder is asynchronous - a previous (extra) frame can end up
 			//in the rewind queue, which causes display glitches
-			return;
+			return false;
 		}
 
-		VideoFrame newFrame;
-		newFrame.Data = vector<uint32_t>((uint32_t*)frameBuffer, (uint32_t*)frameBuffer + width * height);
-		newFrame.Width = width;
-		newFrame.Height = height;
-		_videoHistoryBuilder.push_back(newFrame);
-
-		if(_videoHistoryBuilder.size() == (size_t)_historyBackup.front().FrameCount) {
-			for(int i = (int)_videoHistoryBuilder.size() - 1; i >= 0; i--) {
-				_videoHistory.push_front(_videoHistoryBuilder[i]);
-			}
-			_videoHistoryBuilder.clear();
-		}
+		AddVideoFrame(frameBuffer, width, height, frameNumber);
 
 		if(_rewindState == RewindState::Started || _videoHistory.size() >= RewindManager::BufferSize) {
 			_rewindState = RewindState::Started;
 			_settings->ClearFlag(EmulationFlags::MaximumSpeed);
 			if(!_videoHistory.empty()) {
-				VideoFrame &frameData = _videoHistory.back();
-				_console->GetVideoRenderer()->UpdateFrame(frameData.Data.data(), frameData.Width, frameData.Height);
+				//Replace the current frame with the previous frame in the history, the video filter is applied to it by the decoder
+				DecodeVideoFrame(_videoHistory.back());
 				_videoHistory.pop_back();
+
+				frameBuffer = _displayFrame.Data.data();
+				width = _displayFrame.Width;
+				height = _displayFrame.Height;
+				frameNumber = _displayFrame.FrameNumber;
+				return true;
 			}
 		}
+		return false;
 	} else if(_rewindState == RewindState::Stopping || _rewindState == RewindState::Debugging) {
 		//Display nothing while resyncing
+		return false;
 	} else {
-		_console->GetVideoRenderer()->UpdateFrame(frameBuffer, width, height);
+		return true;
 	}
 }
 
 bool RewindManager::ProcessAudio(int16_t * soundBuffer, uint32_t sampleCount)
 {
 	if(_rewindState == RewindState::Starting || _rewindState == RewindState::Started) {
-		_audioHistoryBuilder.insert(_audioHistoryBuilder.end(), soundBuffer, soundBuffer + sampleCount * 2);
-
-		if(_rewindState == RewindState::Started && _audioHistory.size() > sampleCount * 2) {
-			for(uint32_t i = 0; i < sampleCount * 2; i++) {
-				soundBuffer[i] = _audioHistory.back();
-				_audioHistory.pop_back();
+		_audioHistoryBuilder.push_back(vector<int16_t>(soundBuffer, soundBuffer + sampleCount * 2));
+
+		if(_rewindState == RewindState::Started && _audioHistorySize > sampleCount * 2) {
+			//Play the history backwards, starting from the end of the last block
+			uint32_t pos = 0;
+			while(pos < sampleCount * 2 && !_audioHistory.empty()) {
+				vector<int16_t> &block = _audioHistory.back();
+				size_t count = std::min<size_t>(sampleCount * 2 - pos, block.size());
+				std::reverse_copy(block.end() - count, block.end(), soundBuffer + pos);
+				block.resize(block.size() - count);
+				pos += (uint32_t)count;
+				if(block.empty()) {
+					_audioHistory.pop_back();
+				}
 			}
+			_audioHistorySize -= pos;
+			std::fill(soundBuffer + pos, soundBuffer + sampleCount * 2, 0);
 
 			return true;
 		} else {
@@ -286,8 +393,10 @@ bool RewindManager::ProcessAudio(int16_t * soundBuffer, uint32_t sampleCount)
 void RewindManager::RecordInput(vector<shared_ptr<BaseControlDevice>> devices)
 {
 	if(_settings->GetRewindBufferSize() > 0 && _rewindState == RewindState::Stopped) {
+		PackedControlState state;
 		for(shared_ptr<BaseControlDevice> &device : devices) {
-			_currentHistory.InputLogs[device->GetPort()].push_back(device->GetRawState());
+			device->GetRawState(state);
+			_currentHistory.InputLogs.PushBack(device->GetPort(), state);
 		}
 	}
 }
@@ -295,9 +404,8 @@ void RewindManager::RecordInput(vector<shared_ptr<BaseControlDevice>> devices)
 bool RewindManager::SetInput(BaseControlDevice *device)
 {
 	uint8_t port = device->GetPort();
-	if(!_currentHistory.InputLogs[port].empty() && IsRewinding()) {
-		ControlDeviceState state = _currentHistory.InputLogs[port].front();
-		_currentHistory.InputLogs[port].pop_front();
+	PackedControlState state;
+	if(IsRewinding() && _currentHistory.InputLogs.PopFront(port, state)) {
 		device->SetRawState(state);
 		return true;
 	} else {
@@ -352,9 +460,9 @@ bool RewindManager::HasHistory()
 	return _hasHistory;
 }
 
-void RewindManager::SendFrame(void * frameBuffer, uint32_t width, uint32_t height, bool forRewind)
+bool RewindManager::SendFrame(uint16_t* &frameBuffer, uint32_t &width, uint32_t &height, uint32_t &frameNumber, bool forRewind)
 {
-	ProcessFrame(frameBuffer, width, height, forRewind);
+	return ProcessFrame(frameBuffer, width, height, frameNumber, forRewind);
 }
 
 bool RewindManager::SendAudio(int16_t * soundBuffer, uint32_t sampleCount)
@@ -18,11 +18,14 @@ enum class RewindState
 	Debugging = 4
 };
 
-struct VideoFrame
+struct RewindVideoFrame
 {
-	vector<uint32_t> Data;
+	//PPU output (before video filters), zero run-length encoded and XORed with the next frame (unless IsKeyFrame is set)
+	vector<uint16_t> Data;
 	uint32_t Width;
 	uint32_t Height;
+	uint32_t FrameNumber;
+	bool IsKeyFrame;
 };
 
 class RewindManager : public INotificationListener, public IInputProvider, public IInputRecorder
@@ -42,10 +45,15 @@ private:
 	RewindState _rewindState;
 	int32_t _framesToFastForward;
 
-	std::deque<VideoFrame> _videoHistory;
-	vector<VideoFrame> _videoHistoryBuilder;
-	std::deque<int16_t> _audioHistory;
-	vector<int16_t> _audioHistoryBuilder;
+	std::deque<RewindVideoFrame> _videoHistory;
+	vector<RewindVideoFrame> _videoHistoryBuilder;
+	RewindVideoFrame _pendingFrame;
+	bool _hasPendingFrame = false;
+	RewindVideoFrame _displayFrame;
+
+	std::deque<vector<int16_t>> _audioHistory;
+	vector<vector<int16_t>> _audioHistoryBuilder;
+	size_t _audioHistorySize = 0;
 
 	void AddHistoryBlock();
 	void PopHistory();
@@ -54,7 +62,12 @@ private:
 	void Stop();
 	void ForceStop();
 
-	void ProcessFrame(void *frameBuffer, uint32_t width, uint32_t height, bool forRewind);
+	void ClearFrameHistory();
+	void AddVideoFrame(uint16_t *frameBuffer, uint32_t width, uint32_t height, uint32_t frameNumber);
+	void EncodeVideoFrame(RewindVideoFrame &frame, uint16_t *frameBuffer, uint16_t *nextFrameBuffer);
+	void DecodeVideoFrame(RewindVideoFrame &frame);
+
+	bool ProcessFrame(uint16_t* &frameBuffer, uint32_t &width, uint32_t &height, uint32_t &frameNumber, bool forRewind);
 	bool ProcessAudio(int16_t *soundBuffer, uint32_t sampleCount);
 	
 	void ClearBuffer();
@@ -77,6 +90,6 @@ public:
 
 	bool HasHistory();
 
-	void SendFrame(void *frameBuffer, uint32_t width, uint32_t height, bool forRewind);
+	bool SendFrame(uint16_t* &frameBuffer, uint32_t &width, uint32_t &height, uint32_t &frameNumber, bool forRewind);
 	bool SendAudio(int16_t *soundBuffer, uint32_t sampleCount);
 };
\ No newline at end of file
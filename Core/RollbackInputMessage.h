@@ -0,0 +1,51 @@
+#pragma once
+#include "stdafx.h"
+#include "NetMessage.h"
+#include "ControlDeviceState.h"
+
+class RollbackInputMessage : public NetMessage
+{
+private:
+	uint32_t _syncId = 0;
+	uint32_t _frame = 0;
+	uint8_t _portNumber = 0;
+	ControlDeviceState _inputState;
+
+protected:
+	void Serialize(Serializer &s) override
+	{
+		s.Stream(_syncId, _frame, _portNumber);
+		s.StreamVector(_inputState.State);
+	}
+
+public:
+	RollbackInputMessage(void* buffer, uint32_t length) : NetMessage(buffer, length) { }
+
+	RollbackInputMessage(uint32_t syncId, uint32_t frame, uint8_t port, ControlDeviceState &state) : NetMessage(MessageType::RollbackInput)
+	{
+		_syncId = syncId;
+		_frame = frame;
+		_portNumber = port;
+		_inputState = state;
+	}
+
+	uint32_t GetSyncId()
+	{
+		return _syncId;
+	}
+
+	uint32_t GetFrame()
+	{
+		return _frame;
+	}
+
+	uint8_t GetPortNumber()
+	{
+		return _portNumber;
+	}
+
+	ControlDeviceState& GetInputState()
+	{
+		return _inputState;
+	}
+};
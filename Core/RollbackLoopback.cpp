@@ -0,0 +1,112 @@
+#include "stdafx.h"
+#include "RollbackLoopback.h"
+#include "Console.h"
+#include "ControlManager.h"
+#include "NotificationManager.h"
+#include "MessageManager.h"
+
+shared_ptr<RollbackLoopback> RollbackLoopback::_instance;
+SimpleLock RollbackLoopback::_instanceLock;
+
+RollbackLoopback::RollbackLoopback(shared_ptr<Console> console, uint8_t localPort, uint8_t remotePort, uint32_t delayFrames)
+{
+	_console = console;
+	_localPort = localPort;
+	_remotePort = remotePort;
+
+	//Input must arrive before the manager stops predicting, otherwise emulation would stall forever
+	_delayFrames = std::min(delayFrames, RollbackManager::MaxRollbackFrames - 1);
+
+	_rollbackManager.reset(new RollbackManager(console.get(), this));
+	_rollbackManager->SetLocalPorts(1 << _localPort);
+}
+
+RollbackLoopback::~RollbackLoopback()
+{
+	UnregisterInputProvider();
+}
+
+void RollbackLoopback::RegisterInputProvider()
+{
+	shared_ptr<ControlManager> controlManager = _console->GetControlManager();
+	if(controlManager) {
+		controlManager->RegisterInputProvider(_rollbackManager.get());
+	}
+}
+
+void RollbackLoopback::UnregisterInputProvider()
+{
+	shared_ptr<ControlManager> controlManager = _console->GetControlManager();
+	if(controlManager) {
+		controlManager->UnregisterInputProvider(_rollbackManager.get());
+	}
+}
+
+void RollbackLoopback::Start(shared_ptr<Console> console, uint8_t localPort, uint8_t remotePort, uint32_t delayFrames)
+{
+	if(localPort >= BaseControlDevice::PortCount || remotePort >= BaseControlDevice::PortCount || localPort == remotePort) {
+		return;
+	}
+
+	Stop();
+
+	auto lock = _instanceLock.AcquireSafe();
+	_instance.reset(new RollbackLoopback(console, localPort, remotePort, delayFrames));
+
+	console->Lock();
+	_instance->RegisterInputProvider();
+	console->SetRollbackManager(_instance->_rollbackManager);
+	console->Unlock();
+
+	console->GetNotificationManager()->RegisterNotificationListener(_instance);
+	MessageManager::Log("[Netplay] Rollback loopback started (" + std::to_string(_instance->_delayFrames) + " frames of delay)");
+}
+
+void RollbackLoopback::Stop()
+{
+	auto lock = _instanceLock.AcquireSafe();
+	if(_instance) {
+		shared_ptr<Console> console = _instance->_console;
+		RollbackStats stats = _instance->_rollbackManager->GetStats();
+
+		console->Lock();
+		console->SetRollbackManager(nullptr);
+		_instance.reset();
+		console->Unlock();
+
+		MessageManager::Log("[Netplay] Rollback loopback stopped - " + std::to_string(stats.RollbackCount) + " rollbacks, " + std::to_string(stats.ResimulatedFrames) + " frames resimulated (max: " + std::to_string(stats.MaxRollbackLength) + ")");
+	}
+}
+
+void RollbackLoopback::SendRollbackInput(uint32_t syncId, uint32_t frame, uint8_t port, ControlDeviceState &state)
+{
+	if(port != _localPort) {
+		return;
+	}
+
+	_delayedInputs.push_back({ frame, _remotePort, state });
+	while(!_delayedInputs.empty() && _delayedInputs.front().Frame + _delayFrames <= frame) {
+		RollbackInput &input = _delayedInputs.front();
+		_rollbackManager->AddRemoteInput(syncId, input.Frame, input.Port, input.State);
+		_delayedInputs.pop_front();
+	}
+}
+
+void RollbackLoopback::ProcessNotification(ConsoleNotificationType type, void* parameter)
+{
+	switch(type) {
+		case ConsoleNotificationType::GameLoaded:
+			RegisterInputProvider();
+			//fall through
+
+		case ConsoleNotificationType::GameReset:
+		case ConsoleNotificationType::StateLoaded:
+			//Saved states/inputs no longer match the emulation state
+			_delayedInputs.clear();
+			_rollbackManager->Reset(_rollbackManager->GetSyncId() + 1, _rollbackManager->GetFrame());
+			break;
+
+		default:
+			break;
+	}
+}
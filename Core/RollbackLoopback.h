@@ -0,0 +1,38 @@
+#pragma once
+#include "stdafx.h"
+#include <deque>
+#include "INotificationListener.h"
+#include "IRollbackTransport.h"
+#include "RollbackManager.h"
+#include "../Utilities/SimpleLock.h"
+
+class Console;
+
+//Local stand-in for a remote peer: mirrors the local player's input onto another port, delayed by a number of frames
+//Used to exercise rollbacks/resimulation without a network connection
+class RollbackLoopback : public IRollbackTransport, public INotificationListener
+{
+private:
+	static shared_ptr<RollbackLoopback> _instance;
+	static SimpleLock _instanceLock;
+
+	shared_ptr<Console> _console;
+	shared_ptr<RollbackManager> _rollbackManager;
+	uint8_t _localPort;
+	uint8_t _remotePort;
+	uint32_t _delayFrames;
+	std::deque<RollbackInput> _delayedInputs;
+
+	void RegisterInputProvider();
+	void UnregisterInputProvider();
+
+public:
+	RollbackLoopback(shared_ptr<Console> console, uint8_t localPort, uint8_t remotePort, uint32_t delayFrames);
+	virtual ~RollbackLoopback();
+
+	static void Start(shared_ptr<Console> console, uint8_t localPort, uint8_t remotePort, uint32_t delayFrames);
+	static void Stop();
+
+	void SendRollbackInput(uint32_t syncId, uint32_t frame, uint8_t port, ControlDeviceState &state) override;
+	void ProcessNotification(ConsoleNotificationType type, void* parameter) override;
+};
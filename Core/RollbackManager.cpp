@@ -0,0 +1,365 @@
+#include "stdafx.h"
+#include "RollbackManager.h"
+#include "IRollbackTransport.h"
+#include "Console.h"
+#include "EmuSettings.h"
+#include "MessageManager.h"
+#include "SaveStateManager.h"
+
+RollbackManager::RollbackManager(Console* console, IRollbackTransport* transport)
+{
+	_console = console;
+	_transport = transport;
+	Reset(0, 0);
+}
+
+void RollbackManager::Reset(uint32_t syncId, uint32_t frame)
+{
+	auto lock = _lock.AcquireSafe();
+
+	_syncId = syncId;
+	_frame = frame;
+	_liveFrame = frame;
+	_rollbackFrame = RollbackManager::NoRollback;
+	_pendingInputs.clear();
+
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		_nextConfirmedFrame[i] = frame;
+		_lastConfirmed[i] = PackedControlState();
+	}
+
+	for(uint32_t i = 0; i < RollbackManager::InputHistorySize; i++) {
+		_inputs[i].Frame = RollbackManager::NoRollback;
+	}
+
+	for(uint32_t i = 0; i < RollbackManager::StateCount; i++) {
+		_states[i].Frame = RollbackManager::NoRollback;
+	}
+}
+
+void RollbackManager::SetLocalPorts(uint8_t portMask)
+{
+	auto lock = _lock.AcquireSafe();
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		if((portMask & (1 << i)) && !(_localPorts & (1 << i))) {
+			//Port was given to this instance, its input is only needed from this frame onward
+			_nextConfirmedFrame[i] = std::max(_nextConfirmedFrame[i], _liveFrame);
+		}
+	}
+	_localPorts = portMask;
+}
+
+uint32_t RollbackManager::GetSyncId()
+{
+	return _syncId;
+}
+
+uint32_t RollbackManager::GetFrame()
+{
+	return _frame;
+}
+
+RollbackStats RollbackManager::GetStats()
+{
+	return _stats;
+}
+
+uint8_t RollbackManager::GetRemotePorts()
+{
+	return _activePorts & ~_localPorts;
+}
+
+RollbackInputFrame& RollbackManager::GetInputFrame(uint32_t frame)
+{
+	RollbackInputFrame &input = _inputs[frame % RollbackManager::InputHistorySize];
+	if(input.Frame != frame) {
+		input.Frame = frame;
+		input.ConfirmedMask = 0;
+		input.UsedMask = 0;
+	}
+	return input;
+}
+
+bool RollbackManager::IsInHistoryRange(uint32_t frame)
+{
+	//Entries are kept for the last MaxRollbackFrames frames, the rest of the history is used for inputs received ahead of time
+	uint32_t oldestFrame = _liveFrame > RollbackManager::MaxRollbackFrames ? _liveFrame - RollbackManager::MaxRollbackFrames : 0;
+	return frame >= oldestFrame && frame - oldestFrame < RollbackManager::InputHistorySize;
+}
+
+void RollbackManager::ConfirmInput(uint32_t frame, uint8_t port, const PackedControlState &state)
+{
+	RollbackInputFrame &input = GetInputFrame(frame);
+	input.Confirmed[port] = state;
+	input.ConfirmedMask |= (1 << port);
+
+	if(frame >= _nextConfirmedFrame[port]) {
+		_nextConfirmedFrame[port] = frame + 1;
+		_lastConfirmed[port] = state;
+	}
+}
+
+void RollbackManager::AddRemoteInput(uint32_t syncId, uint32_t frame, uint8_t port, ControlDeviceState &state)
+{
+	if(port >= BaseControlDevice::PortCount) {
+		return;
+	}
+
+	{
+		auto lock = _lock.AcquireSafe();
+		if(syncId != _syncId) {
+			//Input was sent before the last resync, ignore it
+			return;
+		}
+
+		if(!IsInHistoryRange(frame)) {
+			if(frame >= _liveFrame) {
+				//Received too far ahead, keep it until the history catches up
+				_pendingInputs.push_back({ frame, port, state });
+			} else {
+				MessageManager::Log("[Netplay] Received input for frame " + std::to_string(frame) + " after it could no longer be rolled back.");
+			}
+			return;
+		}
+
+		RollbackInputFrame &input = GetInputFrame(frame);
+		if(input.ConfirmedMask & (1 << port)) {
+			//First confirmation wins (e.g port changed hands and this instance already confirmed the frame)
+			return;
+		}
+
+		ConfirmInput(frame, port, state);
+
+		if(frame < _liveFrame && (input.UsedMask & (1 << port))) {
+			//Frame was already emulated with a predicted input, it will be checked on the next frame
+			_rollbackFrame = std::min(_rollbackFrame, frame);
+		}
+	}
+
+	_waitForInput.Signal();
+}
+
+void RollbackManager::GetSyncState(vector<uint8_t> &stateData, uint32_t &frame, vector<RollbackInput> &inputs)
+{
+	//Must be called while the emulation is paused (console lock)
+	auto lock = _lock.AcquireSafe();
+
+	//The state sent to a new peer must not depend on any prediction - use the newest frame for which all previous inputs are known
+	uint32_t syncFrame = std::min(_liveFrame, _rollbackFrame);
+	uint8_t remotePorts = GetRemotePorts();
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		if(remotePorts & (1 << i)) {
+			syncFrame = std::min(syncFrame, _nextConfirmedFrame[i]);
+		}
+	}
+
+	RollbackState &state = _states[syncFrame % RollbackManager::StateCount];
+	if(syncFrame < _liveFrame && state.Frame == syncFrame) {
+		stateData.assign(state.Data.begin(), state.Data.begin() + state.Size);
+	} else {
+		syncFrame = _liveFrame;
+		stringstream ss;
+		_console->Serialize(ss);
+		string data = ss.str();
+		stateData.assign(data.begin(), data.end());
+	}
+	frame = syncFrame;
+
+	for(uint32_t i = syncFrame; IsInHistoryRange(i); i++) {
+		RollbackInputFrame &input = _inputs[i % RollbackManager::InputHistorySize];
+		if(input.Frame != i) {
+			continue;
+		}
+		for(int port = 0; port < BaseControlDevice::PortCount; port++) {
+			if(input.ConfirmedMask & (1 << port)) {
+				ControlDeviceState state;
+				input.Confirmed[port].Unpack(state);
+				inputs.push_back({ i, (uint8_t)port, state });
+			}
+		}
+	}
+
+	for(RollbackInput &input : _pendingInputs) {
+		inputs.push_back(input);
+	}
+}
+
+bool RollbackManager::CanRunFrame()
+{
+	auto lock = _lock.AcquireSafe();
+
+	//Never predict further ahead than the number of frames that can be rolled back
+	uint8_t remotePorts = GetRemotePorts();
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		if((remotePorts & (1 << i)) && _liveFrame >= _nextConfirmedFrame[i] + RollbackManager::MaxRollbackFrames) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void RollbackManager::WaitForInput()
+{
+	_stats.StallCount++;
+	_waitForInput.Wait(5);
+}
+
+uint32_t RollbackManager::FindMispredictedFrame()
+{
+	for(uint32_t frame = _rollbackFrame; frame < _liveFrame; frame++) {
+		RollbackInputFrame &input = _inputs[frame % RollbackManager::InputHistorySize];
+		if(input.Frame != frame) {
+			continue;
+		}
+
+		uint8_t checkMask = input.ConfirmedMask & input.UsedMask;
+		for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+			if((checkMask & (1 << i)) && input.Used[i] != input.Confirmed[i]) {
+				return frame;
+			}
+		}
+	}
+	return RollbackManager::NoRollback;
+}
+
+bool RollbackManager::Rollback()
+{
+	uint32_t rollbackFrame;
+	{
+		auto lock = _lock.AcquireSafe();
+		if(_rollbackFrame == RollbackManager::NoRollback) {
+			return false;
+		}
+
+		rollbackFrame = FindMispredictedFrame();
+		_rollbackFrame = RollbackManager::NoRollback;
+		if(rollbackFrame == RollbackManager::NoRollback) {
+			//All predictions were correct
+			return false;
+		}
+	}
+
+	RollbackState &state = _states[rollbackFrame % RollbackManager::StateCount];
+	if(state.Frame != rollbackFrame) {
+		MessageManager::Log("[Netplay] Unable to roll back to frame " + std::to_string(rollbackFrame) + ", emulation may be out of sync.");
+		return false;
+	}
+
+	_console->Deserialize(state.Data.data(), state.Size, SaveStateManager::FileFormatVersion, false);
+
+	uint32_t length = _liveFrame - rollbackFrame;
+	_stats.RollbackCount++;
+	_stats.ResimulatedFrames += length;
+	_stats.MaxRollbackLength = std::max(_stats.MaxRollbackLength, length);
+
+	_frame = rollbackFrame;
+	return true;
+}
+
+bool RollbackManager::IsResimulating()
+{
+	return _frame < _liveFrame;
+}
+
+void RollbackManager::SaveState()
+{
+	//Saves the state at the start of the frame that will poll input #_frame
+	RollbackState &state = _states[_frame % RollbackManager::StateCount];
+	if(state.Data.empty()) {
+		state.Data.resize(0x80000);
+	}
+
+	state.Frame = _frame;
+	while((state.Size = _console->Serialize(state.Data.data(), (uint32_t)state.Data.size())) == 0) {
+		state.Data.resize(state.Data.size() * 2);
+	}
+}
+
+void RollbackManager::ProcessEndOfFrame()
+{
+	bool catchUp = false;
+	{
+		auto lock = _lock.AcquireSafe();
+		_frame++;
+		if(_frame <= _liveFrame) {
+			return;
+		}
+
+		_liveFrame = _frame;
+
+		//Inputs received too far ahead of time can now be moved into the history
+		while(!_pendingInputs.empty() && IsInHistoryRange(_pendingInputs.front().Frame)) {
+			RollbackInput &pending = _pendingInputs.front();
+			if(!(GetInputFrame(pending.Frame).ConfirmedMask & (1 << pending.Port))) {
+				ConfirmInput(pending.Frame, pending.Port, pending.State);
+			}
+			_pendingInputs.pop_front();
+		}
+
+		//Run at maximum speed while all remote players are ahead of us
+		uint8_t remotePorts = GetRemotePorts();
+		if(remotePorts) {
+			catchUp = true;
+			for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+				if((remotePorts & (1 << i)) && _nextConfirmedFrame[i] <= _liveFrame + 2) {
+					catchUp = false;
+					break;
+				}
+			}
+		}
+	}
+
+	if(catchUp != _catchingUp) {
+		_catchingUp = catchUp;
+		if(catchUp) {
+			_console->GetSettings()->SetFlag(EmulationFlags::MaximumSpeed);
+		} else {
+			_console->GetSettings()->ClearFlag(EmulationFlags::MaximumSpeed);
+		}
+	}
+}
+
+bool RollbackManager::SetInput(BaseControlDevice *device)
+{
+	uint8_t port = device->GetPort();
+	if(port >= BaseControlDevice::PortCount) {
+		return false;
+	}
+
+	uint8_t portMask = 1 << port;
+	bool sendInput = false;
+	ControlDeviceState localState;
+	PackedControlState state;
+	{
+		auto lock = _lock.AcquireSafe();
+		_activePorts |= portMask;
+
+		RollbackInputFrame &input = GetInputFrame(_frame);
+		if(input.ConfirmedMask & portMask) {
+			state = input.Confirmed[port];
+		} else if(_localPorts & portMask) {
+			if(_frame < _liveFrame && (input.UsedMask & portMask)) {
+				//Port became local after this frame was emulated, keep the input that was used back then
+				input.Used[port].Unpack(localState);
+			} else if(!_transport->GetLocalInput(port, localState)) {
+				localState = device->GetRawState();
+			}
+			state = localState;
+			ConfirmInput(_frame, port, state);
+			sendInput = true;
+		} else {
+			//Predict that the remote player is still pressing the same buttons
+			state = _lastConfirmed[port];
+		}
+
+		input.Used[port] = state;
+		input.UsedMask |= portMask;
+	}
+
+	device->SetRawState(state);
+
+	if(sendInput) {
+		_transport->SendRollbackInput(_syncId, _frame, port, localState);
+	}
+	return true;
+}
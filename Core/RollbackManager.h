@@ -0,0 +1,103 @@
+#pragma once
+#include "stdafx.h"
+#include "IInputProvider.h"
+#include "BaseControlDevice.h"
+#include "ControlDeviceState.h"
+#include "../Utilities/SimpleLock.h"
+#include "../Utilities/AutoResetEvent.h"
+
+class Console;
+class IRollbackTransport;
+
+struct RollbackInput
+{
+	uint32_t Frame;
+	uint8_t Port;
+	ControlDeviceState State;
+};
+
+struct RollbackInputFrame
+{
+	uint32_t Frame = 0;
+	uint8_t ConfirmedMask = 0;
+	uint8_t UsedMask = 0;
+	PackedControlState Confirmed[BaseControlDevice::PortCount];
+	PackedControlState Used[BaseControlDevice::PortCount];
+};
+
+struct RollbackState
+{
+	uint32_t Frame = 0;
+	uint32_t Size = 0;
+	vector<uint8_t> Data;
+};
+
+struct RollbackStats
+{
+	uint32_t RollbackCount;
+	uint32_t ResimulatedFrames;
+	uint32_t MaxRollbackLength;
+	uint32_t StallCount;
+};
+
+class RollbackManager : public IInputProvider
+{
+public:
+	static constexpr uint32_t MaxRollbackFrames = 12;
+	static constexpr uint32_t InputHistorySize = 64;
+
+private:
+	static constexpr uint32_t StateCount = RollbackManager::MaxRollbackFrames + 1;
+	static constexpr uint32_t NoRollback = 0xFFFFFFFF;
+
+	Console* _console;
+	IRollbackTransport* _transport;
+
+	SimpleLock _lock;
+	AutoResetEvent _waitForInput;
+
+	uint32_t _syncId = 0;
+	uint32_t _frame = 0;
+	uint32_t _liveFrame = 0;
+	uint32_t _rollbackFrame = RollbackManager::NoRollback;
+	uint8_t _localPorts = 0;
+	uint8_t _activePorts = 0;
+	bool _catchingUp = false;
+
+	uint32_t _nextConfirmedFrame[BaseControlDevice::PortCount] = {};
+	PackedControlState _lastConfirmed[BaseControlDevice::PortCount];
+
+	RollbackInputFrame _inputs[RollbackManager::InputHistorySize];
+	deque<RollbackInput> _pendingInputs;
+	RollbackState _states[RollbackManager::StateCount];
+
+	RollbackStats _stats = {};
+
+	RollbackInputFrame& GetInputFrame(uint32_t frame);
+	bool IsInHistoryRange(uint32_t frame);
+	void ConfirmInput(uint32_t frame, uint8_t port, const PackedControlState &state);
+	uint32_t FindMispredictedFrame();
+	uint8_t GetRemotePorts();
+
+public:
+	RollbackManager(Console* console, IRollbackTransport* transport);
+
+	void Reset(uint32_t syncId, uint32_t frame);
+	void SetLocalPorts(uint8_t portMask);
+
+	uint32_t GetSyncId();
+	uint32_t GetFrame();
+	RollbackStats GetStats();
+
+	void AddRemoteInput(uint32_t syncId, uint32_t frame, uint8_t port, ControlDeviceState &state);
+	void GetSyncState(vector<uint8_t> &stateData, uint32_t &frame, vector<RollbackInput> &inputs);
+
+	bool CanRunFrame();
+	void WaitForInput();
+	bool Rollback();
+	bool IsResimulating();
+	void SaveState();
+	void ProcessEndOfFrame();
+
+	bool SetInput(BaseControlDevice *device) override;
+};
@@ -4,6 +4,7 @@
 #include "BaseCartridge.h"
 #include "../Utilities/VirtualFile.h"
 #include "../Utilities/FolderUtilities.h"
+#include "../Utilities/RomHashIndex.h"
 
 class RomFinder
 {
@@ -29,21 +30,34 @@ public:
 			return console->GetRomInfo().RomFile;
 		}
 
-		string lcRomname = romName;
-		std::transform(lcRomname.begin(), lcRomname.end(), lcRomname.begin(), ::tolower);
+		string match = RomHashIndex::FindRom(sha1Hash);
+		if(!match.empty()) {
+			return match;
+		}
+
 		std::transform(romName.begin(), romName.end(), romName.begin(), ::tolower);
 
 		vector<string> romFiles;
+		vector<string> nameMatches;
 		for(string folder : FolderUtilities::GetKnownGameFolders()) {
 			for(string romFilename : FolderUtilities::GetFilesInFolder(folder, VirtualFile::RomExtensions, true)) {
 				string lcRomFile = romFilename;
 				std::transform(lcRomFile.begin(), lcRomFile.end(), lcRomFile.begin(), ::tolower);
-				if(FolderUtilities::GetFilename(romName, false) == FolderUtilities::GetFilename(lcRomFile, false) && VirtualFile(romFilename).GetSha1Hash() == sha1Hash) {
-					return romFilename;
+				if(FolderUtilities::GetFilename(romName, false) == FolderUtilities::GetFilename(lcRomFile, false)) {
+					nameMatches.push_back(romFilename);
 				}
+				romFiles.push_back(romFilename);
 			}
 		}
 
-		return "";
+		//Files with the same name are the most likely matches, index them first
+		RomHashIndex::Update(nameMatches);
+		match = RomHashIndex::FindRom(sha1Hash);
+		if(match.empty()) {
+			//Index the rest of the library (only new/modified files are hashed)
+			RomHashIndex::Update(romFiles);
+			match = RomHashIndex::FindRom(sha1Hash);
+		}
+		return match;
 	}
 };
\ No newline at end of file
@@ -471,7 +471,7 @@ VOICE_CLOCK( V3c )
 	
 	// Gaussian interpolation
 	{
-		int output = _settings->GetAudioConfig().EnableCubicInterpolation ? interpolate_cubic(v) : interpolate( v );
+		int output = _cubicInterpolation ? interpolate_cubic(v) : interpolate( v );
 		
 		// Noise
 		if ( m.t_non & v->vbit )
@@ -812,15 +812,22 @@ PHASE(31)  V(V4,0)       V(V1,2)\
 
 #if !SPC_DSP_CUSTOM_RUN
 
-void SPC_DSP::run()
+void SPC_DSP::run( int clocks_remain )
 {
+	require( clocks_remain > 0 );
+	
 	int const phase = m.phase;
-	m.phase = (phase + 1) & 31;
-	switch (phase)
+	m.phase = (phase + clocks_remain) & 31;
+	switch ( phase )
 	{
-		#define PHASE( n ) if ( n ) break; case n:
+	loop:
+	
+		#define PHASE( n ) if ( n && !--clocks_remain ) break; case n:
 		GEN_DSP_TIMING
 		#undef PHASE
+	
+		if ( --clocks_remain )
+			goto loop;
 	}
 }
 
@@ -836,6 +843,7 @@ void SPC_DSP::init( Spc *spc, EmuSettings *settings, void* ram_64k )
 {
 	_spc = spc;
 	_settings = settings;
+	updateSettings();
 	m.ram = (uint8_t*) ram_64k;
 	mute_voices( 0 );
 	disable_surround( false );
@@ -858,6 +866,11 @@ void SPC_DSP::init( Spc *spc, EmuSettings *settings, void* ram_64k )
 	#endif
 }
 
+void SPC_DSP::updateSettings()
+{
+	_cubicInterpolation = _settings->GetAudioConfig().EnableCubicInterpolation;
+}
+
 void SPC_DSP::soft_reset_common()
 {
 	require( m.ram ); // init() must have been called already
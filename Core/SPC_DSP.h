@@ -43,9 +43,14 @@ public:
 
 	// Runs DSP for specified number of clocks (~1024000 per second). Every 32 clocks
 	// a pair of samples is be generated.
-	void run();
+	void run( int clock_count );
 	
 	bool isMuted() { return (m.regs[r_flg] & 0x40) != 0; }
+	bool isEchoWriteEnabled() { return !(m.regs[r_flg] & 0x20) || !(m.t_echo_enabled & 0x20); }
+	bool isEchoWriteTarget(uint16_t addr);
+
+	// Reads the emulator settings the DSP uses (called once per frame, not for every sample)
+	void updateSettings();
 	void copyRegs(uint8_t* output) { memcpy(output, m.regs, register_count); }
 	uint8_t readRam(uint16_t addr);
 	void writeRam(uint16_t addr, uint8_t value);
@@ -193,6 +198,7 @@ private:
 	state_t m;
 	Spc* _spc;
 	EmuSettings* _settings;
+	bool _cubicInterpolation;
 	
 	void init_counter();
 	void run_counters();
@@ -281,6 +287,21 @@ inline void SPC_DSP::write( int addr, int data )
 
 inline void SPC_DSP::mute_voices( int mask ) { m.mute_mask = mask; }
 
+// True if the echo buffer writes done by the next clocks (until a register is written) can modify this address
+inline bool SPC_DSP::isEchoWriteTarget( uint16_t addr )
+{
+	if ( !isEchoWriteEnabled() )
+		return false;
+	
+	// ESA and EDL are latched at different points of the sample, check both the current and the latched values
+	int length = (m.regs [r_edl] & 0x0F) * 0x800;
+	if ( length < m.echo_length )
+		length = m.echo_length;
+	if ( length < 4 )
+		length = 4;
+	return (uint16_t) (addr - m.t_esa * 0x100) < length || (uint16_t) (addr - m.regs [r_esa] * 0x100) < length;
+}
+
 inline bool SPC_DSP::check_kon()
 {
 	bool old = m.kon_check;
@@ -28,7 +28,7 @@ void Sa1Cpu::Exec()
 	_immediateMode = false;
 
 	switch(_state.StopState) {
-		case CpuStopState::Running: RunOp(); break;
+		case CpuStopState::Running: (this->*_runOp)(); break;
 		case CpuStopState::Stopped:
 			//STP was executed, CPU no longer executes any code
 			_state.CycleCount++;
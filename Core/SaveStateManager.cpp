@@ -15,11 +15,181 @@
 #include "GameClient.h"
 #include "Ppu.h"
 #include "DefaultVideoFilter.h"
+#include "NotificationManager.h"
 
 SaveStateManager::SaveStateManager(shared_ptr<Console> console)
 {
 	_console = console;
 	_lastIndex = 1;
+	_stopFlag = false;
+	_pendingSaveCount = 0;
+	_cacheGeneration = 0;
+}
+
+SaveStateManager::~SaveStateManager()
+{
+	StopThread();
+}
+
+void SaveStateManager::StartThread()
+{
+	if(!_saveThread) {
+		_stopFlag = false;
+		_saveThread.reset(new thread(&SaveStateManager::SaveThread, this));
+	}
+}
+
+void SaveStateManager::StopThread()
+{
+	if(_saveThread) {
+		//Any state that is still queued is written before the thread exits
+		_stopFlag = true;
+		_waitForWork.Signal();
+		_saveThread->join();
+		_saveThread.reset();
+	}
+
+	auto lock = _cacheLock.AcquireSafe();
+	_stateCache.clear();
+}
+
+void SaveStateManager::SaveThread()
+{
+	while(!_stopFlag) {
+		_waitForWork.Wait();
+
+		while(true) {
+			unique_ptr<PendingSaveState> state;
+			string prefetchPath;
+			{
+				auto lock = _queueLock.AcquireSafe();
+				if(!_saveQueue.empty()) {
+					state = std::move(_saveQueue.front());
+					_saveQueue.pop_front();
+				} else if(!_prefetchQueue.empty()) {
+					prefetchPath = _prefetchQueue.front();
+					_prefetchQueue.pop_front();
+				} else {
+					break;
+				}
+			}
+
+			if(state) {
+				ProcessPendingSave(*state);
+				_pendingSaveCount--;
+				_saveCompleted.Signal();
+			} else {
+				ProcessPrefetch(prefetchPath);
+			}
+		}
+	}
+}
+
+void SaveStateManager::ProcessPendingSave(PendingSaveState& state)
+{
+	//Compression and file I/O are done here, outside of the console lock
+	stringstream stream;
+	WriteHeaderStart(stream, state.IsGameboyMode);
+	#ifndef LIBRETRO
+	WriteScreenshotData(stream, state.ScreenBuffer.data(), state.Width, state.Height);
+	#endif
+	WriteRomName(stream, state.RomName);
+	stream << state.StateData.rdbuf();
+
+	shared_ptr<string> data(new string(stream.str()));
+
+	ofstream file(state.Filepath, ios::out | ios::binary);
+	if(file) {
+		file.write(data->c_str(), data->size());
+		file.close();
+
+		//Keep the data around, loading this slot again won't need to read the file
+		SetCachedState(state.Filepath, data);
+
+		shared_ptr<Debugger> debugger = _console->GetDebugger(false);
+		if(debugger) {
+			debugger->ProcessEvent(EventType::StateSaved);
+		}
+
+		if(state.DisplayMessage) {
+			MessageManager::DisplayMessage("SaveStates", "SaveStateSaved", std::to_string(state.StateIndex));
+		}
+
+		shared_ptr<NotificationManager> notificationManager = _console->GetNotificationManager();
+		if(notificationManager) {
+			notificationManager->SendNotification(ConsoleNotificationType::StateSaved, (void*)(intptr_t)state.StateIndex);
+		}
+	}
+}
+
+void SaveStateManager::ProcessPrefetch(string filepath)
+{
+	uint32_t generation;
+	{
+		auto lock = _cacheLock.AcquireSafe();
+		if(_stateCache.find(filepath) != _stateCache.end()) {
+			return;
+		}
+		generation = _cacheGeneration;
+	}
+
+	ifstream file(filepath, ios::in | ios::binary);
+	if(file) {
+		stringstream stream;
+		stream << file.rdbuf();
+
+		//If a state was saved while the file was being read, the data may be older than the file, drop it
+		auto lock = _cacheLock.AcquireSafe();
+		if(generation == _cacheGeneration) {
+			SetCachedState(filepath, shared_ptr<string>(new string(stream.str())));
+		}
+	}
+}
+
+shared_ptr<string> SaveStateManager::GetCachedState(string filepath)
+{
+	auto lock = _cacheLock.AcquireSafe();
+	auto result = _stateCache.find(filepath);
+	if(result != _stateCache.end()) {
+		return result->second;
+	}
+	return nullptr;
+}
+
+void SaveStateManager::SetCachedState(string filepath, shared_ptr<string> data)
+{
+	auto lock = _cacheLock.AcquireSafe();
+	_cacheGeneration++;
+	if(data) {
+		if(_stateCache.size() > SaveStateManager::MaxIndex) {
+			//Only slots for the current game are meant to be cached
+			_stateCache.clear();
+		}
+		_stateCache[filepath] = data;
+	} else {
+		_stateCache.erase(filepath);
+	}
+}
+
+void SaveStateManager::WaitForPendingSaves()
+{
+	while(_pendingSaveCount > 0) {
+		_saveCompleted.Wait(50);
+	}
+}
+
+void SaveStateManager::PrefetchState(int stateIndex)
+{
+	if(!_console->GetCartridge()) {
+		return;
+	}
+
+	StartThread();
+	{
+		auto lock = _queueLock.AcquireSafe();
+		_prefetchQueue.push_back(GetStateFilepath(stateIndex));
+	}
+	_waitForWork.Signal();
 }
 
 string SaveStateManager::GetStateFilepath(int stateIndex)
@@ -34,18 +204,21 @@ void SaveStateManager::SelectSaveSlot(int slotIndex)
 {
 	_lastIndex = slotIndex;
 	MessageManager::DisplayMessage("SaveStates", "SaveStateSlotSelected", std::to_string(_lastIndex));
+	PrefetchState(_lastIndex);
 }
 
 void SaveStateManager::MoveToNextSlot()
 {
 	_lastIndex = (_lastIndex % MaxIndex) + 1;
 	MessageManager::DisplayMessage("SaveStates", "SaveStateSlotSelected", std::to_string(_lastIndex));
+	PrefetchState(_lastIndex);
 }
 
 void SaveStateManager::MoveToPreviousSlot()
 {
 	_lastIndex = (_lastIndex == 1 ? SaveStateManager::MaxIndex : (_lastIndex - 1));
 	MessageManager::DisplayMessage("SaveStates", "SaveStateSlotSelected", std::to_string(_lastIndex));
+	PrefetchState(_lastIndex);
 }
 
 void SaveStateManager::SaveState()
@@ -59,6 +232,18 @@ bool SaveStateManager::LoadState()
 }
 
 void SaveStateManager::GetSaveStateHeader(ostream &stream)
+{
+	WriteHeaderStart(stream, _console->GetSettings()->CheckFlag(EmulationFlags::GameboyMode));
+
+	#ifndef LIBRETRO
+	SaveScreenshotData(stream);
+	#endif
+
+	RomInfo romInfo = _console->GetCartridge()->GetRomInfo();
+	WriteRomName(stream, FolderUtilities::GetFilename(romInfo.RomFile.GetFileName(), true));
+}
+
+void SaveStateManager::WriteHeaderStart(ostream &stream, bool isGameboyMode)
 {
 	uint32_t emuVersion = _console->GetSettings()->GetVersion();
 	uint32_t formatVersion = SaveStateManager::FileFormatVersion;
@@ -72,15 +257,11 @@ void SaveStateManager::GetSaveStateHeader(ostream &stream)
 	string sha1Hash(40, 'X'); // Fill a dummy pattern to keep save compatibilities
 	stream.write(sha1Hash.c_str(), sha1Hash.size());
 
-	bool isGameboyMode = _console->GetSettings()->CheckFlag(EmulationFlags::GameboyMode);
 	stream.write((char*)&isGameboyMode, sizeof(bool));
+}
 
-	#ifndef LIBRETRO
-	SaveScreenshotData(stream);
-	#endif
-
-	RomInfo romInfo = _console->GetCartridge()->GetRomInfo();
-	string romName = FolderUtilities::GetFilename(romInfo.RomFile.GetFileName(), true);
+void SaveStateManager::WriteRomName(ostream &stream, string romName)
+{
 	uint32_t nameLength = (uint32_t)romName.size();
 	stream.write((char*)&nameLength, sizeof(uint32_t));
 	stream.write(romName.c_str(), romName.size());
@@ -102,6 +283,8 @@ bool SaveStateManager::SaveState(string filepath)
 		_console->Unlock();
 		file.close();
 
+		SetCachedState(filepath, nullptr);
+
 		shared_ptr<Debugger> debugger = _console->GetDebugger(false);
 		if(debugger) {
 			debugger->ProcessEvent(EventType::StateSaved);
@@ -113,12 +296,41 @@ bool SaveStateManager::SaveState(string filepath)
 
 void SaveStateManager::SaveState(int stateIndex, bool displayMessage)
 {
-	string filepath = SaveStateManager::GetStateFilepath(stateIndex);
-	if(SaveState(filepath)) {
-		if(displayMessage) {
-			MessageManager::DisplayMessage("SaveStates", "SaveStateSaved", std::to_string(stateIndex));
-		}
+	SaveStateAsync(SaveStateManager::GetStateFilepath(stateIndex), stateIndex, displayMessage);
+}
+
+void SaveStateManager::SaveStateAsync(string filepath, int stateIndex, bool displayMessage)
+{
+	unique_ptr<PendingSaveState> state(new PendingSaveState());
+	state->Filepath = filepath;
+	state->StateIndex = stateIndex;
+	state->DisplayMessage = displayMessage;
+	state->Width = 0;
+	state->Height = 0;
+
+	//Only take a raw snapshot of the state while the emulation is paused
+	_console->Lock();
+	state->IsGameboyMode = _console->GetSettings()->CheckFlag(EmulationFlags::GameboyMode);
+	state->RomName = FolderUtilities::GetFilename(_console->GetCartridge()->GetRomInfo().RomFile.GetFileName(), true);
+
+	#ifndef LIBRETRO
+	bool isHighRes = _console->GetPpu()->IsHighResOutput();
+	state->Height = isHighRes ? 478 : 239;
+	state->Width = isHighRes ? 512 : 256;
+	uint16_t* screenBuffer = _console->GetPpu()->GetScreenBuffer();
+	state->ScreenBuffer.assign(screenBuffer, screenBuffer + state->Width * state->Height);
+	#endif
+
+	_console->Serialize(state->StateData);
+	_console->Unlock();
+
+	StartThread();
+	_pendingSaveCount++;
+	{
+		auto lock = _queueLock.AcquireSafe();
+		_saveQueue.push_back(std::move(state));
 	}
+	_waitForWork.Signal();
 }
 
 void SaveStateManager::SaveScreenshotData(ostream& stream)
@@ -126,13 +338,17 @@ void SaveStateManager::SaveScreenshotData(ostream& stream)
 	bool isHighRes = _console->GetPpu()->IsHighResOutput();
 	uint32_t height = isHighRes ? 478 : 239;
 	uint32_t width = isHighRes ? 512 : 256;
+	WriteScreenshotData(stream, _console->GetPpu()->GetScreenBuffer(), width, height);
+}
 
+void SaveStateManager::WriteScreenshotData(ostream& stream, uint16_t* screenBuffer, uint32_t width, uint32_t height)
+{
 	stream.write((char*)&width, sizeof(uint32_t));
 	stream.write((char*)&height, sizeof(uint32_t));
 
 	unsigned long compressedSize = compressBound(512*478*2);
 	vector<uint8_t> compressedData(compressedSize, 0);
-	compress2(compressedData.data(), &compressedSize, (const unsigned char*)_console->GetPpu()->GetScreenBuffer(), width*height*2, MZ_DEFAULT_LEVEL);
+	compress2(compressedData.data(), &compressedSize, (const unsigned char*)screenBuffer, width*height*2, MZ_DEFAULT_LEVEL);
 
 	uint32_t screenshotLength = (uint32_t)compressedSize;
 	stream.write((char*)&screenshotLength, sizeof(uint32_t));
@@ -158,12 +374,20 @@ bool SaveStateManager::GetScreenshotData(vector<uint8_t>& out, uint32_t &width,
 	return false;
 }
 
-bool SaveStateManager::LoadState(istream &stream, bool hashCheckRequired)
+bool SaveStateManager::IsLoadStateAllowed()
 {
 	if(GameClient::Connected()) {
 		MessageManager::DisplayMessage("Netplay", "NetplayNotAllowed");
 		return false;
 	}
+	return true;
+}
+
+bool SaveStateManager::LoadState(istream &stream, bool hashCheckRequired)
+{
+	if(!IsLoadStateAllowed()) {
+		return false;
+	}
 
 	char header[3];
 	stream.read(header, 3);
@@ -232,25 +456,48 @@ bool SaveStateManager::LoadState(istream &stream, bool hashCheckRequired)
 	return false;
 }
 
+bool SaveStateManager::LoadState(const uint8_t* data, uint32_t size)
+{
+	//Console state without any header, saved by this version (the caller is expected to validate the header)
+	if(!IsLoadStateAllowed()) {
+		return false;
+	}
+
+	_console->GetMovieManager()->Stop();
+	_console->Deserialize(data, size, SaveStateManager::FileFormatVersion);
+	return true;
+}
+
 bool SaveStateManager::LoadState(string filepath, bool hashCheckRequired)
 {
-	ifstream file(filepath, ios::in | ios::binary);
+	WaitForPendingSaves();
+
 	bool result = false;
+	shared_ptr<string> cachedState = GetCachedState(filepath);
+	if(cachedState) {
+		//State was prefetched (or just saved) by the save thread
+		stringstream stream(*cachedState);
+		_console->Lock();
+		result = LoadState(stream, hashCheckRequired);
+		_console->Unlock();
+	} else {
+		ifstream file(filepath, ios::in | ios::binary);
+		if(!file.good()) {
+			MessageManager::DisplayMessage("SaveStates", "SaveStateEmpty");
+			return false;
+		}
 
-	if(file.good()) {
 		_console->Lock();
 		result = LoadState(file, hashCheckRequired);
 		_console->Unlock();
 		file.close();
+	}
 
-		if(result) {
-			shared_ptr<Debugger> debugger = _console->GetDebugger(false);
-			if(debugger) {
-				debugger->ProcessEvent(EventType::StateLoaded);
-			}
+	if(result) {
+		shared_ptr<Debugger> debugger = _console->GetDebugger(false);
+		if(debugger) {
+			debugger->ProcessEvent(EventType::StateLoaded);
 		}
-	} else {
-		MessageManager::DisplayMessage("SaveStates", "SaveStateEmpty");
 	}
 
 	return result;
@@ -320,6 +567,8 @@ void SaveStateManager::LoadRecentGame(string filename, bool resetGame)
 
 int32_t SaveStateManager::GetSaveStatePreview(string saveStatePath, uint8_t* pngData)
 {
+	WaitForPendingSaves();
+
 	ifstream stream(saveStatePath, ios::binary);
 
 	if(!stream) {
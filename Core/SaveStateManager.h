@@ -1,8 +1,26 @@
 #pragma once
 #include "stdafx.h"
+#include "../Utilities/SimpleLock.h"
+#include "../Utilities/AutoResetEvent.h"
 
 class Console;
 
+struct PendingSaveState
+{
+	string Filepath;
+	int StateIndex;
+	bool DisplayMessage;
+
+	bool IsGameboyMode;
+	string RomName;
+
+	vector<uint16_t> ScreenBuffer;
+	uint32_t Width;
+	uint32_t Height;
+
+	stringstream StateData;
+};
+
 class SaveStateManager
 {
 private:
@@ -11,14 +29,42 @@ private:
 	atomic<uint32_t> _lastIndex;
 	shared_ptr<Console> _console;
 
-	string GetStateFilepath(int stateIndex);	
+	unique_ptr<thread> _saveThread;
+	atomic<bool> _stopFlag;
+	AutoResetEvent _waitForWork;
+	AutoResetEvent _saveCompleted;
+	SimpleLock _queueLock;
+	deque<unique_ptr<PendingSaveState>> _saveQueue;
+	deque<string> _prefetchQueue;
+	atomic<uint32_t> _pendingSaveCount;
+
+	SimpleLock _cacheLock;
+	unordered_map<string, shared_ptr<string>> _stateCache;
+	uint32_t _cacheGeneration;
+
+	string GetStateFilepath(int stateIndex);
+	void WriteHeaderStart(ostream& stream, bool isGameboyMode);
+	void WriteRomName(ostream& stream, string romName);
 	void SaveScreenshotData(ostream& stream);
+	void WriteScreenshotData(ostream& stream, uint16_t* screenBuffer, uint32_t width, uint32_t height);
 	bool GetScreenshotData(vector<uint8_t>& out, uint32_t& width, uint32_t& height, istream& stream);
 
+	void StartThread();
+	void SaveThread();
+	void ProcessPendingSave(PendingSaveState& state);
+	void ProcessPrefetch(string filepath);
+
+	bool IsLoadStateAllowed();
+
+	shared_ptr<string> GetCachedState(string filepath);
+	void SetCachedState(string filepath, shared_ptr<string> data);
+	void WaitForPendingSaves();
+
 public:
 	static constexpr uint32_t FileFormatVersion = 9;
 
 	SaveStateManager(shared_ptr<Console> console);
+	~SaveStateManager();
 
 	void SaveState();
 	bool LoadState();
@@ -28,9 +74,12 @@ public:
 	void SaveState(ostream &stream);
 	bool SaveState(string filepath);
 	void SaveState(int stateIndex, bool displayMessage = true);
+	void SaveStateAsync(string filepath, int stateIndex = -1, bool displayMessage = false);
 	bool LoadState(istream &stream, bool hashCheckRequired = true);
+	bool LoadState(const uint8_t* data, uint32_t size);
 	bool LoadState(string filepath, bool hashCheckRequired = true);
 	bool LoadState(int stateIndex);
+	void PrefetchState(int stateIndex);
 
 	void SaveRecentGame(string romName, string romPath, string patchPath);
 	void LoadRecentGame(string filename, bool resetGame);
@@ -40,4 +89,6 @@ public:
 	void SelectSaveSlot(int slotIndex);
 	void MoveToNextSlot();
 	void MoveToPreviousSlot();
+
+	void StopThread();
 };
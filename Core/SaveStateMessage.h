@@ -17,12 +17,29 @@ private:
 	uint32_t _ppuExtraScanlinesAfterNmi;
 	uint32_t _ppuExtraScanlinesBeforeNmi;
 	uint32_t _gsuClockSpeed;
+	uint32_t _rollbackFrame = 0;
+
+	void InitSettings(shared_ptr<Console> console)
+	{
+		_activeCheats = console->GetCheatManager()->GetCheats();
+
+		EmulationConfig emuCfg = console->GetSettings()->GetEmulationConfig();
+		_region = emuCfg.Region;
+		_ppuExtraScanlinesAfterNmi = emuCfg.PpuExtraScanlinesAfterNmi;
+		_ppuExtraScanlinesBeforeNmi = emuCfg.PpuExtraScanlinesBeforeNmi;
+		_gsuClockSpeed = emuCfg.GsuClockSpeed;
+
+		InputConfig inputCfg = console->GetSettings()->GetInputConfig();
+		for(int i = 0; i < 5; i++) {
+			_controllerTypes[i] = inputCfg.Controllers[i].Type;
+		}
+	}
 
 protected:
 	void Serialize(Serializer &s) override
 	{
 		s.StreamVector(_stateData);
-		s.Stream(_region, _ppuExtraScanlinesAfterNmi, _ppuExtraScanlinesBeforeNmi, _gsuClockSpeed);
+		s.Stream(_region, _ppuExtraScanlinesAfterNmi, _ppuExtraScanlinesBeforeNmi, _gsuClockSpeed, _rollbackFrame);
 		s.StreamArray(_controllerTypes, 5);
 		s.StreamVector(_activeCheats);
 	}
@@ -34,21 +51,9 @@ public:
 	{
 		//Used when sending state to clients
 		console->Lock();
-		_activeCheats = console->GetCheatManager()->GetCheats();
 		stringstream state;
 		console->Serialize(state);
-
-		EmulationConfig emuCfg = console->GetSettings()->GetEmulationConfig();
-		_region = emuCfg.Region;
-		_ppuExtraScanlinesAfterNmi = emuCfg.PpuExtraScanlinesAfterNmi;
-		_ppuExtraScanlinesBeforeNmi = emuCfg.PpuExtraScanlinesBeforeNmi;
-		_gsuClockSpeed = emuCfg.GsuClockSpeed;
-
-		InputConfig inputCfg = console->GetSettings()->GetInputConfig();
-		for(int i = 0; i < 5; i++) {
-			_controllerTypes[i] = inputCfg.Controllers[i].Type;
-		}
-
+		InitSettings(console);
 		console->Unlock();
 
 		uint32_t dataSize = (uint32_t)state.tellp();
@@ -56,6 +61,19 @@ public:
 		state.read((char*)_stateData.data(), dataSize);
 	}
 	
+	SaveStateMessage(shared_ptr<Console> console, vector<uint8_t> &stateData, uint32_t rollbackFrame) : NetMessage(MessageType::SaveState)
+	{
+		//Used when sending a rollback sync point to clients (console must be locked)
+		_stateData = stateData;
+		_rollbackFrame = rollbackFrame;
+		InitSettings(console);
+	}
+
+	uint32_t GetRollbackFrame()
+	{
+		return _rollbackFrame;
+	}
+
 	void LoadState(shared_ptr<Console> console)
 	{
 		std::stringstream ss;
@@ -1,5 +1,8 @@
 #include "stdafx.h"
 #include "ScaleFilter.h"
+#include "PixelKernels.h"
+#include "../Utilities/WorkerPool.h"
+#include "../Utilities/FrameBufferPool.h"
 #include "../Utilities/xBRZ/xbrz.h"
 #include "../Utilities/HQX/hqx.h"
 #include "../Utilities/Scale2x/scalebit.h"
@@ -11,6 +14,7 @@ ScaleFilter::ScaleFilter(ScaleFilterType scaleFilterType, uint32_t scale)
 {
 	_scaleFilterType = scaleFilterType;
 	_filterScale = scale;
+	_framePool.reset(new FrameBufferPool());
 
 	if(!_hqxInitDone && _scaleFilterType == ScaleFilterType::HQX) {
 		hqxInit();
@@ -20,7 +24,6 @@ ScaleFilter::ScaleFilter(ScaleFilterType scaleFilterType, uint32_t scale)
 
 ScaleFilter::~ScaleFilter()
 {
-	delete[] _outputBuffer;
 }
 
 uint32_t ScaleFilter::GetScale()
@@ -28,11 +31,26 @@ uint32_t ScaleFilter::GetScale()
 	return _filterScale;
 }
 
-void ScaleFilter::ApplyPrescaleFilter(uint32_t *inputArgbBuffer)
+void ScaleFilter::SetWorkerPool(WorkerPool* workerPool)
 {
-	uint32_t* outputBuffer = _outputBuffer;
+	_workerPool = workerPool;
+}
+
+void ScaleFilter::ProcessRows(uint32_t rowCount, std::function<void(uint32_t, uint32_t)> task)
+{
+	if(_workerPool) {
+		_workerPool->RunBands(rowCount, 1, task);
+	} else {
+		task(0, rowCount);
+	}
+}
 
-	for(uint32_t y = 0; y < _height; y++) {
+void ScaleFilter::ApplyPrescaleFilter(uint32_t *inputArgbBuffer, uint32_t firstRow, uint32_t lastRow)
+{
+	uint32_t* outputBuffer = _outputBuffer + firstRow * _width * _filterScale * _filterScale;
+	inputArgbBuffer += firstRow * _width;
+
+	for(uint32_t y = firstRow; y < lastRow; y++) {
 		for(uint32_t x = 0; x < _width; x++) {
 			for(uint32_t i = 0; i < _filterScale; i++) {
 				*(outputBuffer++) = *inputArgbBuffer;
@@ -46,23 +64,47 @@ void ScaleFilter::ApplyPrescaleFilter(uint32_t *inputArgbBuffer)
 	}
 }
 
-void ScaleFilter::UpdateOutputBuffer(uint32_t width, uint32_t height)
+void ScaleFilter::ApplyScanlines(uint32_t firstRow, uint32_t lastRow, uint8_t scanlineIntensity)
 {
-	if(!_outputBuffer || width != _width || height != _height) {
-		delete[] _outputBuffer;
-		_width = width;
-		_height = height;
-		_outputBuffer = new uint32_t[_width*_height*_filterScale*_filterScale];
+	//Darkens every odd row of the output for source rows [firstRow, lastRow)
+	uint32_t outputWidth = _width * _filterScale;
+	for(uint32_t y = firstRow * _filterScale | 0x01; y < lastRow * _filterScale; y += 2) {
+		PixelKernels::ApplyScanlines(_outputBuffer + y * outputWidth, outputWidth, scanlineIntensity);
 	}
 }
 
+void ScaleFilter::UpdateOutputBuffer(uint32_t width, uint32_t height)
+{
+	//A new buffer is used for every frame, the previous one may still be used by the renderer or a recorder
+	_width = width;
+	_height = height;
+	_outputFrame = _framePool->GetFrame(_width * _filterScale, _height * _filterScale);
+	_outputBuffer = _outputFrame->GetData();
+}
+
 uint32_t* ScaleFilter::ApplyFilter(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height, double scanlineIntensity)
 {
 	UpdateOutputBuffer(width, height);
 
-	if(_scaleFilterType == ScaleFilterType::xBRZ) {
-		xbrz::scale(_filterScale, inputArgbBuffer, _outputBuffer, width, height, xbrz::ColorFormat::ARGB);
-	} else if(_scaleFilterType == ScaleFilterType::HQX) {
+	uint8_t intensity = (uint8_t)((1.0 - scanlineIntensity) * 255);
+	bool applyScanlines = intensity < 255;
+
+	if(_scaleFilterType == ScaleFilterType::xBRZ || _scaleFilterType == ScaleFilterType::Prescale) {
+		//Both filters can process independent slices of the source image, split the work between the worker threads
+		ProcessRows(height, [&](uint32_t firstRow, uint32_t lastRow) {
+			if(_scaleFilterType == ScaleFilterType::xBRZ) {
+				xbrz::scale(_filterScale, inputArgbBuffer, _outputBuffer, width, height, xbrz::ColorFormat::ARGB, xbrz::ScalerCfg(), firstRow, lastRow);
+			} else {
+				ApplyPrescaleFilter(inputArgbBuffer, firstRow, lastRow);
+			}
+			if(applyScanlines) {
+				ApplyScanlines(firstRow, lastRow, intensity);
+			}
+		});
+		return _outputBuffer;
+	}
+
+	if(_scaleFilterType == ScaleFilterType::HQX) {
 		hqx(_filterScale, inputArgbBuffer, _outputBuffer, width, height);
 	} else if(_scaleFilterType == ScaleFilterType::Scale2x) {
 		scale(_filterScale, _outputBuffer, width*sizeof(uint32_t)*_filterScale, inputArgbBuffer, width*sizeof(uint32_t), 4, width, height);
@@ -72,28 +114,22 @@ uint32_t* ScaleFilter::ApplyFilter(uint32_t *inputArgbBuffer, uint32_t width, ui
 		supertwoxsai_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
 	} else if(_scaleFilterType == ScaleFilterType::SuperEagle) {
 		supereagle_generic_xrgb8888(width, height, inputArgbBuffer, width, _outputBuffer, width * _filterScale);
-	} else if(_scaleFilterType == ScaleFilterType::Prescale) {
-		ApplyPrescaleFilter(inputArgbBuffer);
 	}
 
-	scanlineIntensity = 1.0 - scanlineIntensity;
-
-	if(scanlineIntensity < 1.0) {
-		for(int y = 1, yMax = height * _filterScale; y < yMax; y += 2) {
-			for(int x = 0, xMax = width * _filterScale; x < xMax; x++) {
-				uint32_t &color = _outputBuffer[y*xMax + x];
-				uint8_t r = (color >> 16) & 0xFF, g = (color >> 8) & 0xFF, b = color & 0xFF;
-				r = (uint8_t)(r * scanlineIntensity);
-				g = (uint8_t)(g * scanlineIntensity);
-				b = (uint8_t)(b * scanlineIntensity);
-				color = 0xFF000000 | (r << 16) | (g << 8) | b;
-			}
-		}
+	if(applyScanlines) {
+		ProcessRows(height, [&](uint32_t firstRow, uint32_t lastRow) {
+			ApplyScanlines(firstRow, lastRow, intensity);
+		});
 	}
 
 	return _outputBuffer;
 }
 
+shared_ptr<FrameBuffer> ScaleFilter::GetOutputFrame()
+{
+	return _outputFrame;
+}
+
 shared_ptr<ScaleFilter> ScaleFilter::GetScaleFilter(VideoFilterType filter)
 {
 	shared_ptr<ScaleFilter> scaleFilter;
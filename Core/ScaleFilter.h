@@ -3,25 +3,36 @@
 #include "stdafx.h"
 #include "DefaultVideoFilter.h"
 
+class WorkerPool;
+class FrameBuffer;
+class FrameBufferPool;
+
 class ScaleFilter
 {
 private:
 	static bool _hqxInitDone;
 	uint32_t _filterScale;
 	ScaleFilterType _scaleFilterType;
+	shared_ptr<FrameBufferPool> _framePool;
+	shared_ptr<FrameBuffer> _outputFrame;
 	uint32_t *_outputBuffer = nullptr;
 	uint32_t _width = 0;
 	uint32_t _height = 0;
+	WorkerPool* _workerPool = nullptr;
 
-	void ApplyPrescaleFilter(uint32_t *inputArgbBuffer);
+	void ApplyPrescaleFilter(uint32_t *inputArgbBuffer, uint32_t firstRow, uint32_t lastRow);
+	void ApplyScanlines(uint32_t firstRow, uint32_t lastRow, uint8_t scanlineIntensity);
 	void UpdateOutputBuffer(uint32_t width, uint32_t height);
+	void ProcessRows(uint32_t rowCount, std::function<void(uint32_t, uint32_t)> task);
 
 public:
 	ScaleFilter(ScaleFilterType scaleFilterType, uint32_t scale);
 	~ScaleFilter();
 
 	uint32_t GetScale();
+	void SetWorkerPool(WorkerPool* workerPool);
 	uint32_t* ApplyFilter(uint32_t *inputArgbBuffer, uint32_t width, uint32_t height, double scanlineIntensity);
+	shared_ptr<FrameBuffer> GetOutputFrame();
 	FrameInfo GetFrameInfo(FrameInfo baseFrameInfo);
 
 	static shared_ptr<ScaleFilter> GetScaleFilter(VideoFilterType filter);
@@ -10,6 +10,7 @@ enum class EmulationFlags
 	MaximumSpeed = 0x04,
 	InBackground = 0x08,
 	GameboyMode = 0x10,
+	SkipRendering = 0x20,
 };
 
 enum class ScaleFilterType
@@ -115,6 +116,7 @@ struct AudioConfig
 	const char* AudioDevice = nullptr;
 	bool EnableAudio = true;
 	bool DisableDynamicSampleRate = false;
+	bool SyncToAudioClock = false;
 
 	uint32_t MasterVolume = 100;
 	uint32_t SampleRate = 48000;
@@ -337,6 +339,7 @@ struct PreferencesConfig
 	bool AllowBackgroundInput = false;
 	bool PauseOnMovieEnd = false;
 	bool DisableGameSelectionScreen = false;
+	bool CacheDecompressedRoms = false;
 
 	uint32_t RewindBufferSize = 30;
 
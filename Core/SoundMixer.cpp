@@ -136,6 +136,20 @@ double SoundMixer::GetRateAdjustment()
 	return _resampler->GetRateAdjustment();
 }
 
+double SoundMixer::GetAudioClockAdjustment()
+{
+	//Used when the emulation speed is slaved to the audio device (instead of adjusting the sample rate)
+	AudioConfig cfg = _console->GetSettings()->GetAudioConfig();
+	AudioStatistics stats = GetStatistics();
+	if(!cfg.SyncToAudioClock || stats.AverageLatency <= 0 || _console->GetSettings()->GetEmulationSpeed() != 100) {
+		return 1.0;
+	}
+
+	//When the latency is above the requested value, the audio device is consuming samples slower than they are produced - make frames longer (max 0.5%)
+	double latencyGap = stats.AverageLatency - (int32_t)cfg.AudioLatency;
+	return 1.0 + std::max(-0.005, std::min(0.005, latencyGap * 0.0002));
+}
+
 void SoundMixer::StartRecording(string filepath)
 {
 	_waveRecorder.reset(new WaveRecorder(filepath, _console->GetSettings()->GetAudioConfig().SampleRate, true));
@@ -32,6 +32,7 @@ public:
 	void RegisterAudioDevice(IAudioDevice *audioDevice);
 	AudioStatistics GetStatistics();
 	double GetRateAdjustment();
+	double GetAudioClockAdjustment();
 
 	void StartRecording(string filepath);
 	void StopRecording();
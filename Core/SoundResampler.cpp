@@ -25,7 +25,7 @@ double SoundResampler::GetTargetRateAdjustment()
 {
 	AudioConfig cfg = _console->GetSettings()->GetAudioConfig();
 	bool isRecording = _console->GetSoundMixer()->IsRecording() || _console->GetVideoRenderer()->IsRecording();
-	if(!isRecording && !cfg.DisableDynamicSampleRate) {
+	if(!isRecording && !cfg.DisableDynamicSampleRate && !cfg.SyncToAudioClock) {
 		//Don't deviate from selected sample rate while recording
 		//TODO: Have 2 output streams (one for recording, one for the speakers)
 		AudioStatistics stats = _console->GetSoundMixer()->GetStatistics();
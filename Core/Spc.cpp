@@ -5,6 +5,7 @@
 #include "SoundMixer.h"
 #include "EmuSettings.h"
 #include "SpcFileData.h"
+#include "SubsystemProfiler.h"
 #ifndef DUMMYSPC
 #include "SPC_DSP.h"
 #else
@@ -14,6 +15,9 @@
 #endif
 #include "../Utilities/Serializer.h"
 
+constexpr uint8_t Spc::CpuWait[4];
+constexpr uint8_t Spc::TimerMultiplier[4];
+
 Spc::Spc(Console* console)
 {
 	_console = console;
@@ -75,6 +79,7 @@ void Spc::Reset()
 
 	_state.RomEnabled = true;
 	_state.Cycle = 0;
+	_clock.Reset();
 	_state.PC = ReadWord(Spc::ResetVector);
 	
 	_opCode = 0;
@@ -85,6 +90,7 @@ void Spc::Reset()
 	_tmp3 = 0;
 	_operandA = 0;
 	_operandB = 0;
+	_idleLoopValid = false;
 
 	_dsp->soft_reset();
 	_dsp->set_output(_soundBuffer, Spc::SampleBufferSize >> 1);
@@ -107,15 +113,18 @@ void Spc::SetSpcState(bool enabled)
 
 void Spc::UpdateClockRatio()
 {
-	_clockRatio = (double)(Spc::SpcSampleRate * 64) / _console->GetMasterClockRate();
+	_clock.SetRatio(Spc::SpcSampleRate * 64, _console->GetMasterClockRate());
 
 	//If the target cycle is off by more than 10 cycles, reset the counter to match what was expected
 	//This can happen due to overclocking (which disables the SPC for some scanlines) or if the SPC's 
 	//internal sample rate is changed between versions (e.g 32000hz -> 32040hz)
-	uint64_t targetCycle = (uint64_t)(_memoryManager->GetMasterClock() * _clockRatio);
+	uint64_t targetCycle = _clock.GetCycle(_memoryManager->GetMasterClock());
 	if(std::abs((int64_t)targetCycle - (int64_t)_state.Cycle) > 10) {
 		_state.Cycle = targetCycle;
 	}
+
+	//The cycle counter may have been adjusted, don't use the current loop iteration for idle loop detection
+	_idleLoopValid = false;
 }
 
 void Spc::Idle()
@@ -135,9 +144,6 @@ void Spc::DummyRead(uint16_t addr)
 
 void Spc::IncCycleCount(int32_t addr)
 {
-	static constexpr uint8_t cpuWait[4] = { 2, 4, 10, 20 };
-	static constexpr uint8_t timerMultiplier[4] = { 2, 4, 8, 16 };
-
 	uint8_t speedSelect;
 	if(addr < 0 || ((addr & 0xFFF0) == 0x00F0) || (addr >= 0xFFC0 && _state.RomEnabled)) {
 		//Use internal speed (bits 4-5) for idle cycles, register access or IPL rom access
@@ -146,17 +152,30 @@ void Spc::IncCycleCount(int32_t addr)
 		speedSelect = _state.ExternalSpeed;
 	}
 
-	_state.Cycle += cpuWait[speedSelect];
+	_state.Cycle += Spc::CpuWait[speedSelect];
 #ifndef DUMMYSPC
-	_dsp->run();
+	_pendingDspClocks++;
+	if(!_batchDspClocks) {
+		RunDsp();
+	}
 #endif
 
-	uint8_t timerInc = timerMultiplier[speedSelect];
+	uint8_t timerInc = Spc::TimerMultiplier[speedSelect];
 	_state.Timer0.Run(timerInc);
 	_state.Timer1.Run(timerInc);
 	_state.Timer2.Run(timerInc);
 }
 
+void Spc::RunDsp()
+{
+	//The DSP is only caught up when the SPC can see or change something it uses: register accesses, RAM writes
+	//and reads in the echo buffer - the clocks in between run in a single call, without per-clock dispatch
+	if(_pendingDspClocks) {
+		_dsp->run(_pendingDspClocks);
+		_pendingDspClocks = 0;
+	}
+}
+
 uint8_t Spc::DebugRead(uint16_t addr)
 {
 	if(addr >= 0xFFC0 && _state.RomEnabled) {
@@ -210,7 +229,9 @@ uint8_t Spc::Read(uint16_t addr, MemoryOperationType type)
 			case 0xF2: value = _state.DspReg; break;
 			case 0xF3: 
 				#ifndef DUMMYSPC
+				RunDsp();
 				value = _dsp->read(_state.DspReg & 0x7F);
+				_idleLoopValid = false;
 				#else
 				value = 0;
 				#endif
@@ -232,7 +253,21 @@ uint8_t Spc::Read(uint16_t addr, MemoryOperationType type)
 			case 0xFE: value = _state.Timer1.GetOutput(); break;
 			case 0xFF: value = _state.Timer2.GetOutput(); break;
 
-			default: value = _ram[addr]; break;
+			default: 
+				#ifndef DUMMYSPC
+				if(_pendingDspClocks && _dsp->isEchoWriteTarget(addr)) {
+					RunDsp();
+				}
+				#endif
+				value = _ram[addr];
+				_idleLoopRamRead |= type == MemoryOperationType::Read;
+				break;
+		}
+
+		if(addr >= 0xFD && addr <= 0xFF) {
+			//Reading a timer resets it, a polling loop is only idle while the timer reads return 0
+			_idleLoopTimers |= 1 << (addr - 0xFD);
+			_idleLoopValid &= value == 0;
 		}
 	}
 
@@ -252,6 +287,8 @@ void Spc::Write(uint16_t addr, uint8_t value, MemoryOperationType type)
 #ifdef DUMMYSPC
 	LogWrite(addr, value);
 #else
+	RunDsp();
+	_idleLoopValid = false;
 
 	//Writes always affect the underlying RAM
 	if(_state.WriteEnabled) {
@@ -325,6 +362,7 @@ void Spc::CpuWriteRegister(uint32_t addr, uint8_t value)
 {
 	Run();
 	_state.CpuRegs[addr & 0x03] = value;
+	_idleLoopValid = false;
 }
 
 uint8_t Spc::DspReadRam(uint16_t addr)
@@ -351,10 +389,76 @@ void Spc::Run()
 		return;
 	}
 
-	uint64_t targetCycle = (uint64_t)(_memoryManager->GetMasterClock() * _clockRatio);
+	SubsystemScope profilerScope(EmuSubsystem::Spc);
+	uint64_t targetCycle = _clock.GetCycle(_memoryManager->GetMasterClock());
+
+	//The debugger expects the DSP's memory accesses to happen at the same time as the SPC's
+	_batchDspClocks = !_console->GetDebugger(false);
+
 	while(_state.Cycle < targetCycle) {
+		if(_opStep == SpcOpStep::ReadOpCode) {
+			bool jumpedBack = (int32_t)_state.PC <= _prevOpPc;
+			_prevOpPc = _state.PC;
+			if(jumpedBack && ProcessIdleLoop(targetCycle)) {
+				_prevOpPc = -1;
+				continue;
+			}
+
+			if(targetCycle - _state.Cycle > Spc::MaxOpCycles) {
+				//The instruction ends before the target cycle, run all of its steps at once (the CPU can only interrupt it between 2 Run calls)
+				ProcessInstruction();
+				continue;
+			}
+		}
 		ProcessCycle();
 	}
+
+	RunDsp();
+}
+
+bool Spc::ProcessIdleLoop(uint64_t targetCycle)
+{
+	//Called when the SPC jumps backwards (or to the same instruction), e.g in a loop that polls the CPU ports or a timer
+	//If the last iteration of the loop wrote nothing, only read values that can't change before the next CPU port write
+	//(ports, timers that returned 0, RAM the DSP can't write to) and ended with the same register values it started with,
+	//the next iterations do exactly the same thing: skip them and only run the DSP and timers for their duration
+	uint64_t regs = _state.A | (_state.X << 8) | (_state.Y << 16) | (_state.SP << 24) | ((uint64_t)_state.PS << 32);
+
+	uint64_t count = 0;
+	if(_idleLoopValid && _state.PC == _idleLoopPc && regs == _idleLoopRegs && _state.InternalSpeed == _state.ExternalSpeed) {
+		RunDsp();
+		if((!_idleLoopRamRead || !_dsp->isEchoWriteEnabled()) && !_console->GetDebugger(false)) {
+			uint8_t cycleWait = Spc::CpuWait[_state.InternalSpeed];
+			uint8_t timerStep = Spc::TimerMultiplier[_state.InternalSpeed];
+			uint32_t accesses = (uint32_t)(_state.Cycle - _idleLoopStartCycle) / cycleWait;
+
+			//Stop before the CPU can write to the ports (end of this call) and before a timer read by the loop is incremented
+			count = (targetCycle - _state.Cycle) / ((uint64_t)accesses * cycleWait);
+			uint32_t timerRuns[3] = {
+				_state.Timer0.GetRunsBeforeOutputChange(timerStep),
+				_state.Timer1.GetRunsBeforeOutputChange(timerStep),
+				_state.Timer2.GetRunsBeforeOutputChange(timerStep)
+			};
+			for(int i = 0; i < 3; i++) {
+				if(_idleLoopTimers & (1 << i)) {
+					count = timerRuns[i] ? std::min<uint64_t>(count, (timerRuns[i] - 1) / accesses) : 0;
+				}
+			}
+
+			for(uint64_t i = count * accesses; i > 0; i--) {
+				IncCycleCount(-1);
+			}
+			_idleSkippedCycles += count * accesses * cycleWait;
+		}
+	}
+
+	_idleLoopPc = _state.PC;
+	_idleLoopRegs = regs;
+	_idleLoopStartCycle = _state.Cycle;
+	_idleLoopValid = true;
+	_idleLoopRamRead = false;
+	_idleLoopTimers = 0;
+	return count > 0;
 }
 
 void Spc::ProcessCycle()
@@ -368,11 +472,20 @@ void Spc::ProcessCycle()
 	}
 }
 
+void Spc::ProcessInstruction()
+{
+	_opCode = GetOpCode();
+	_opStep = SpcOpStep::Addressing;
+	_opSubStep = 0;
+	ExecInstruction();
+}
+
 void Spc::ProcessEndFrame()
 {
 	Run();
 
 	UpdateClockRatio();
+	_dsp->updateSettings();
 
 	int sampleCount = _dsp->sample_count();
 	if(sampleCount != 0) {
@@ -432,12 +545,13 @@ uint8_t* Spc::GetSpcRom()
 
 void Spc::Serialize(Serializer &s)
 {
+	double unusedClockRatio = 0;
 	s.Stream(_state.A, _state.Cycle, _state.PC, _state.PS, _state.SP, _state.X, _state.Y);
 	s.Stream(_state.CpuRegs[0], _state.CpuRegs[1], _state.CpuRegs[2], _state.CpuRegs[3]);
 	s.Stream(_state.OutputReg[0], _state.OutputReg[1], _state.OutputReg[2], _state.OutputReg[3]);
 	s.Stream(_state.RamReg[0], _state.RamReg[1]);
 	s.Stream(_state.ExternalSpeed, _state.InternalSpeed, _state.WriteEnabled, _state.TimersEnabled);
-	s.Stream(_state.DspReg, _state.RomEnabled, _clockRatio);
+	s.Stream(_state.DspReg, _state.RomEnabled, unusedClockRatio);
 
 	_state.Timer0.Serialize(s);
 	_state.Timer1.Serialize(s);
@@ -459,8 +573,6 @@ void Spc::Serialize(Serializer &s)
 	} else {
 		s.StreamArray(dspState, SPC_DSP::state_size);
 
-		UpdateClockRatio();
-
 		uint8_t *in = dspState;
 		_dsp->copy_state(&in, [](uint8_t** input, void* output, size_t size) {
 			memcpy(output, *input, size);
@@ -471,6 +583,11 @@ void Spc::Serialize(Serializer &s)
 	}
 
 	s.Stream(_operandA, _operandB, _tmp1, _tmp2, _tmp3, _opCode, _opStep, _opSubStep, _enabled, _state.TimersDisabled);
+	_clock.Serialize(s);
+
+	if(!s.IsSaving()) {
+		UpdateClockRatio();
+	}
 }
 
 uint8_t Spc::GetOpCode()
@@ -9,6 +9,7 @@
 #include "SpcTypes.h"
 #include "CpuTypes.h"
 #include "SpcTimer.h"
+#include "ClockDomain.h"
 #include "../Utilities/ISerializable.h"
 
 class Console;
@@ -27,12 +28,17 @@ public:
 private:
 	static constexpr int SampleBufferSize = 0x20000;
 	static constexpr uint16_t ResetVector = 0xFFFE;
+	static constexpr uint8_t CpuWait[4] = { 2, 4, 10, 20 };
+	static constexpr uint8_t TimerMultiplier[4] = { 2, 4, 8, 16 };
+
+	//Longest instruction (DIV, 12 cycles) at the slowest memory access speed
+	static constexpr uint32_t MaxOpCycles = 12 * 20;
 
 	Console* _console;
 	MemoryManager* _memoryManager;
 	unique_ptr<SPC_DSP> _dsp;
 
-	double _clockRatio;
+	ClockDomain _clock;
 
 	/* Temporary data used in the middle of operations */
 	uint16_t _operandA;
@@ -61,6 +67,20 @@ private:
 
 	int16_t *_soundBuffer;
 
+	//Polling loop detection (see ProcessIdleLoop)
+	int32_t _prevOpPc = -1;
+	uint16_t _idleLoopPc = 0;
+	uint64_t _idleLoopRegs = 0;
+	uint64_t _idleLoopStartCycle = 0;
+	bool _idleLoopValid = false;
+	bool _idleLoopRamRead = false;
+	uint8_t _idleLoopTimers = 0;
+	uint64_t _idleSkippedCycles = 0;
+
+	//DSP clocks that haven't been run yet (see RunDsp)
+	uint32_t _pendingDspClocks = 0;
+	bool _batchDspClocks = false;
+
 	//Store operations
 	void STA();
 	void STX();
@@ -276,10 +296,16 @@ private:
 	uint8_t ReadOperandByte();
 
 	void IncCycleCount(int32_t addr);
+	void RunDsp();
 	void EndOp();
 	void EndAddr();
 	void ProcessCycle();
+	void ProcessInstruction();
 	void Exec();
+	void ExecInstruction();
+	template<bool wholeOp> void ExecOp();
+	template<bool wholeOp, typename T> void ExecSteps(T steps);
+	bool ProcessIdleLoop(uint64_t targetCycle);
 	
 	void UpdateClockRatio();
 
@@ -305,6 +331,7 @@ public:
 
 	SpcState GetState();
 	DspState GetDspState();
+	uint64_t GetIdleSkippedCycles() { return _idleSkippedCycles; }
 
 	bool IsMuted();
 	AddressInfo GetAbsoluteAddress(uint16_t addr);
@@ -68,6 +68,28 @@ public:
 		}
 	}
 
+	uint32_t GetRunsBeforeOutputChange(uint8_t step)
+	{
+		//Number of calls to Run(step) after which the output will have been incremented (0 if the output isn't 0, -1 if it never changes)
+		if(_output != 0) {
+			return 0;
+		} else if(!_enabled || !_timersEnabled) {
+			return (uint32_t)-1;
+		} else if(_prevStage1 != _stage1) {
+			return 0;
+		}
+
+		uint32_t firstToggle = (rate - _stage0 + step - 1) / step;
+		uint32_t clocksNeeded = (uint8_t)(_target - _stage2);
+		if(clocksNeeded == 0) {
+			clocksNeeded = 256;
+		}
+
+		//The timer is clocked when stage 1 goes from 1 to 0, i.e on every other toggle
+		uint32_t toggles = (_stage1 ? 1 : 2) + (clocksNeeded - 1) * 2;
+		return firstToggle + (toggles - 1) * (rate / step);
+	}
+
 	void SetTarget(uint8_t target)
 	{
 		_target = target;
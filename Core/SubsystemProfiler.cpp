@@ -0,0 +1,53 @@
+#include "stdafx.h"
+#include "SubsystemProfiler.h"
+
+atomic<uint8_t> SubsystemProfiler::_currentSubsystem(0);
+
+SubsystemProfiler::SubsystemProfiler()
+{
+	_stopFlag = false;
+}
+
+SubsystemProfiler::~SubsystemProfiler()
+{
+	Stop();
+}
+
+void SubsystemProfiler::Start()
+{
+	Stop();
+
+	memset(_samples, 0, sizeof(_samples));
+	_sampleCount = 0;
+	_stopFlag = false;
+	_samplingThread = std::thread(&SubsystemProfiler::SamplingThread, this);
+}
+
+void SubsystemProfiler::Stop()
+{
+	_stopFlag = true;
+	if(_samplingThread.joinable()) {
+		_samplingThread.join();
+	}
+}
+
+void SubsystemProfiler::SamplingThread()
+{
+	while(!_stopFlag) {
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+		uint8_t subsystem = _currentSubsystem.load(std::memory_order_relaxed);
+		if(subsystem < SubsystemProfiler::SubsystemCount) {
+			_samples[subsystem]++;
+			_sampleCount++;
+		}
+	}
+}
+
+double SubsystemProfiler::GetRatio(EmuSubsystem subsystem)
+{
+	if(_sampleCount == 0) {
+		return 0;
+	}
+	return (double)_samples[(int)subsystem] / _sampleCount;
+}
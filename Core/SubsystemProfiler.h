@@ -0,0 +1,69 @@
+#pragma once
+#include "stdafx.h"
+#include <thread>
+
+enum class EmuSubsystem : uint8_t
+{
+	Cpu = 0,
+	PpuRender = 1,
+	Spc = 2,
+	Coprocessor = 3,
+	FrameOutput = 4
+};
+
+//Sampling profiler used by the benchmark - the emulation thread only records which subsystem it is running,
+//a separate thread samples that value at a fixed interval to estimate the time spent in each subsystem
+class SubsystemProfiler
+{
+public:
+	static constexpr int SubsystemCount = 5;
+
+private:
+	static atomic<uint8_t> _currentSubsystem;
+
+	std::thread _samplingThread;
+	atomic<bool> _stopFlag;
+	uint64_t _samples[SubsystemCount] = {};
+	uint64_t _sampleCount = 0;
+
+	void SamplingThread();
+
+public:
+	__forceinline static EmuSubsystem Enter(EmuSubsystem subsystem)
+	{
+		EmuSubsystem previous = (EmuSubsystem)_currentSubsystem.load(std::memory_order_relaxed);
+		_currentSubsystem.store((uint8_t)subsystem, std::memory_order_relaxed);
+		return previous;
+	}
+
+	__forceinline static void Leave(EmuSubsystem previous)
+	{
+		_currentSubsystem.store((uint8_t)previous, std::memory_order_relaxed);
+	}
+
+	SubsystemProfiler();
+	~SubsystemProfiler();
+
+	void Start();
+	void Stop();
+
+	//Fraction of the samples taken while the given subsystem was running
+	double GetRatio(EmuSubsystem subsystem);
+};
+
+class SubsystemScope
+{
+private:
+	EmuSubsystem _previous;
+
+public:
+	__forceinline SubsystemScope(EmuSubsystem subsystem)
+	{
+		_previous = SubsystemProfiler::Enter(subsystem);
+	}
+
+	__forceinline ~SubsystemScope()
+	{
+		SubsystemProfiler::Leave(_previous);
+	}
+};
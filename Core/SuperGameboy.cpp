@@ -45,6 +45,7 @@ void SuperGameboy::Reset()
 {
 	_control = 0;
 	_resetClock = 0;
+	_clock.Reset();
 
 	memset(_input, 0, sizeof(_input));
 	_inputIndex = 0;
@@ -112,8 +113,12 @@ void SuperGameboy::Write(uint32_t addr, uint8_t value)
 		case 0x6003: {
 			if(!(_control & 0x80) && (value & 0x80)) {
 				_resetClock = _memoryManager->GetMasterClock();
+				_clock.Reset();
 				_gameboy->PowerOn(this);
 				_ppu = _gameboy->GetPpu();
+			} else {
+				//The clocks elapsed until now run at the previous speed
+				_clock.GetCycle(_memoryManager->GetMasterClock() - _resetClock);
 			}
 			_control = value;
 			_inputIndex %= GetPlayerCount();
@@ -296,7 +301,7 @@ void SuperGameboy::Run()
 		return;
 	}
 
-	_gameboy->Run((uint64_t)((_memoryManager->GetMasterClock() - _resetClock) * _clockRatio));
+	_gameboy->Run(_clock.GetCycle(_memoryManager->GetMasterClock() - _resetClock));
 }
 
 void SuperGameboy::UpdateClockRatio()
@@ -305,7 +310,6 @@ void SuperGameboy::UpdateClockRatio()
 	uint32_t masterRate = isSgb2 ? 20971520 : _console->GetMasterClockRate();
 	uint8_t divider = 5;
 
-	//TODO: This doesn't actually work properly if the speed is changed while the SGB is running (but this most likely never happens?)
 	switch(_control & 0x03) {
 		case 0: divider = 4; break;
 		case 1: divider = 5; break;
@@ -313,13 +317,12 @@ void SuperGameboy::UpdateClockRatio()
 		case 3: divider = 9; break;
 	}
 
-	double effectiveRate = (double)masterRate / divider;
-	_clockRatio = effectiveRate / _console->GetMasterClockRate();
+	_clock.SetRatio(masterRate, divider * _console->GetMasterClockRate());
 }
 
 uint32_t SuperGameboy::GetClockRate()
 {
-	return (uint32_t)(_console->GetMasterClockRate() * _clockRatio);
+	return _clock.GetRate(_console->GetMasterClockRate());
 }
 
 uint8_t SuperGameboy::GetInputIndex()
@@ -349,9 +352,10 @@ AddressInfo SuperGameboy::GetAbsoluteAddress(uint32_t address)
 
 void SuperGameboy::Serialize(Serializer& s)
 {
+	double unusedClockRatio = 0;
 	s.Stream(
 		_control, _resetClock, _input[0], _input[1], _input[2], _input[3], _inputIndex, _listeningForPacket, _packetReady,
-		_inputWriteClock, _inputValue, _packetByte, _packetBit, _lcdRowSelect, _readPosition, _waitForHigh, _clockRatio
+		_inputWriteClock, _inputValue, _packetByte, _packetBit, _lcdRowSelect, _readPosition, _waitForHigh, unusedClockRatio
 	);
 
 	s.StreamArray(_packetData, 16);
@@ -359,4 +363,10 @@ void SuperGameboy::Serialize(Serializer& s)
 	s.StreamArray(_lcdBuffer[1], 1280);
 	s.StreamArray(_lcdBuffer[2], 1280);
 	s.StreamArray(_lcdBuffer[3], 1280);
+
+	if(!s.IsSaving()) {
+		//The clock's state is relative to the speed selected by the state's control register
+		UpdateClockRatio();
+	}
+	_clock.Serialize(s);
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "stdafx.h"
 #include "BaseCoprocessor.h"
+#include "ClockDomain.h"
 #include "../Utilities/HermiteResampler.h"
 
 class Console;
@@ -22,7 +23,7 @@ private:
 
 	uint8_t _control = 0;
 	uint64_t _resetClock = 0;
-	double _clockRatio = 0;
+	ClockDomain _clock;
 	
 	uint8_t _input[4] = {};
 	uint8_t _inputIndex = 0;
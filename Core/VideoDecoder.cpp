@@ -13,14 +13,21 @@
 #include "Ppu.h"
 #include "DebugHud.h"
 #include "InputHud.h"
+#include "../Utilities/WorkerPool.h"
+#include "../Utilities/FrameBufferPool.h"
+#include "SubsystemProfiler.h"
 
 VideoDecoder::VideoDecoder(shared_ptr<Console> console)
 {
 	_console = console;
 	_frameChanged = false;
 	_stopFlag = false;
+	_inputLatency = 0;
 	_baseFrameInfo = { 512, 478 };
 	_lastFrameInfo = _baseFrameInfo;
+#ifndef LIBRETRO
+	_workerPool.reset(new WorkerPool(WorkerPool::GetDefaultThreadCount()));
+#endif
 	UpdateVideoFilter();
 	_videoFilter->SetBaseFrameInfo(_baseFrameInfo);
 	_inputHud.reset(new InputHud(console.get()));
@@ -78,26 +85,66 @@ void VideoDecoder::UpdateVideoFilter()
 			case VideoFilterType::NTSC: _videoFilter.reset(new NtscFilter(_console)); break;
 			default: _scaleFilter = ScaleFilter::GetScaleFilter(_videoFilterType); break;
 		}
+
+		_videoFilter->SetWorkerPool(_workerPool.get());
+		if(_scaleFilter) {
+			_scaleFilter->SetWorkerPool(_workerPool.get());
+		}
 	}
 }
 
+void VideoDecoder::UpdateFilterStats(double filterTime, double hudTime, double scaleTime)
+{
+	auto lock = _statsLock.AcquireSafe();
+	_filterStats.FilterTime = _filterStats.FilterTime * 0.95 + filterTime * 0.05;
+	_filterStats.HudTime = _filterStats.HudTime * 0.95 + hudTime * 0.05;
+	_filterStats.ScaleTime = _filterStats.ScaleTime * 0.95 + scaleTime * 0.05;
+	_filterStats.TotalTime += filterTime + hudTime + scaleTime;
+	_filterStats.TotalFilterTime += filterTime;
+	_filterStats.FrameCount++;
+}
+
+VideoFilterStats VideoDecoder::GetFilterStats()
+{
+	auto lock = _statsLock.AcquireSafe();
+	return _filterStats;
+}
+
 void VideoDecoder::DecodeFrame(bool forRewind)
 {
+	//Rewind manager decides which frame is displayed (while rewinding, frames from its history replace the current frame)
+	uint16_t* ppuOutputBuffer = _ppuOutputBuffer;
+	FrameInfo baseFrameInfo = _baseFrameInfo;
+	uint32_t frameNumber = _frameNumber;
+	if(!_console->GetRewindManager()->SendFrame(ppuOutputBuffer, baseFrameInfo.Width, baseFrameInfo.Height, frameNumber, forRewind)) {
+		_frameChanged = false;
+		_decodeDone.Signal();
+		return;
+	}
+
 	UpdateVideoFilter();
 
-	_videoFilter->SetBaseFrameInfo(_baseFrameInfo);
-	_videoFilter->SendFrame(_ppuOutputBuffer, _frameNumber);
+	Timer stageTimer;
+	_videoFilter->SetBaseFrameInfo(baseFrameInfo);
+	_videoFilter->SendFrame(ppuOutputBuffer, frameNumber);
+	double filterTime = stageTimer.GetElapsedMS();
 
-	uint32_t* outputBuffer = _videoFilter->GetOutputBuffer();
+	shared_ptr<FrameBuffer> frame = _videoFilter->GetOutputFrame();
+	uint32_t* outputBuffer = frame->GetData();
 	FrameInfo frameInfo = _videoFilter->GetFrameInfo();
 	
-	_inputHud->DrawControllers(_videoFilter->GetOverscan(), _frameNumber);
-	_console->GetDebugHud()->Draw(outputBuffer, _videoFilter->GetOverscan(), frameInfo.Width, _frameNumber);
+	stageTimer.Reset();
+	_inputHud->DrawControllers(_videoFilter->GetOverscan(), frameNumber);
+	_console->GetDebugHud()->Draw(outputBuffer, _videoFilter->GetOverscan(), frameInfo.Width, frameNumber);
+	double hudTime = stageTimer.GetElapsedMS();
 
+	stageTimer.Reset();
 	if(_scaleFilter) {
-		outputBuffer = _scaleFilter->ApplyFilter(outputBuffer, frameInfo.Width, frameInfo.Height, _console->GetSettings()->GetVideoConfig().ScanlineIntensity);
+		_scaleFilter->ApplyFilter(outputBuffer, frameInfo.Width, frameInfo.Height, _console->GetSettings()->GetVideoConfig().ScanlineIntensity);
+		frame = _scaleFilter->GetOutputFrame();
 		frameInfo = _scaleFilter->GetFrameInfo(frameInfo);
 	}
+	UpdateFilterStats(filterTime, hudTime, stageTimer.GetElapsedMS());
 
 	ScreenSize screenSize = GetScreenSize(true);
 	VideoConfig config = _console->GetSettings()->GetVideoConfig();
@@ -108,10 +155,26 @@ void VideoDecoder::DecodeFrame(bool forRewind)
 	_previousScreenSize = screenSize;
 	_lastFrameInfo = frameInfo;
 
-	//Rewind manager will take care of sending the correct frame to the video renderer
-	_console->GetRewindManager()->SendFrame(outputBuffer, frameInfo.Width, frameInfo.Height, forRewind);
+	//The frame is passed to the renderer/recorders as is, the next frame is decoded into another buffer
+	_console->GetVideoRenderer()->UpdateFrame(frame);
+
+	if(_inputPollTime != steady_clock::time_point()) {
+		//Time between the input poll that preceded this frame and the frame being sent to the renderer
+		double latency = duration<double, std::milli>(steady_clock::now() - _inputPollTime).count();
+		_inputLatency = _inputLatency * 0.95 + latency * 0.05;
+	}
 
 	_frameChanged = false;
+	_decodeDone.Signal();
+}
+
+void VideoDecoder::WaitForDecode()
+{
+	//Last frame isn't done decoding yet, sleep until the decode thread is done with it
+	while(_frameChanged) {
+		_decodeDone.Wait();
+	}
+	//At this point, we are sure that the decode thread is no longer busy
 }
 
 void VideoDecoder::DecodeThread()
@@ -135,24 +198,25 @@ uint32_t VideoDecoder::GetFrameCount()
 	return _frameCount;
 }
 
+double VideoDecoder::GetInputLatency()
+{
+	return _inputLatency;
+}
+
 void VideoDecoder::UpdateFrameSync(uint16_t *ppuOutputBuffer, uint16_t width, uint16_t height, uint32_t frameNumber, bool forRewind)
 {
 	if(_console->IsRunAheadFrame()) {
 		return;
 	}
 
-	if(_frameChanged) {
-		//Last frame isn't done decoding yet - sometimes Signal() introduces a 25-30ms delay
-		while(_frameChanged) {
-			//Spin until decode is done
-		}
-		//At this point, we are sure that the decode thread is no longer busy
-	}
+	SubsystemScope profilerScope(EmuSubsystem::FrameOutput);
+	WaitForDecode();
 	
 	_frameChanged = true;
 	_baseFrameInfo.Width = width;
 	_baseFrameInfo.Height = height;
 	_frameNumber = frameNumber;
+	_inputPollTime = _console->GetInputPollTime();
 	_ppuOutputBuffer = ppuOutputBuffer;
 	DecodeFrame(forRewind);
 	_frameCount++;
@@ -164,17 +228,13 @@ void VideoDecoder::UpdateFrame(uint16_t *ppuOutputBuffer, uint16_t width, uint16
 		return;
 	}
 
-	if(_frameChanged) {
-		//Last frame isn't done decoding yet - sometimes Signal() introduces a 25-30ms delay
-		while(_frameChanged) {
-			//Spin until decode is done
-		}
-		//At this point, we are sure that the decode thread is no longer busy
-	}
+	SubsystemScope profilerScope(EmuSubsystem::FrameOutput);
+	WaitForDecode();
 	
 	_baseFrameInfo.Width = width;
 	_baseFrameInfo.Height = height;
 	_frameNumber = frameNumber;
+	_inputPollTime = _console->GetInputPollTime();
 	_ppuOutputBuffer = ppuOutputBuffer;
 	_frameChanged = true;
 	_waitForFrame.Signal();
@@ -210,6 +270,7 @@ void VideoDecoder::StopThread()
 		if(_frameCount > 0) {
 			vector<uint16_t> outputBuffer(512 * 478, 0);
 			_ppuOutputBuffer = outputBuffer.data();
+			_inputPollTime = steady_clock::time_point();
 			memset(_ppuOutputBuffer, 0, 512 * 478 * 2);
 			DecodeFrame();
 			_ppuOutputBuffer = nullptr;
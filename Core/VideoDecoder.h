@@ -2,6 +2,7 @@
 #include "stdafx.h"
 #include "../Utilities/SimpleLock.h"
 #include "../Utilities/AutoResetEvent.h"
+#include "../Utilities/Timer.h"
 #include "SettingTypes.h"
 
 class BaseVideoFilter;
@@ -10,6 +11,19 @@ class ScaleFilter;
 class IRenderingDevice;
 class InputHud;
 class Console;
+class WorkerPool;
+
+struct VideoFilterStats
+{
+	double FilterTime;
+	double HudTime;
+	double ScaleTime;
+
+	//Totals since the decoder was created (used by the benchmark)
+	double TotalTime;
+	double TotalFilterTime;
+	uint32_t FrameCount;
+};
 
 class VideoDecoder
 {
@@ -18,11 +32,18 @@ private:
 
 	uint16_t *_ppuOutputBuffer = nullptr;
 	uint32_t _frameNumber = 0;
+	steady_clock::time_point _inputPollTime;
+	atomic<double> _inputLatency;
 
 	unique_ptr<thread> _decodeThread;
 	unique_ptr<InputHud> _inputHud;
+	unique_ptr<WorkerPool> _workerPool;
+
+	SimpleLock _statsLock;
+	VideoFilterStats _filterStats = {};
 
 	AutoResetEvent _waitForFrame;
+	AutoResetEvent _decodeDone;
 	
 	atomic<bool> _frameChanged;
 	atomic<bool> _stopFlag;
@@ -39,6 +60,8 @@ private:
 	//shared_ptr<RotateFilter> _rotateFilter;
 
 	void UpdateVideoFilter();
+	void UpdateFilterStats(double filterTime, double hudTime, double scaleTime);
+	void WaitForDecode();
 
 	void DecodeThread();
 
@@ -51,6 +74,8 @@ public:
 	void TakeScreenshot(std::stringstream &stream);
 
 	uint32_t GetFrameCount();
+	double GetInputLatency();
+	VideoFilterStats GetFilterStats();
 
 	FrameInfo GetFrameInfo();
 	ScreenSize GetScreenSize(bool ignoreScale);
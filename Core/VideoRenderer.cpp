@@ -60,15 +60,15 @@ void VideoRenderer::RenderThread()
 	}
 }
 
-void VideoRenderer::UpdateFrame(void* frameBuffer, uint32_t width, uint32_t height)
+void VideoRenderer::UpdateFrame(shared_ptr<FrameBuffer> frame)
 {
 	shared_ptr<IVideoRecorder> recorder = _recorder;
 	if(recorder) {
-		recorder->AddFrame(frameBuffer, width, height, _console->GetFps());
+		recorder->AddFrame(frame, _console->GetFps());
 	}
 
 	if(_renderer) {
-		_renderer->UpdateFrame(frameBuffer, width, height);
+		_renderer->UpdateFrame(frame);
 		_waitForRender.Signal();
 	}
 }
@@ -5,6 +5,7 @@
 
 class IRenderingDevice;
 class Console;
+class FrameBuffer;
 
 class IVideoRecorder;
 enum class VideoCodec;
@@ -30,7 +31,7 @@ public:
 	void StartThread();
 	void StopThread();
 
-	void UpdateFrame(void *frameBuffer, uint32_t width, uint32_t height);
+	void UpdateFrame(shared_ptr<FrameBuffer> frame);
 	void RegisterRenderingDevice(IRenderingDevice *renderer);
 	void UnregisterRenderingDevice(IRenderingDevice *renderer);
 
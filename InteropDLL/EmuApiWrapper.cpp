@@ -13,6 +13,7 @@
 #include "../Core/CheatManager.h"
 #include "../Core/GameClient.h"
 #include "../Core/GameServer.h"
+#include "../Core/BenchmarkRunner.h"
 #include "../Utilities/ArchiveReader.h"
 #include "../Utilities/FolderUtilities.h"
 #include "InteropNotificationListeners.h"
@@ -284,4 +285,25 @@ extern "C" {
 			_console->Release();
 		}
 	}
+
+	DllExport bool __stdcall BenchmarkRun(vector<string> testRoms, uint32_t frameCount, const char* videoFilter, const char* outputFile)
+	{
+		VideoFilterType filterType = VideoFilterType::None;
+		if(videoFilter && !BenchmarkRunner::GetVideoFilterType(videoFilter, filterType)) {
+			std::cerr << "Unknown video filter: " << videoFilter << std::endl;
+			return false;
+		}
+
+		FolderUtilities::SetHomeFolder("../BenchmarkMesenHome");
+
+		BenchmarkRunner runner(frameCount, filterType);
+		string report = runner.Run(testRoms);
+		if(outputFile) {
+			ofstream output(outputFile, ios::out | ios::trunc);
+			output << report;
+		} else {
+			std::cout << report;
+		}
+		return true;
+	}
 }
\ No newline at end of file
@@ -3,12 +3,13 @@
 #include "../Core/ClientConnectionData.h"
 #include "../Core/GameServer.h"
 #include "../Core/GameClient.h"
+#include "../Core/RollbackLoopback.h"
 #include "../Core/EmuSettings.h"
 
 extern shared_ptr<Console> _console;
 
 extern "C" {
-	DllExport void __stdcall StartServer(uint16_t port, char* password, char* hostPlayerName) { GameServer::StartServer(_console, port, password, hostPlayerName); }
+	DllExport void __stdcall StartServer(uint16_t port, char* password, char* hostPlayerName, bool useRollback) { GameServer::StartServer(_console, port, password, hostPlayerName, useRollback); }
 	DllExport void __stdcall StopServer() { GameServer::StopServer(); }
 	DllExport bool __stdcall IsServerRunning() { return GameServer::Started(); }
 
@@ -21,6 +22,9 @@ extern "C" {
 	DllExport void __stdcall Disconnect() { GameClient::Disconnect(); }
 	DllExport bool __stdcall IsConnected() { return GameClient::Connected(); }
 
+	DllExport void __stdcall StartRollbackLoopback(uint8_t localPort, uint8_t remotePort, uint32_t delayFrames) { RollbackLoopback::Start(_console, localPort, remotePort, delayFrames); }
+	DllExport void __stdcall StopRollbackLoopback() { RollbackLoopback::Stop(); }
+
 	DllExport int32_t __stdcall NetPlayGetAvailableControllers()
 	{
 		if(GameServer::Started()) {
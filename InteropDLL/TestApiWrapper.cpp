@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "../Core/RecordedRomTest.h"
+#include "../Core/PixelKernelsTest.h"
 #include "../Core/Console.h"
 
 extern shared_ptr<Console> _console;
@@ -28,4 +29,10 @@ extern "C"
 	}
 
 	DllExport bool __stdcall RomTestRecording() { return _recordedRomTest != nullptr; }
+
+	DllExport int32_t __stdcall RunPixelKernelsTest()
+	{
+		PixelKernelsTest test;
+		return test.Run();
+	}
 }
\ No newline at end of file
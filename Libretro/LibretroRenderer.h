@@ -30,9 +30,12 @@ public:
 	}
 
 	// Inherited via IRenderingDevice
-	virtual void UpdateFrame(void *frameBuffer, uint32_t width, uint32_t height) override
+	virtual void UpdateFrame(shared_ptr<FrameBuffer> frame) override
 	{
 		if(!_skipMode && _sendFrame) {
+			uint32_t width = frame->GetWidth();
+			uint32_t height = frame->GetHeight();
+
 			//Use Blargg's NTSC filter's max size as a minimum resolution, to prevent changing resolution too often
 			int32_t newWidth = std::max<int32_t>(width, SNES_NTSC_OUT_WIDTH(256));
 			int32_t newHeight = std::max<int32_t>(height, 239 * 2);
@@ -46,7 +49,7 @@ public:
 				_previousHeight = newHeight;
 			}
 
-			_sendFrame(frameBuffer, width, height, sizeof(uint32_t) * width);
+			_sendFrame(frame->GetData(), width, height, sizeof(uint32_t) * width);
 		}
 	}
 	
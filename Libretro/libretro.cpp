@@ -39,6 +39,7 @@ static retro_environment_t retroEnv = nullptr;
 static unsigned _inputDevices[5] = { DEVICE_GAMEPAD, DEVICE_GAMEPAD, DEVICE_NONE, DEVICE_NONE, DEVICE_NONE };
 static string _mesenVersion = "";
 static int32_t _saveStateSize = -1;
+static vector<uint8_t> _saveStateHeader;
 
 static std::shared_ptr<Console> _console;
 static std::unique_ptr<LibretroRenderer> _renderer;
@@ -514,21 +515,34 @@ extern "C" {
 
 	RETRO_API bool retro_serialize(void *data, size_t size)
 	{
-		std::stringstream ss;
-		_console->GetSaveStateManager()->SaveState(ss);
-		
-		string saveStateData = ss.str();
-		memset(data, 0, size);
-		memcpy(data, saveStateData.c_str(), std::min(size, saveStateData.size()));
+		//Fast path: the header never changes for a given game, so it is built once when the game is loaded
+		//The console state is serialized into the serializer's (pooled) block, which is then copied once into the frontend's buffer
+		size_t headerSize = _saveStateHeader.size();
+		if(size < headerSize) {
+			return false;
+		}
 
+		uint8_t* output = (uint8_t*)data;
+		memcpy(output, _saveStateHeader.data(), headerSize);
+		uint32_t stateSize = _console->Serialize(output + headerSize, (uint32_t)(size - headerSize));
+		if(stateSize == 0) {
+			return false;
+		}
+		memset(output + headerSize + stateSize, 0, size - headerSize - stateSize);
 		return true;
 	}
 
 	RETRO_API bool retro_unserialize(const void *data, size_t size)
 	{
-		std::stringstream ss;
-		ss.write((const char*)data, size);
-		return _console->GetSaveStateManager()->LoadState(ss);
+		size_t headerSize = _saveStateHeader.size();
+		if(headerSize > 0 && size > headerSize && memcmp(data, _saveStateHeader.data(), headerSize) == 0) {
+			//State was saved by this version of the core, for this game - skip header validation and the stream layers
+			return _console->GetSaveStateManager()->LoadState((const uint8_t*)data + headerSize, (uint32_t)(size - headerSize));
+		} else {
+			std::stringstream ss;
+			ss.write((const char*)data, size);
+			return _console->GetSaveStateManager()->LoadState(ss);
+		}
 	}
 
 	RETRO_API void retro_cheat_reset()
@@ -709,8 +723,13 @@ extern "C" {
 			std::stringstream ss;
 			_console->Serialize(ss);
 
+			std::stringstream headerStream;
+			_console->GetSaveStateManager()->GetSaveStateHeader(headerStream);
+			string header = headerStream.str();
+			_saveStateHeader = vector<uint8_t>(header.begin(), header.end());
+
 			//Round up to the next 1kb multiple
-			_saveStateSize = ((ss.str().size() * 2) + 0x400) & ~0x3FF;
+			_saveStateSize = ((ss.str().size() * 2 + _saveStateHeader.size()) + 0x400) & ~0x3FF;
 			retro_set_memory_maps();
 		}
 
@@ -10,7 +10,6 @@ SimpleLock SdlRenderer::_frameLock;
 
 SdlRenderer::SdlRenderer(shared_ptr<Console> console, void* windowHandle, bool registerAsMessageManager) : BaseRenderer(console, registerAsMessageManager), _windowHandle(windowHandle)
 {
-	_frameBuffer = nullptr;
 	_requiredWidth = 256;
 	_requiredHeight = 240;
 	
@@ -28,7 +27,6 @@ SdlRenderer::~SdlRenderer()
 	}
 	Cleanup();
 	Cleanup();
-	delete[] _frameBuffer;	
 }
 
 void SdlRenderer::SetFullscreenMode(bool fullscreen, void* windowHandle, uint32_t monitorWidth, uint32_t monitorHeight)
@@ -135,21 +133,14 @@ void SdlRenderer::SetScreenSize(uint32_t width, uint32_t height)
 	}	
 }
 
-void SdlRenderer::UpdateFrame(void *frameBuffer, uint32_t width, uint32_t height)
+void SdlRenderer::UpdateFrame(shared_ptr<FrameBuffer> frame)
 {
-	_frameLock.Acquire();
-	if(_frameBuffer == nullptr || _requiredWidth != width || _requiredHeight != height) {
-		_requiredWidth = width;
-		_requiredHeight = height;
-		
-		delete[] _frameBuffer;
-		_frameBuffer = new uint32_t[width*height];
-		memset(_frameBuffer, 0, width*height*4);	
-	}
-	
-	memcpy(_frameBuffer, frameBuffer, width*height*_bytesPerPixel);
-	_frameChanged = true;	
-	_frameLock.Release();
+	//Keep a reference to the frame, it is copied directly to the texture by the render thread
+	auto lock = _frameLock.AcquireSafe();
+	_frame = frame;
+	_requiredWidth = frame->GetWidth();
+	_requiredHeight = frame->GetHeight();
+	_frameChanged = true;
 }
 
 void SdlRenderer::Render()
@@ -167,11 +158,16 @@ void SdlRenderer::Render()
 
 		uint8_t *textureBuffer;
 		int rowPitch;
-		SDL_LockTexture(_sdlTexture, nullptr, (void**)&textureBuffer, &rowPitch);
+		shared_ptr<FrameBuffer> frame;
 		{
 			auto frameLock = _frameLock.AcquireSafe();
-			if(_frameBuffer && _nesFrameWidth == _requiredWidth && _nesFrameHeight == _requiredHeight) {
-				uint32_t* ppuFrameBuffer = _frameBuffer;
+			frame = _frame;
+		}
+
+		SDL_LockTexture(_sdlTexture, nullptr, (void**)&textureBuffer, &rowPitch);
+		{
+			if(frame && _nesFrameWidth == frame->GetWidth() && _nesFrameHeight == frame->GetHeight()) {
+				uint32_t* ppuFrameBuffer = frame->GetData();
 				for(uint32_t i = 0, iMax = _nesFrameHeight; i < iMax; i++) {
 					memcpy(textureBuffer, ppuFrameBuffer, _nesFrameWidth*_bytesPerPixel);
 					ppuFrameBuffer += _nesFrameWidth;
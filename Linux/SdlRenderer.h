@@ -35,7 +35,7 @@ private:
 	bool _useBilinearInterpolation = false;
 
 	static SimpleLock _frameLock;
-	uint32_t* _frameBuffer = nullptr;
+	shared_ptr<FrameBuffer> _frame;
 
 	const uint32_t _bytesPerPixel = 4;
 	uint32_t _screenBufferSize = 0;
@@ -65,7 +65,7 @@ public:
 	SdlRenderer(shared_ptr<Console> console, void* windowHandle, bool registerAsMessageManager);
 	virtual ~SdlRenderer();
 
-	void UpdateFrame(void *frameBuffer, uint32_t width, uint32_t height) override;
+	void UpdateFrame(shared_ptr<FrameBuffer> frame) override;
 	void Render() override;
 	void Reset() override;
 
@@ -41,6 +41,7 @@ namespace Mesen.GUI.Config
 		public bool ShowDebugInfo = false;
 		public bool DisableOsd = false;
 		public bool DisableGameSelectionScreen = false;
+		public bool CacheDecompressedRoms = false;
 
 		public List<ShortcutKeyInfo> ShortcutKeys1;
 		public List<ShortcutKeyInfo> ShortcutKeys2;
@@ -166,6 +167,7 @@ namespace Mesen.GUI.Config
 				AllowBackgroundInput = AllowBackgroundInput,
 				PauseOnMovieEnd = PauseOnMovieEnd,
 				DisableGameSelectionScreen = DisableGameSelectionScreen,
+				CacheDecompressedRoms = CacheDecompressedRoms,
 				SaveFolderOverride = OverrideSaveDataFolder ? SaveDataFolder : "",
 				SaveStateFolderOverride = OverrideSaveStateFolder ? SaveStateFolder : "",
 				ScreenshotFolderOverride = OverrideScreenshotFolder ? ScreenshotFolder : "",
@@ -184,6 +186,7 @@ namespace Mesen.GUI.Config
 		[MarshalAs(UnmanagedType.I1)] public bool AllowBackgroundInput;
 		[MarshalAs(UnmanagedType.I1)] public bool PauseOnMovieEnd;
 		[MarshalAs(UnmanagedType.I1)] public bool DisableGameSelectionScreen;
+		[MarshalAs(UnmanagedType.I1)] public bool CacheDecompressedRoms;
 		
 		public UInt32 RewindBufferSize;
 
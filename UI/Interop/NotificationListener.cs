@@ -64,5 +64,6 @@ namespace Mesen.GUI
 		MissingFirmware = 15,
 		BeforeGameUnload = 16,
 		CheatsChanged = 17,
+		StateSaved = 18,
 	}
 }
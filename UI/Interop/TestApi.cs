@@ -15,5 +15,6 @@ namespace Mesen.GUI.Interop
 		[DllImport(DllPath)] public static extern void RomTestRecord([MarshalAs(UnmanagedType.CustomMarshaler, MarshalTypeRef = typeof(Utf8Marshaler))]string filename, [MarshalAs(UnmanagedType.I1)]bool reset);
 		[DllImport(DllPath)] public static extern void RomTestStop();
 		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool RomTestRecording();
+		[DllImport(DllPath)] public static extern Int32 RunPixelKernelsTest();
 	}
 }
@@ -36,7 +36,7 @@ namespace Mesen.GUI.Utilities
 				using(frmServerConfig frm = new frmServerConfig()) {
 					if(frm.ShowDialog(frmMain.Instance) == DialogResult.OK) {
 						NetplayConfig cfg = ConfigManager.Config.Netplay;
-						NetplayApi.StartServer(cfg.ServerPort, cfg.ServerPassword, cfg.PlayerName);
+						NetplayApi.StartServer(cfg.ServerPort, cfg.ServerPassword, cfg.PlayerName, cfg.ServerUseRollback);
 					}
 				}
 			}
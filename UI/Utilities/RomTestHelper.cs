@@ -55,6 +55,8 @@ namespace Mesen.GUI.Utilities
 					results[Path.GetFileNameWithoutExtension(testFile)] = result;
 				});
 
+				results["PixelKernelsTest"] = TestApi.RunPixelKernelsTest();
+
 				frmMain.Instance.BeginInvoke((Action)(() => {
 					EmuApi.WriteLogEntry("==================");
 					List<string> failedTests = new List<string>();
@@ -69,13 +71,13 @@ namespace Mesen.GUI.Utilities
 
 					EmuApi.WriteLogEntry("==================");
 					if(failedTests.Count > 0) {
-						EmuApi.WriteLogEntry("Tests passed: " + (testFiles.Count - failedTests.Count));
+						EmuApi.WriteLogEntry("Tests passed: " + (results.Count - failedTests.Count));
 						EmuApi.WriteLogEntry("Tests failed: " + failedTests.Count);
 						foreach(string failedTest in failedTests) {
 							EmuApi.WriteLogEntry("  Failed: " + failedTest);
 						}
 					} else {
-						EmuApi.WriteLogEntry("All " + testFiles.Count + " tests passed!");
+						EmuApi.WriteLogEntry("All " + results.Count + " tests passed!");
 					}
 					EmuApi.WriteLogEntry("==================");
 
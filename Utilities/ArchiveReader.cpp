@@ -4,6 +4,7 @@
 #include <sstream>
 #include <algorithm>
 #include "FolderUtilities.h"
+#include "CRC32.h"
 #include "ZipReader.h"
 #include "SZReader.h"
 
@@ -24,6 +25,39 @@ bool ArchiveReader::GetStream(string filename, std::stringstream &stream)
 	return false;
 }
 
+bool ArchiveReader::GetFileSize(string filename, size_t &size)
+{
+	return _initialized && InternalGetFileSize(filename, size);
+}
+
+bool ArchiveReader::ExtractFile(string filename, vector<uint8_t> &output)
+{
+	size_t size;
+	if(GetFileSize(filename, size)) {
+		output.resize(size);
+		if(InternalExtractFile(filename, output.data(), size)) {
+			return true;
+		}
+		output.clear();
+	}
+	return false;
+}
+
+bool ArchiveReader::ExtractFile(string filename, uint8_t* output, size_t size)
+{
+	//Decompresses the file straight into the caller's buffer, which must match the file's size
+	size_t fileSize;
+	if(GetFileSize(filename, fileSize) && fileSize == size) {
+		return InternalExtractFile(filename, output, size);
+	}
+	return false;
+}
+
+uint32_t ArchiveReader::GetArchiveCrc()
+{
+	return _initialized ? CRC32::GetCRC(_archiveData, _archiveSize) : 0;
+}
+
 vector<string> ArchiveReader::GetFileList(std::initializer_list<string> extensions)
 {
 	if(extensions.size() == 0) {
@@ -74,6 +108,8 @@ bool ArchiveReader::LoadArchive(vector<uint8_t> &data)
 bool ArchiveReader::LoadArchive(void* buffer, size_t size)
 {
 	if(InternalLoadArchive(buffer, size)) {
+		_archiveData = (uint8_t*)buffer;
+		_archiveSize = size;
 		_initialized = true;
 		return true;
 	}
@@ -82,26 +118,40 @@ bool ArchiveReader::LoadArchive(void* buffer, size_t size)
 
 bool ArchiveReader::LoadArchive(string filename)
 {
+	//Map the archive rather than copying it into memory, when possible
+	unique_ptr<MemoryMappedFile> mappedFile(new MemoryMappedFile());
+	if(mappedFile->Open(filename)) {
+		if(LoadArchive(mappedFile->GetData(), mappedFile->GetSize())) {
+			_mappedFile = std::move(mappedFile);
+			return true;
+		}
+		return false;
+	}
+
 	ifstream in(filename, std::ios::binary | std::ios::in);
 	if(in.good()) {
-		LoadArchive(in);
-		in.close();
+		return LoadArchive(in);
 	}
 	return false;
 }
 
-shared_ptr<ArchiveReader> ArchiveReader::GetReader(std::istream &in)
+shared_ptr<ArchiveReader> ArchiveReader::CreateReader(uint8_t* header)
 {
-	uint8_t header[2] = { 0,0 };
-	in.read((char*)header, 2);
-
 	shared_ptr<ArchiveReader> reader;
 	if(memcmp(header, "PK", 2) == 0) {
 		reader.reset(new ZipReader());
 	} else if(memcmp(header, "7z", 2) == 0) {
 		reader.reset(new SZReader());
 	}
+	return reader;
+}
 
+shared_ptr<ArchiveReader> ArchiveReader::GetReader(std::istream &in)
+{
+	uint8_t header[2] = { 0,0 };
+	in.read((char*)header, 2);
+
+	shared_ptr<ArchiveReader> reader = CreateReader(header);
 	if(reader) {
 		reader->LoadArchive(in);
 	}
@@ -112,7 +162,15 @@ shared_ptr<ArchiveReader> ArchiveReader::GetReader(string filepath)
 {
 	ifstream in(filepath, std::ios::in | std::ios::binary);
 	if(in) {
-		return GetReader(in);
+		uint8_t header[2] = { 0,0 };
+		in.read((char*)header, 2);
+		in.close();
+
+		shared_ptr<ArchiveReader> reader = CreateReader(header);
+		if(reader) {
+			reader->LoadArchive(filepath);
+		}
+		return reader;
 	}
 	return nullptr;
 }
\ No newline at end of file
@@ -1,15 +1,25 @@
 #pragma once
 #include "stdafx.h"
+#include "MemoryMappedFile.h"
 
 class ArchiveReader
 {
 protected:
 	bool _initialized = false;
 	uint8_t* _buffer = nullptr;
+	uint8_t* _archiveData = nullptr;
+	size_t _archiveSize = 0;
+	unique_ptr<MemoryMappedFile> _mappedFile;
+
 	virtual bool InternalLoadArchive(void* buffer, size_t size) = 0;
 	virtual vector<string> InternalGetFileList() = 0;
+	virtual bool InternalGetFileSize(string filename, size_t &size) = 0;
+	virtual bool InternalExtractFile(string filename, uint8_t* output, size_t size) = 0;
+
+	static shared_ptr<ArchiveReader> CreateReader(uint8_t* header);
+
 public:
-	~ArchiveReader();
+	virtual ~ArchiveReader();
 
 	bool LoadArchive(void* buffer, size_t size);
 	bool LoadArchive(vector<uint8_t>& data);
@@ -21,7 +31,11 @@ public:
 	vector<string> GetFileList(std::initializer_list<string> extensions = {});
 	bool CheckFile(string filename);
 
-	virtual bool ExtractFile(string filename, vector<uint8_t> &output) = 0;
+	bool GetFileSize(string filename, size_t &size);
+	bool ExtractFile(string filename, vector<uint8_t> &output);
+	bool ExtractFile(string filename, uint8_t* output, size_t size);
+
+	uint32_t GetArchiveCrc();
 
 	static shared_ptr<ArchiveReader> GetReader(std::istream &in);
 	static shared_ptr<ArchiveReader> GetReader(string filepath);
@@ -5,8 +5,6 @@ AviRecorder::AviRecorder(VideoCodec codec, uint32_t compressionLevel)
 {
 	_recording = false;
 	_stopFlag = false;
-	_frameBuffer = nullptr;
-	_frameBufferLength = 0;
 	_sampleRate = 0;
 	_codec = codec;
 	_compressionLevel = compressionLevel;
@@ -17,11 +15,6 @@ AviRecorder::~AviRecorder()
 	if(_recording) {
 		StopRecording();
 	}
-
-	if(_frameBuffer) {
-		delete[] _frameBuffer;
-		_frameBuffer = nullptr;
-	}
 }
 
 bool AviRecorder::StartRecording(string filename, uint32_t width, uint32_t height, uint32_t bpp, uint32_t audioSampleRate, double fps)
@@ -32,8 +25,7 @@ bool AviRecorder::StartRecording(string filename, uint32_t width, uint32_t heigh
 		_width = width;
 		_height = height;
 		_fps = fps;
-		_frameBufferLength = height * width * bpp;
-		_frameBuffer = new uint8_t[_frameBufferLength];
+		_pendingFrame.reset();
 
 		_aviWriter.reset(new AviWriter());
 		if(!_aviWriter->StartWrite(filename, _codec, width, height, bpp, (uint32_t)(_fps * 1000000), audioSampleRate, _compressionLevel)) {
@@ -48,8 +40,16 @@ bool AviRecorder::StartRecording(string filename, uint32_t width, uint32_t heigh
 					break;
 				}
 
-				auto lock = _lock.AcquireSafe();
-				_aviWriter->AddFrame(_frameBuffer);
+				shared_ptr<FrameBuffer> frame;
+				{
+					auto lock = _lock.AcquireSafe();
+					frame.swap(_pendingFrame);
+				}
+
+				if(frame) {
+					//The frame is never modified once it has been sent, no need to hold the lock while encoding it
+					_aviWriter->AddFrame((uint8_t*)frame->GetData());
+				}
 			}
 		});
 
@@ -66,20 +66,21 @@ void AviRecorder::StopRecording()
 		_stopFlag = true;
 		_waitFrame.Signal();
 		_aviWriterThread.join();
+		_pendingFrame.reset();
 
 		_aviWriter->EndWrite();
 		_aviWriter.reset();
 	}
 }
 
-void AviRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, double fps)
+void AviRecorder::AddFrame(shared_ptr<FrameBuffer> frame, double fps)
 {
 	if(_recording) {
-		if(_width != width || _height != height || _fps != fps) {
+		if(_width != frame->GetWidth() || _height != frame->GetHeight() || _fps != fps) {
 			StopRecording();
 		} else {
 			auto lock = _lock.AcquireSafe();
-			memcpy(_frameBuffer, frameBuffer, _frameBufferLength);
+			_pendingFrame = frame;
 			_waitFrame.Signal();
 		}
 	}
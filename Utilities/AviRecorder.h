@@ -21,8 +21,7 @@ private:
 
 	atomic<bool> _stopFlag;	
 	bool _recording;
-	uint8_t* _frameBuffer;
-	uint32_t _frameBufferLength;
+	shared_ptr<FrameBuffer> _pendingFrame;
 	uint32_t _sampleRate;
 
 	double _fps;
@@ -39,7 +38,7 @@ public:
 	bool StartRecording(string filename, uint32_t width, uint32_t height, uint32_t bpp, uint32_t audioSampleRate, double fps) override;
 	void StopRecording() override;
 
-	void AddFrame(void* frameBuffer, uint32_t width, uint32_t height, double fps) override;
+	void AddFrame(shared_ptr<FrameBuffer> frame, double fps) override;
 	void AddSound(int16_t* soundBuffer, uint32_t sampleCount, uint32_t sampleRate) override;
 
 	bool IsRecording() override;
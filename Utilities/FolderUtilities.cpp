@@ -137,6 +137,13 @@ string FolderUtilities::GetRecentGamesFolder()
 	return folder;
 }
 
+string FolderUtilities::GetRomCacheFolder()
+{
+	string folder = CombinePath(GetHomeFolder(), "RomCache");
+	CreateFolder(folder);
+	return folder;
+}
+
 string FolderUtilities::GetExtension(string filename)
 {
 	size_t position = filename.find_last_of('.');
@@ -228,6 +235,25 @@ string FolderUtilities::GetFolderName(string filepath)
 	return fs::u8path(filepath).remove_filename().u8string();
 }
 
+bool FolderUtilities::GetFileInfo(string filepath, uint64_t &size, int64_t &modificationTime)
+{
+	std::error_code errorCode;
+	fs::path path = fs::u8path(filepath);
+	size = (uint64_t)fs::file_size(path, errorCode);
+	if(errorCode) {
+		return false;
+	}
+
+	modificationTime = (int64_t)fs::last_write_time(path, errorCode).time_since_epoch().count();
+	return !errorCode;
+}
+
+bool FolderUtilities::RemoveFile(string filepath)
+{
+	std::error_code errorCode;
+	return fs::remove(fs::u8path(filepath), errorCode);
+}
+
 string FolderUtilities::CombinePath(string folder, string filename)
 {
 	//Windows supports forward slashes for paths, too.  And fs::u8path is abnormally slow.
@@ -278,6 +304,16 @@ string FolderUtilities::GetFolderName(string filepath)
 	return filepath.substr(0, index);
 }
 
+bool FolderUtilities::GetFileInfo(string filepath, uint64_t &size, int64_t &modificationTime)
+{
+	return false;
+}
+
+bool FolderUtilities::RemoveFile(string filepath)
+{
+	return std::remove(filepath.c_str()) == 0;
+}
+
 string FolderUtilities::CombinePath(string folder, string filename)
 {
 	if(folder.find_last_of(PATHSEPARATOR) != folder.length() - 1) {
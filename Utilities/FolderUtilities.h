@@ -29,6 +29,7 @@ public:
 	static string GetHdPackFolder();
 	static string GetDebuggerFolder();
 	static string GetRecentGamesFolder();
+	static string GetRomCacheFolder();
 
 	static vector<string> GetFolders(string rootFolder);
 	static vector<string> GetFilesInFolder(string rootFolder, std::unordered_set<string> extensions, bool recursive);
@@ -38,6 +39,8 @@ public:
 	static string GetFolderName(string filepath);
 
 	static void CreateFolder(string folder);
+	static bool GetFileInfo(string filepath, uint64_t &size, int64_t &modificationTime);
+	static bool RemoveFile(string filepath);
 
 	static string CombinePath(string folder, string filename);
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "stdafx.h"
+#include "FrameBufferPool.h"
+
+FrameBuffer::FrameBuffer(uint32_t width, uint32_t height)
+{
+	_width = width;
+	_height = height;
+	_data.resize(width * height);
+}
+
+uint32_t* FrameBuffer::GetData()
+{
+	return _data.data();
+}
+
+uint32_t FrameBuffer::GetWidth()
+{
+	return _width;
+}
+
+uint32_t FrameBuffer::GetHeight()
+{
+	return _height;
+}
+
+FrameBufferPool::~FrameBufferPool()
+{
+	for(FrameBuffer* frame : _freeFrames) {
+		delete frame;
+	}
+}
+
+shared_ptr<FrameBuffer> FrameBufferPool::GetFrame(uint32_t width, uint32_t height)
+{
+	FrameBuffer* frame = nullptr;
+	{
+		auto lock = _lock.AcquireSafe();
+		while(!_freeFrames.empty() && !frame) {
+			frame = _freeFrames.back();
+			_freeFrames.pop_back();
+			if(frame->_data.size() != (size_t)width * height) {
+				//Resolution changed, frames of the previous size are no longer needed
+				delete frame;
+				frame = nullptr;
+			}
+		}
+	}
+
+	if(frame) {
+		frame->_width = width;
+		frame->_height = height;
+	} else {
+		frame = new FrameBuffer(width, height);
+	}
+
+	//Frames that are still in use when the pool is destroyed are deleted normally
+	std::weak_ptr<FrameBufferPool> pool = shared_from_this();
+	return shared_ptr<FrameBuffer>(frame, [pool](FrameBuffer* frame) {
+		shared_ptr<FrameBufferPool> owner = pool.lock();
+		if(owner) {
+			owner->Release(frame);
+		} else {
+			delete frame;
+		}
+	});
+}
+
+void FrameBufferPool::Release(FrameBuffer* frame)
+{
+	auto lock = _lock.AcquireSafe();
+	if(_freeFrames.size() < FrameBufferPool::MaxFreeFrames) {
+		_freeFrames.push_back(frame);
+	} else {
+		delete frame;
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "stdafx.h"
+#include "SimpleLock.h"
+
+class FrameBufferPool;
+
+//32-bit ARGB frame, shared by the video decoder, the renderer and the recorders instead of being copied between them
+class FrameBuffer
+{
+private:
+	friend class FrameBufferPool;
+
+	vector<uint32_t> _data;
+	uint32_t _width;
+	uint32_t _height;
+
+public:
+	FrameBuffer(uint32_t width, uint32_t height);
+
+	uint32_t* GetData();
+	uint32_t GetWidth();
+	uint32_t GetHeight();
+};
+
+class FrameBufferPool : public std::enable_shared_from_this<FrameBufferPool>
+{
+private:
+	//Enough for a frame being decoded, a frame waiting to be rendered and a frame being rendered
+	static constexpr size_t MaxFreeFrames = 3;
+
+	SimpleLock _lock;
+	vector<FrameBuffer*> _freeFrames;
+
+	void Release(FrameBuffer* frame);
+
+public:
+	~FrameBufferPool();
+
+	//The frame goes back to the pool when its last reference is released
+	shared_ptr<FrameBuffer> GetFrame(uint32_t width, uint32_t height);
+};
@@ -27,13 +27,13 @@ void GifRecorder::StopRecording()
 	}
 }
 
-void GifRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, double fps)
+void GifRecorder::AddFrame(shared_ptr<FrameBuffer> frame, double fps)
 {
 	_frameCounter++;
 	
 	if(fps < 55 || (_frameCounter % 6) != 0) {
 		//At 60 FPS, skip 1 of every 6 frames (max FPS for GIFs is 50fps)
-		GifWriteFrame(_gif.get(), (uint8_t*)frameBuffer, width, height, 2, 8, false);
+		GifWriteFrame(_gif.get(), (uint8_t*)frame->GetData(), frame->GetWidth(), frame->GetHeight(), 2, 8, false);
 	}
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "stdafx.h"
+#include "FrameBufferPool.h"
 
 class IVideoRecorder
 {
@@ -7,7 +8,7 @@ public:
 	virtual bool StartRecording(string filename, uint32_t width, uint32_t height, uint32_t bpp, uint32_t audioSampleRate, double fps) = 0;
 	virtual void StopRecording() = 0;
 
-	virtual void AddFrame(void* frameBuffer, uint32_t width, uint32_t height, double fps) = 0;
+	virtual void AddFrame(shared_ptr<FrameBuffer> frame, double fps) = 0;
 	virtual void AddSound(int16_t* soundBuffer, uint32_t sampleCount, uint32_t sampleRate) = 0;
 
 	virtual bool IsRecording() = 0;
@@ -78,6 +78,12 @@ bool IpsPatcher::PatchBuffer(vector<uint8_t> &ipsData, vector<uint8_t> &input, v
 }
 
 bool IpsPatcher::PatchBuffer(std::istream &ipsFile, vector<uint8_t> &input, vector<uint8_t> &output)
+{
+	output = input;
+	return PatchBuffer(ipsFile, output);
+}
+
+bool IpsPatcher::PatchBuffer(std::istream &ipsFile, vector<uint8_t> &data)
 {
 	char header[5];
 	ipsFile.read((char*)&header, 5);
@@ -86,16 +92,21 @@ bool IpsPatcher::PatchBuffer(std::istream &ipsFile, vector<uint8_t> &input, vect
 		return false;
 	}
 
-	vector<IpsRecord> records;
+	//Records are applied as they are read, directly into the buffer
 	int32_t truncateOffset = -1;
-	size_t maxOutputSize = input.size();
 	while(!ipsFile.eof()) {
 		IpsRecord record;
 		if(record.ReadRecord(ipsFile)) {
-			if(record.Address + record.Length + record.RepeatCount > maxOutputSize) {
-				maxOutputSize = record.Address + record.Length + record.RepeatCount;
+			size_t recordEnd = (size_t)record.Address + record.Length + record.RepeatCount;
+			if(recordEnd > data.size()) {
+				data.resize(recordEnd);
+			}
+
+			if(record.Length == 0) {
+				std::fill(data.begin() + record.Address, data.begin() + record.Address + record.RepeatCount, record.Value);
+			} else {
+				std::copy(record.Replacement.begin(), record.Replacement.end(), data.begin() + record.Address);
 			}
-			records.push_back(record);
 		} else {
 			//EOF, try to read truncate offset record if it exists
 			uint8_t buffer[3];
@@ -107,19 +118,8 @@ bool IpsPatcher::PatchBuffer(std::istream &ipsFile, vector<uint8_t> &input, vect
 		}
 	}
 
-	output.resize(maxOutputSize);
-	std::copy(input.begin(), input.end(), output.begin());
-
-	for(IpsRecord record : records) {
-		if(record.Length == 0) {
-			std::fill(&output[record.Address], &output[record.Address]+record.RepeatCount, record.Value);
-		} else {
-			std::copy(record.Replacement.begin(), record.Replacement.end(), output.begin()+record.Address);
-		}
-	}
-
-	if(truncateOffset != -1 && (int32_t)output.size() > truncateOffset) {
-		output.resize(truncateOffset);
+	if(truncateOffset != -1 && (int32_t)data.size() > truncateOffset) {
+		data.resize(truncateOffset);
 	}
 
 	return true;
@@ -8,5 +8,6 @@ public:
 	static bool PatchBuffer(string ipsFilepath, vector<uint8_t> &input, vector<uint8_t> &output);
 	static bool PatchBuffer(vector<uint8_t>& ipsData, vector<uint8_t>& input, vector<uint8_t>& output);
 	static bool PatchBuffer(std::istream &ipsFile, vector<uint8_t> &input, vector<uint8_t> &output);
+	static bool PatchBuffer(std::istream &ipsFile, vector<uint8_t> &data);
 	static vector<uint8_t> CreatePatch(vector<uint8_t> originalData, vector<uint8_t> newData);
 };
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "stdafx.h"
+#include "MemoryMappedFile.h"
+
+#ifndef LIBRETRO
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#include <Windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+#endif
+
+MemoryMappedFile::MemoryMappedFile()
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	Close();
+}
+
+bool MemoryMappedFile::Open(string filepath)
+{
+	Close();
+
+#ifdef LIBRETRO
+	//Not supported on all libretro platforms, callers fall back to reading the file
+	return false;
+#elif defined(_WIN32)
+	HANDLE file = CreateFileW(utf8::utf8::decode(filepath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	_fileHandle = file;
+
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		Close();
+		return false;
+	}
+
+	_mappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if(!_mappingHandle) {
+		Close();
+		return false;
+	}
+
+	_data = (uint8_t*)MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if(!_data) {
+		Close();
+		return false;
+	}
+	_size = (size_t)size.QuadPart;
+	return true;
+#else
+	_fd = open(filepath.c_str(), O_RDONLY);
+	if(_fd < 0) {
+		return false;
+	}
+
+	struct stat fileStat;
+	if(fstat(_fd, &fileStat) != 0 || fileStat.st_size == 0) {
+		Close();
+		return false;
+	}
+
+	void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+	if(data == MAP_FAILED) {
+		Close();
+		return false;
+	}
+
+	//Archives and roms are read from start to end
+	madvise(data, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+
+	_data = (uint8_t*)data;
+	_size = (size_t)fileStat.st_size;
+	return true;
+#endif
+}
+
+void MemoryMappedFile::Close()
+{
+#ifndef LIBRETRO
+#ifdef _WIN32
+	if(_data) {
+		UnmapViewOfFile(_data);
+	}
+	if(_mappingHandle) {
+		CloseHandle(_mappingHandle);
+		_mappingHandle = nullptr;
+	}
+	if(_fileHandle) {
+		CloseHandle(_fileHandle);
+		_fileHandle = nullptr;
+	}
+#else
+	if(_data) {
+		munmap(_data, _size);
+	}
+	if(_fd >= 0) {
+		close(_fd);
+		_fd = -1;
+	}
+#endif
+#endif
+
+	_data = nullptr;
+	_size = 0;
+}
+
+uint8_t* MemoryMappedFile::GetData()
+{
+	return _data;
+}
+
+size_t MemoryMappedFile::GetSize()
+{
+	return _size;
+}
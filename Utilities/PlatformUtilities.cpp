@@ -3,6 +3,9 @@
 
 #if !defined(LIBRETRO) && defined(_WIN32)
 #include <Windows.h>
+#include <Psapi.h>
+#elif !defined(LIBRETRO)
+#include <sys/resource.h>
 #endif
 
 bool PlatformUtilities::_highResTimerEnabled = false;
@@ -42,4 +45,28 @@ void PlatformUtilities::RestoreTimerResolution()
 		_highResTimerEnabled = false;
 	}
 	#endif
+}
+
+size_t PlatformUtilities::GetPeakMemoryUsage()
+{
+#if !defined(LIBRETRO) && defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters = {};
+	if(K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return counters.PeakWorkingSetSize;
+	}
+	return 0;
+#elif !defined(LIBRETRO)
+	struct rusage usage = {};
+	if(getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+	#ifdef __APPLE__
+		return (size_t)usage.ru_maxrss;
+	#else
+		//Linux reports the value in kilobytes
+		return (size_t)usage.ru_maxrss * 1024;
+	#endif
+#else
+	return 0;
+#endif
 }
\ No newline at end of file
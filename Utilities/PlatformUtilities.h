@@ -12,4 +12,7 @@ public:
 
 	static void EnableHighResolutionTimer();
 	static void RestoreTimerResolution();
+
+	//Peak resident memory of the process, in bytes (0 when not supported)
+	static size_t GetPeakMemoryUsage();
 };
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "stdafx.h"
+#include <thread>
+#include <sstream>
+#include "RomHashIndex.h"
+#include "FolderUtilities.h"
+#include "VirtualFile.h"
+#include "CRC32.h"
+#include "sha1.h"
+
+SimpleLock RomHashIndex::_lock;
+std::unordered_map<string, RomHashEntry> RomHashIndex::_entries;
+bool RomHashIndex::_loaded = false;
+
+string RomHashIndex::GetIndexFilepath()
+{
+	return FolderUtilities::CombinePath(FolderUtilities::GetHomeFolder(), RomHashIndex::IndexFilename);
+}
+
+void RomHashIndex::Load()
+{
+	if(_loaded) {
+		return;
+	}
+	_loaded = true;
+
+	ifstream file(GetIndexFilepath(), std::ios::in | std::ios::binary);
+	if(!file) {
+		return;
+	}
+
+	string line;
+	std::getline(file, line);
+	if(line != RomHashIndex::IndexHeader) {
+		//Unknown format, the index will be rebuilt
+		return;
+	}
+
+	//Each line contains: sha1 crc32 size modificationTime path
+	while(std::getline(file, line)) {
+		std::istringstream ss(line);
+		RomHashEntry entry;
+		ss >> entry.Sha1 >> std::hex >> entry.Crc32 >> std::dec >> entry.Size >> entry.ModificationTime;
+		ss.get();
+		std::getline(ss, entry.Path);
+		if(!ss.fail() && !entry.Path.empty()) {
+			_entries[entry.Path] = entry;
+		}
+	}
+}
+
+void RomHashIndex::Save()
+{
+	ofstream file(GetIndexFilepath(), std::ios::out | std::ios::binary);
+	if(!file) {
+		return;
+	}
+
+	file << RomHashIndex::IndexHeader << "\n";
+	for(auto &kvp : _entries) {
+		RomHashEntry &entry = kvp.second;
+		file << entry.Sha1 << " " << std::hex << entry.Crc32 << std::dec << " " << entry.Size << " " << entry.ModificationTime << " " << entry.Path << "\n";
+	}
+}
+
+bool RomHashIndex::IsUpToDate(const string &path, uint64_t &size, int64_t &modificationTime)
+{
+	if(!FolderUtilities::GetFileInfo(path, size, modificationTime)) {
+		return false;
+	}
+
+	auto result = _entries.find(path);
+	return result != _entries.end() && result->second.Size == size && result->second.ModificationTime == modificationTime;
+}
+
+void RomHashIndex::HashFiles(vector<RomHashEntry> &entries)
+{
+	atomic<size_t> nextEntry(0);
+	auto hashFiles = [&entries, &nextEntry]() {
+		vector<uint8_t> data;
+		size_t i;
+		while((i = nextEntry++) < entries.size()) {
+			RomHashEntry &entry = entries[i];
+			data.clear();
+			VirtualFile(entry.Path).ReadFile(data);
+			entry.Crc32 = CRC32::GetCRC(data.data(), data.size());
+			entry.Sha1 = SHA1::GetHash(data);
+		}
+	};
+
+	//Hashing is mostly bound by file reads/decompression, use one worker per core (the calling thread is one of them)
+	size_t workerCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), entries.size());
+	vector<std::thread> workers;
+	for(size_t i = 1; i < workerCount; i++) {
+		workers.emplace_back(hashFiles);
+	}
+	hashFiles();
+	for(std::thread &worker : workers) {
+		worker.join();
+	}
+}
+
+void RomHashIndex::Update(const vector<string> &files)
+{
+	vector<RomHashEntry> newEntries;
+	{
+		auto lock = _lock.AcquireSafe();
+		Load();
+		for(const string &path : files) {
+			RomHashEntry entry = {};
+			if(!IsUpToDate(path, entry.Size, entry.ModificationTime) && entry.Size > 0) {
+				entry.Path = path;
+				newEntries.push_back(entry);
+			}
+		}
+	}
+
+	if(newEntries.empty()) {
+		return;
+	}
+
+	//Hash without holding the lock - this can take a while for large libraries
+	HashFiles(newEntries);
+
+	auto lock = _lock.AcquireSafe();
+	for(RomHashEntry &entry : newEntries) {
+		_entries[entry.Path] = entry;
+	}
+	Save();
+}
+
+string RomHashIndex::FindRom(const string &sha1Hash)
+{
+	auto lock = _lock.AcquireSafe();
+	Load();
+
+	bool removedEntries = false;
+	string match;
+	for(auto it = _entries.begin(); it != _entries.end();) {
+		if(it->second.Sha1 == sha1Hash) {
+			uint64_t size;
+			int64_t modificationTime;
+			if(!FolderUtilities::GetFileInfo(it->first, size, modificationTime)) {
+				//File no longer exists
+				it = _entries.erase(it);
+				removedEntries = true;
+				continue;
+			} else if(size == it->second.Size && modificationTime == it->second.ModificationTime) {
+				match = it->first;
+				break;
+			}
+		}
+		it++;
+	}
+
+	if(removedEntries) {
+		Save();
+	}
+	return match;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "stdafx.h"
+#include <unordered_map>
+#include "SimpleLock.h"
+
+struct RomHashEntry
+{
+	string Path;
+	uint64_t Size;
+	int64_t ModificationTime;
+	uint32_t Crc32;
+	string Sha1;
+};
+
+//On-disk cache of the hashes of the ROM files in the known game folders
+//Entries are keyed by path and are only considered valid while the file's size and modification time are unchanged
+class RomHashIndex
+{
+private:
+	static constexpr const char* IndexFilename = "RomHashIndex.txt";
+	static constexpr const char* IndexHeader = "MesenS-RomHashIndex v1";
+
+	static SimpleLock _lock;
+	static std::unordered_map<string, RomHashEntry> _entries;
+	static bool _loaded;
+
+	static string GetIndexFilepath();
+	static void Load();
+	static void Save();
+	static bool IsUpToDate(const string &path, uint64_t &size, int64_t &modificationTime);
+	static void HashFiles(vector<RomHashEntry> &entries);
+
+public:
+	//Hashes the files that aren't in the index yet (or that changed since they were indexed), and saves the index
+	static void Update(const vector<string> &files);
+
+	//Returns the path of an indexed file with the given SHA1 hash (only if the file is unchanged since it was indexed)
+	static string FindRom(const string &sha1Hash);
+};
@@ -31,38 +31,57 @@ bool SZReader::InternalLoadArchive(void* buffer, size_t size)
 	return !SzArEx_Open(&_archive, &_lookStream.s, &allocImp, &allocTempImp);
 }
 
-bool SZReader::ExtractFile(string filename, vector<uint8_t> &output)
+int32_t SZReader::FindFile(string filename)
 {
-	bool result = false;
-	if(_initialized) {
-		char16_t *utf16Filename = (char16_t*)SzAlloc(nullptr, 2000);
+	int32_t fileIndex = -1;
+	char16_t *utf16Filename = (char16_t*)SzAlloc(nullptr, 2000);
+	for(uint32_t i = 0; i < _archive.NumFiles; i++) {
+		if(SzArEx_IsDir(&_archive, i)) {
+			continue;
+		}
 
-		uint32_t blockIndex = 0xFFFFFFFF;
-		uint8_t *outBuffer = 0;
-		size_t outBufferSize = 0;
+		SzArEx_GetFileNameUtf16(&_archive, i, (uint16_t*)utf16Filename);
+		string entryName = utf8::utf8::encode(std::u16string(utf16Filename));
+		if(filename == entryName) {
+			fileIndex = (int32_t)i;
+			break;
+		}
+	}
+	SzFree(nullptr, utf16Filename);
+	return fileIndex;
+}
 
-		for(uint32_t i = 0; i < _archive.NumFiles; i++) {
-			size_t offset = 0;
-			size_t outSizeProcessed = 0;
-			unsigned isDir = SzArEx_IsDir(&_archive, i);
-			if(isDir) {
-				continue;
-			}
+bool SZReader::InternalGetFileSize(string filename, size_t &size)
+{
+	int32_t fileIndex = FindFile(filename);
+	if(fileIndex < 0) {
+		return false;
+	}
 
-			SzArEx_GetFileNameUtf16(&_archive, i, (uint16_t*)utf16Filename);
-			string entryName = utf8::utf8::encode(std::u16string(utf16Filename));
-			if(filename == entryName) {
-				WRes res = SzArEx_Extract(&_archive, &_lookStream.s, i, &blockIndex, &outBuffer, &outBufferSize, &offset, &outSizeProcessed, &_allocImp, &_allocTempImp);
-				if(res == SZ_OK) {
-					output = vector<uint8_t>(outBuffer+offset, outBuffer+offset+outSizeProcessed);
-					result = true;
-				}
-				IAlloc_Free(&_allocImp, outBuffer);
-				break;
-			}
-		}
-		SzFree(nullptr, utf16Filename);
+	size = (size_t)SzArEx_GetFileSize(&_archive, fileIndex);
+	return true;
+}
+
+bool SZReader::InternalExtractFile(string filename, uint8_t* output, size_t size)
+{
+	int32_t fileIndex = FindFile(filename);
+	if(fileIndex < 0) {
+		return false;
+	}
+
+	//The 7z SDK always decodes the whole solid block the file belongs to, copy the file's portion of it into the output
+	bool result = false;
+	uint32_t blockIndex = 0xFFFFFFFF;
+	uint8_t *outBuffer = 0;
+	size_t outBufferSize = 0;
+	size_t offset = 0;
+	size_t outSizeProcessed = 0;
+	WRes res = SzArEx_Extract(&_archive, &_lookStream.s, fileIndex, &blockIndex, &outBuffer, &outBufferSize, &offset, &outSizeProcessed, &_allocImp, &_allocTempImp);
+	if(res == SZ_OK && outSizeProcessed == size) {
+		memcpy(output, outBuffer + offset, size);
+		result = true;
 	}
+	IAlloc_Free(&_allocImp, outBuffer);
 
 	return result;
 }
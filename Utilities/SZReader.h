@@ -16,13 +16,15 @@ private:
 	ISzAlloc _allocImp{ SzAlloc, SzFree };
 	ISzAlloc _allocTempImp{ SzAllocTemp, SzFreeTemp };
 
+	int32_t FindFile(string filename);
+
 protected:
 	bool InternalLoadArchive(void* buffer, size_t size);
 	vector<string> InternalGetFileList();
+	bool InternalGetFileSize(string filename, size_t &size);
+	bool InternalExtractFile(string filename, uint8_t* output, size_t size);
 
 public:
 	SZReader();
 	virtual ~SZReader();
-
-	bool ExtractFile(string filename, vector<uint8_t> &output);
 };
\ No newline at end of file
@@ -4,13 +4,13 @@
 #include "ISerializable.h"
 #include "miniz.h"
 
+thread_local vector<unique_ptr<BlockData>> Serializer::_blockPool;
+
 Serializer::Serializer(uint32_t version)
 {
 	_version = version;
 
-	_block.reset(new BlockData());
-	_block->Data = vector<uint8_t>(0x50000);
-	_block->Position = 0;
+	_block = AcquireBlock(0x50000);
 	_saving = true;
 }
 
@@ -18,8 +18,7 @@ Serializer::Serializer(istream &file, uint32_t version, bool compressed)
 {
 	_version = version;
 
-	_block.reset(new BlockData());
-	_block->Position = 0;
+	_block = AcquireBlock(0);
 	_saving = false;
 
 	if(compressed) {
@@ -32,7 +31,7 @@ Serializer::Serializer(istream &file, uint32_t version, bool compressed)
 		vector<uint8_t> compressedData(compressedSize, 0);
 		file.read((char*)compressedData.data(), compressedSize);
 
-		_block->Data = vector<uint8_t>(decompressedSize, 0);
+		_block->Data.resize(decompressedSize);
 
 		unsigned long decompSize = decompressedSize;
 		uncompress(_block->Data.data(), &decompSize, compressedData.data(), (unsigned long)compressedData.size());
@@ -47,11 +46,53 @@ Serializer::Serializer(istream &file, uint32_t version, bool compressed)
 		file.seekg(current, std::ios::beg);
 		size -= current;
 
-		_block->Data = vector<uint8_t>(size, 0);
+		_block->Data.resize(size);
 		file.read((char*)_block->Data.data(), size);
 	}
 }
 
+Serializer::Serializer(const uint8_t* data, uint32_t size, uint32_t version)
+{
+	_version = version;
+
+	_block = AcquireBlock(0);
+	_block->Data.resize(size);
+	memcpy(_block->Data.data(), data, size);
+	_saving = false;
+}
+
+Serializer::~Serializer()
+{
+	for(unique_ptr<BlockData> &block : _blocks) {
+		ReleaseBlock(std::move(block));
+	}
+	ReleaseBlock(std::move(_block));
+}
+
+unique_ptr<BlockData> Serializer::AcquireBlock(uint32_t minSize)
+{
+	unique_ptr<BlockData> block;
+	if(_blockPool.empty()) {
+		block.reset(new BlockData());
+	} else {
+		block = std::move(_blockPool.back());
+		_blockPool.pop_back();
+	}
+
+	if(block->Data.size() < minSize) {
+		block->Data.resize(minSize);
+	}
+	block->Position = 0;
+	return block;
+}
+
+void Serializer::ReleaseBlock(unique_ptr<BlockData> block)
+{
+	if(block && _blockPool.size() < Serializer::MaxPooledBlocks) {
+		_blockPool.push_back(std::move(block));
+	}
+}
+
 void Serializer::EnsureCapacity(uint32_t typeSize)
 {
 	//Make sure the current block/stream is large enough to fit the next write
@@ -76,14 +117,21 @@ void Serializer::RecursiveStream()
 
 void Serializer::StreamStartBlock()
 {
-	unique_ptr<BlockData> block(new BlockData());
-	block->Position = 0;
+	unique_ptr<BlockData> block = AcquireBlock(_saving ? 0x100 : 0);
 
 	if(!_saving) {
-		VectorInfo<uint8_t> vectorInfo = { &block->Data };
-		InternalStream(vectorInfo);
-	} else {
-		block->Data = vector<uint8_t>(0x100);
+		uint32_t blockSize = 0;
+		StreamElement<uint32_t>(blockSize);
+		if(blockSize > 0xFFFFFF) {
+			throw std::runtime_error("Invalid save state");
+		}
+
+		//Copy the block's content in one go, missing bytes (truncated state) are set to 0
+		uint32_t availableSize = std::min(blockSize, (uint32_t)_block->Data.size() - _block->Position);
+		block->Data.resize(blockSize);
+		memcpy(block->Data.data(), _block->Data.data() + _block->Position, availableSize);
+		memset(block->Data.data() + availableSize, 0, blockSize - availableSize);
+		_block->Position += availableSize;
 	}
 
 	_blocks.push_back(std::move(_block));
@@ -105,6 +153,8 @@ void Serializer::StreamEndBlock()
 		ArrayInfo<uint8_t> arrayInfo { block->Data.data(), block->Position };
 		InternalStream(arrayInfo);
 	}
+
+	ReleaseBlock(std::move(block));
 }
 
 void Serializer::Save(ostream& file, int compressionLevel)
@@ -124,6 +174,16 @@ void Serializer::Save(ostream& file, int compressionLevel)
 	}
 }
 
+uint32_t Serializer::Save(uint8_t* buffer, uint32_t size)
+{
+	if(_block->Position > size) {
+		//Buffer is too small to fit the state
+		return 0;
+	}
+	memcpy(buffer, _block->Data.data(), _block->Position);
+	return _block->Position;
+}
+
 void Serializer::WriteEmptyBlock(ostream* file)
 {
 	int blockSize = 0;
@@ -34,6 +34,12 @@ struct BlockData
 class Serializer
 {
 private:
+	static constexpr uint32_t MaxPooledBlocks = 16;
+
+	//Blocks are recycled between serializer instances on the same thread to avoid
+	//reallocating buffers when states are saved/loaded every frame (rewind, run-ahead, etc.)
+	thread_local static vector<unique_ptr<BlockData>> _blockPool;
+
 	vector<unique_ptr<BlockData>> _blocks;	
 	unique_ptr<BlockData> _block;
 
@@ -41,6 +47,9 @@ private:
 	bool _saving = false;
 
 private:
+	static unique_ptr<BlockData> AcquireBlock(uint32_t minSize);
+	static void ReleaseBlock(unique_ptr<BlockData> block);
+
 	void EnsureCapacity(uint32_t typeSize);
 
 	template<typename T> void StreamElement(T &value, T defaultValue = T());
@@ -60,6 +69,8 @@ private:
 public:
 	Serializer(uint32_t version);
 	Serializer(istream &file, uint32_t version, bool compressed = false);
+	Serializer(const uint8_t* data, uint32_t size, uint32_t version);
+	~Serializer();
 
 	uint32_t GetVersion() { return _version; }
 	bool IsSaving() { return _saving; }
@@ -69,6 +80,7 @@ public:
 	template<typename T> void StreamVector(vector<T> &list);
 
 	void Save(ostream &file, int compressionLevel = 0);
+	uint32_t Save(uint8_t* buffer, uint32_t size);
 
 	void Stream(ISerializable &obj);
 	void Stream(ISerializable *obj);
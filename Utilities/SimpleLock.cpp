@@ -2,11 +2,19 @@
 #include <assert.h>
 #include "SimpleLock.h"
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+#endif
+
 thread_local std::thread::id SimpleLock::_threadID = std::this_thread::get_id();
 
+atomic<uint64_t> SimpleLock::_contentionCount(0);
+atomic<uint64_t> SimpleLock::_parkCount(0);
+
 SimpleLock::SimpleLock()
 {
-	_lock.clear();
+	_lock = false;
+	_waiterCount = 0;
 	_lockCount = 0;
 	_holderThreadID = std::thread::id();
 }
@@ -23,7 +31,9 @@ LockHandler SimpleLock::AcquireSafe()
 void SimpleLock::Acquire()
 {
 	if(_lockCount == 0 || _holderThreadID != _threadID) {
-		while(_lock.test_and_set());
+		if(!TryLock()) {
+			AcquireContended();
+		}
 		_holderThreadID = _threadID;
 		_lockCount = 1;
 	} else {
@@ -32,6 +42,54 @@ void SimpleLock::Acquire()
 	}
 }
 
+bool SimpleLock::TryLock()
+{
+	return !_lock.load(std::memory_order_relaxed) && !_lock.exchange(true, std::memory_order_acquire);
+}
+
+void SimpleLock::AcquireContended()
+{
+	_contentionCount.fetch_add(1, std::memory_order_relaxed);
+
+	//Spin for a short while first - most locks are only held for a very short time
+	for(int i = 0; i < SimpleLock::SpinCount; i++) {
+		CpuPause();
+		if(TryLock()) {
+			return;
+		}
+	}
+
+	//Lock is still held, sleep until it is released instead of burning a core
+	_parkCount.fetch_add(1, std::memory_order_relaxed);
+	std::unique_lock<std::mutex> lock(_parkMutex);
+	_waiterCount++;
+	while(_lock.exchange(true)) {
+		_parkSignal.wait(lock);
+	}
+	_waiterCount--;
+}
+
+void SimpleLock::CpuPause()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	_mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm__ __volatile__("yield");
+#else
+	std::this_thread::yield();
+#endif
+}
+
+SimpleLockStats SimpleLock::GetStats()
+{
+	SimpleLockStats stats;
+	stats.ContentionCount = _contentionCount;
+	stats.ParkCount = _parkCount;
+	return stats;
+}
+
 bool SimpleLock::IsFree()
 {
 	return _lockCount == 0;
@@ -50,7 +108,12 @@ void SimpleLock::Release()
 		_lockCount--;
 		if(_lockCount == 0) {
 			_holderThreadID = std::thread::id();
-			_lock.clear();
+			_lock = false;
+			if(_waiterCount > 0) {
+				//Wake up a parked thread (the mutex ensures the wake up can't be missed)
+				std::lock_guard<std::mutex> lock(_parkMutex);
+				_parkSignal.notify_one();
+			}
 		}
 	} else {
 		assert(false);
@@ -1,6 +1,8 @@
 #pragma once 
 #include "stdafx.h"
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 
 class SimpleLock;
 
@@ -13,14 +15,33 @@ public:
 	~LockHandler();
 };
 
+struct SimpleLockStats
+{
+	uint64_t ContentionCount;
+	uint64_t ParkCount;
+};
+
 class SimpleLock
 {
 private:
+	//Number of times a contended lock is polled before the thread is put to sleep
+	static constexpr int SpinCount = 1000;
+
 	thread_local static std::thread::id _threadID;
 
+	static atomic<uint64_t> _contentionCount;
+	static atomic<uint64_t> _parkCount;
+
 	std::thread::id _holderThreadID;
 	uint32_t _lockCount;
-	atomic_flag _lock;
+	atomic<bool> _lock;
+
+	atomic<uint32_t> _waiterCount;
+	std::mutex _parkMutex;
+	std::condition_variable _parkSignal;
+
+	bool TryLock();
+	void AcquireContended();
 
 public:
 	SimpleLock();
@@ -32,5 +53,8 @@ public:
 	bool IsFree();
 	void WaitForRelease();
 	void Release();
+
+	static void CpuPause();
+	static SimpleLockStats GetStats();
 };
 
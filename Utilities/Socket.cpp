@@ -23,6 +23,7 @@ using namespace std;
 	#include <netinet/tcp.h>
 	#include <netdb.h>
 	#include <unistd.h>
+	#include <poll.h>
 
 	#define INVALID_SOCKET (uintptr_t)-1
 	#define SOCKET_ERROR -1
@@ -34,6 +35,8 @@ using namespace std;
 	#define closesocket close
 	#define WSAEWOULDBLOCK EWOULDBLOCK
 	#define ioctlsocket ioctl
+	#define WSAPoll poll
+	#define WSAPOLLFD pollfd
 #endif
 
 Socket::Socket()
@@ -265,6 +268,38 @@ int Socket::Recv(char *buf, int len, int flags)
 	return returnVal;
 }
 
+int Socket::Poll(vector<Socket*> &sockets, vector<bool> &ready, int timeoutMs)
+{
+	vector<WSAPOLLFD> fds(sockets.size());
+	for(size_t i = 0; i < sockets.size(); i++) {
+		fds[i].fd = sockets[i]->_socket;
+		fds[i].events = POLLIN;
+		fds[i].revents = 0;
+	}
+
+	ready.assign(sockets.size(), false);
+
+	if(fds.empty()) {
+		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(timeoutMs));
+		return 0;
+	}
+
+	int returnVal = WSAPoll(fds.data(), (unsigned long)fds.size(), timeoutMs);
+	if(returnVal <= 0) {
+		return 0;
+	}
+
+	int readyCount = 0;
+	for(size_t i = 0; i < fds.size(); i++) {
+		//Errors/hang ups are reported as readable, the next Recv call will flag the connection as closed
+		if(fds[i].revents & (POLLIN | POLLERR | POLLHUP | POLLNVAL)) {
+			ready[i] = true;
+			readyCount++;
+		}
+	}
+	return readyCount;
+}
+
 #else
 
 //Libretro port does not need sockets.
@@ -338,4 +373,10 @@ int Socket::Recv(char *buf, int len, int flags)
 {
 	return 0;
 }
+
+int Socket::Poll(vector<Socket*> &sockets, vector<bool> &ready, int timeoutMs)
+{
+	ready.assign(sockets.size(), false);
+	return 0;
+}
 #endif
@@ -35,4 +35,8 @@ public:
 	void BufferedSend(char *buf, int len);
 	void SendBuffer();
 	int Recv(char *buf, int len, int flags);
+
+	//Waits until at least one of the sockets has data to read (or was closed), or until the timeout expires
+	//ready[i] is set for every socket that can be read from without blocking - returns the number of ready sockets
+	static int Poll(vector<Socket*> &sockets, vector<bool> &ready, int timeoutMs);
 };
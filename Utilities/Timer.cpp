@@ -4,6 +4,11 @@
 #include <thread>
 #include <chrono>
 
+#ifdef __linux__
+	#include <time.h>
+	#include <errno.h>
+#endif
+
 using namespace std::chrono;
 
 Timer::Timer() 
@@ -13,22 +18,50 @@ Timer::Timer()
 
 void Timer::Reset()
 {
-	_start = high_resolution_clock::now();
+	_start = steady_clock::now();
 }
 
 double Timer::GetElapsedMS()
 {
-	high_resolution_clock::time_point end = high_resolution_clock::now();
+	steady_clock::time_point end = steady_clock::now();
 	duration<double> span = duration_cast<duration<double>>(end - _start);
 	return span.count() * 1000.0;
 }
 
+void Timer::SleepUntil(steady_clock::time_point time)
+{
+#ifdef __linux__
+	//Sleep until an absolute deadline, this avoids accumulating the error of relative sleeps
+	//steady_clock uses CLOCK_MONOTONIC on Linux
+	nanoseconds ns = duration_cast<nanoseconds>(time.time_since_epoch());
+	timespec ts;
+	ts.tv_sec = (time_t)(ns.count() / 1000000000);
+	ts.tv_nsec = (long)(ns.count() % 1000000000);
+	while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+	}
+#else
+	std::this_thread::sleep_until(time);
+#endif
+}
+
 void Timer::WaitUntil(double targetMillisecond)
 {
 	if(targetMillisecond > 0) {
-		double elapsedTime = GetElapsedMS();
-		if(targetMillisecond - elapsedTime > 1) {
-			std::this_thread::sleep_for(std::chrono::duration<int, std::milli>((int)(targetMillisecond - elapsedTime)));
+#ifdef __linux__
+		constexpr double spinTime = 0.25;
+#else
+		//Sleep calls are only accurate to ~1ms (with a 1ms timer resolution)
+		constexpr double spinTime = 1.5;
+#endif
+		steady_clock::time_point target = _start + duration_cast<steady_clock::duration>(duration<double, std::milli>(targetMillisecond));
+
+		//Sleep until shortly before the target time, and then spin for the remaining time
+		if(targetMillisecond - GetElapsedMS() > spinTime) {
+			SleepUntil(target - duration_cast<steady_clock::duration>(duration<double, std::milli>(spinTime)));
+		}
+
+		while(steady_clock::now() < target) {
+			std::this_thread::yield();
 		}
 	}
 }
@@ -6,11 +6,13 @@ using namespace std::chrono;
 class Timer
 {
 	private:
-		high_resolution_clock::time_point _start;
+		steady_clock::time_point _start;
+
+		static void SleepUntil(steady_clock::time_point time);
 
 public:
 		Timer();
 		void Reset();
 		double GetElapsedMS();
 		void WaitUntil(double targetMillisecond);
-};
\ No newline at end of file
+};
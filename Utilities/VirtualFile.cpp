@@ -9,8 +9,17 @@
 #include "../Utilities/BpsPatcher.h"
 #include "../Utilities/IpsPatcher.h"
 #include "../Utilities/UpsPatcher.h"
+#include "../Utilities/CRC32.h"
+#include "../Utilities/HexUtilities.h"
 
 const std::initializer_list<string> VirtualFile::RomExtensions = { ".sfc", ".smc", ".swc", ".fig", ".bs", ".gb", ".gbc" };
+string VirtualFile::_cacheFolder = "";
+
+void VirtualFile::SetCacheFolder(string folder)
+{
+	//Files extracted from archives are cached in this folder (disabled when empty)
+	_cacheFolder = folder;
+}
 
 VirtualFile::VirtualFile()
 {
@@ -75,25 +84,99 @@ void VirtualFile::FromStream(std::istream& input, vector<uint8_t>& output)
 	input.read((char*)output.data(), fileSize);
 }
 
-void VirtualFile::LoadFile()
+bool VirtualFile::OpenArchive()
 {
-	if(_data.size() == 0) {
-		if(!_innerFile.empty()) {
-			shared_ptr<ArchiveReader> reader = ArchiveReader::GetReader(_path);
-			if(reader) {
-				if(_innerFileIndex >= 0) {
-					vector<string> filelist = reader->GetFileList(VirtualFile::RomExtensions);
-					if((int32_t)filelist.size() > _innerFileIndex) {
-						reader->ExtractFile(filelist[_innerFileIndex], _data);
-					}
-				} else {
-					reader->ExtractFile(_innerFile, _data);
+	if(!_reader) {
+		_reader = ArchiveReader::GetReader(_path);
+		if(!_reader) {
+			return false;
+		}
+
+		if(_innerFileIndex >= 0) {
+			vector<string> filelist = _reader->GetFileList(VirtualFile::RomExtensions);
+			_archiveEntry = (int32_t)filelist.size() > _innerFileIndex ? filelist[_innerFileIndex] : "";
+		} else {
+			_archiveEntry = _innerFile;
+		}
+	}
+	return true;
+}
+
+string VirtualFile::GetCacheFilepath()
+{
+	if(_cacheFolder.empty()) {
+		return "";
+	}
+
+	//Keyed on the archive's content (rather than its path) and on the file's name inside the archive
+	uint32_t archiveCrc = _reader->GetArchiveCrc();
+	uint32_t entryCrc = CRC32::GetCRC((uint8_t*)_archiveEntry.c_str(), _archiveEntry.size());
+	return FolderUtilities::CombinePath(_cacheFolder, HexUtilities::ToHex(archiveCrc, true) + HexUtilities::ToHex(entryCrc, true) + ".bin");
+}
+
+void VirtualFile::SaveToCache(string cacheFilepath, uint8_t* data, size_t size)
+{
+	ofstream cacheFile(cacheFilepath, std::ios::out | std::ios::binary);
+	if(cacheFile) {
+		cacheFile.write((char*)data, size);
+		cacheFile.close();
+	}
+
+	//Only keep the most recently extracted files
+	vector<std::pair<int64_t, string>> cachedFiles;
+	for(string filepath : FolderUtilities::GetFilesInFolder(_cacheFolder, { ".bin" }, false)) {
+		uint64_t fileSize;
+		int64_t modificationTime;
+		if(FolderUtilities::GetFileInfo(filepath, fileSize, modificationTime)) {
+			cachedFiles.push_back({ modificationTime, filepath });
+		}
+	}
+
+	if(cachedFiles.size() > VirtualFile::MaxCachedFiles) {
+		std::sort(cachedFiles.begin(), cachedFiles.end());
+		for(size_t i = 0; i < cachedFiles.size() - VirtualFile::MaxCachedFiles; i++) {
+			FolderUtilities::RemoveFile(cachedFiles[i].second);
+		}
+	}
+}
+
+bool VirtualFile::ReadFromDisk(uint8_t* out, size_t size)
+{
+	//Reads (or extracts) the file directly into the output buffer, without going through _data
+	bool result = false;
+	if(!_innerFile.empty()) {
+		if(OpenArchive()) {
+			string cacheFilepath = GetCacheFilepath();
+			if(!cacheFilepath.empty()) {
+				ifstream cacheFile(cacheFilepath, std::ios::in | std::ios::binary);
+				result = cacheFile && cacheFile.read((char*)out, size) && cacheFile.peek() == std::ifstream::traits_type::eof();
+			}
+
+			if(!result) {
+				result = _reader->ExtractFile(_archiveEntry, out, size);
+				if(result && !cacheFilepath.empty()) {
+					SaveToCache(cacheFilepath, out, size);
 				}
 			}
-		} else {
-			ifstream input(_path, std::ios::in | std::ios::binary);
-			if(input.good()) {
-				FromStream(input, _data);
+		}
+
+		//Release the archive once its content has been read
+		_reader.reset();
+	} else {
+		ifstream input(_path, std::ios::in | std::ios::binary);
+		result = input && input.read((char*)out, size);
+	}
+	return result;
+}
+
+void VirtualFile::LoadFile()
+{
+	if(_data.size() == 0) {
+		size_t size = GetSize();
+		if(size > 0) {
+			_data.resize(size);
+			if(!ReadFromDisk(_data.data(), size)) {
+				_data.clear();
 			}
 		}
 	}
@@ -106,17 +189,7 @@ bool VirtualFile::IsValid()
 	}
 
 	if(!_innerFile.empty()) {
-		shared_ptr<ArchiveReader> reader = ArchiveReader::GetReader(_path);
-		if(reader) {
-			vector<string> filelist = reader->GetFileList();
-			if(_innerFileIndex >= 0) {
-				if((int32_t)filelist.size() > _innerFileIndex) {
-					return true;
-				}
-			} else {
-				return std::find(filelist.begin(), filelist.end(), _innerFile) != filelist.end();
-			}
-		}
+		return OpenArchive() && _reader->CheckFile(_archiveEntry);
 	} else {
 		ifstream input(_path, std::ios::in | std::ios::binary);
 		if(input) {
@@ -149,18 +222,42 @@ string VirtualFile::GetSha1Hash()
 
 size_t VirtualFile::GetSize()
 {
-	LoadFile();
-	return _data.size();
+	if(_data.size() > 0) {
+		return _data.size();
+	}
+
+	if(!_innerFile.empty()) {
+		size_t size;
+		if(OpenArchive() && _reader->GetFileSize(_archiveEntry, size)) {
+			return size;
+		}
+	} else {
+		ifstream input(_path, std::ios::in | std::ios::binary);
+		if(input) {
+			input.seekg(0, std::ios::end);
+			return (size_t)input.tellg();
+		}
+	}
+	return 0;
 }
 
 bool VirtualFile::ReadFile(vector<uint8_t>& out)
 {
-	LoadFile();
 	if(_data.size() > 0) {
 		out.resize(_data.size(), 0);
 		std::copy(_data.begin(), _data.end(), out.begin());
 		return true;
 	}
+
+	//Not loaded yet, read the file straight into the output
+	size_t size = GetSize();
+	if(size > 0) {
+		out.resize(size);
+		if(ReadFromDisk(out.data(), size)) {
+			return true;
+		}
+		out.clear();
+	}
 	return false;
 }
 
@@ -176,12 +273,15 @@ bool VirtualFile::ReadFile(std::stringstream& out)
 
 bool VirtualFile::ReadFile(uint8_t* out, uint32_t expectedSize)
 {
-	LoadFile();
-	if(_data.size() == expectedSize) {
-		memcpy(out, _data.data(), _data.size());
-		return true;
+	if(_data.size() > 0) {
+		if(_data.size() == expectedSize) {
+			memcpy(out, _data.data(), _data.size());
+			return true;
+		}
+		return false;
 	}
-	return false;
+
+	return GetSize() == expectedSize && ReadFromDisk(out, expectedSize);
 }
 
 bool VirtualFile::ApplyPatch(VirtualFile& patch)
@@ -192,19 +292,22 @@ bool VirtualFile::ApplyPatch(VirtualFile& patch)
 		patch.LoadFile();
 		LoadFile();
 		if(patch._data.size() >= 5) {
-			vector<uint8_t> patchedData;
 			std::stringstream ss;
 			patch.ReadFile(ss);
 
 			if(memcmp(patch._data.data(), "PATCH", 5) == 0) {
-				result = IpsPatcher::PatchBuffer(ss, _data, patchedData);
-			} else if(memcmp(patch._data.data(), "UPS1", 4) == 0) {
-				result = UpsPatcher::PatchBuffer(ss, _data, patchedData);
-			} else if(memcmp(patch._data.data(), "BPS1", 4) == 0) {
-				result = BpsPatcher::PatchBuffer(ss, _data, patchedData);
-			}
-			if(result) {
-				_data = patchedData;
+				//IPS patches are applied in place
+				result = IpsPatcher::PatchBuffer(ss, _data);
+			} else {
+				vector<uint8_t> patchedData;
+				if(memcmp(patch._data.data(), "UPS1", 4) == 0) {
+					result = UpsPatcher::PatchBuffer(ss, _data, patchedData);
+				} else if(memcmp(patch._data.data(), "BPS1", 4) == 0) {
+					result = BpsPatcher::PatchBuffer(ss, _data, patchedData);
+				}
+				if(result) {
+					_data.swap(patchedData);
+				}
 			}
 		}
 	}
@@ -2,21 +2,36 @@
 #include "stdafx.h"
 #include <sstream>
 
+class ArchiveReader;
+
 class VirtualFile
 {
 private:
+	static constexpr size_t MaxCachedFiles = 20;
+	static string _cacheFolder;
+
 	string _path = "";
 	string _innerFile = "";
 	int32_t _innerFileIndex = -1;
 	vector<uint8_t> _data;
 
+	shared_ptr<ArchiveReader> _reader;
+	string _archiveEntry;
+
 	void FromStream(std::istream &input, vector<uint8_t> &output);
 
+	bool OpenArchive();
+	bool ReadFromDisk(uint8_t* out, size_t size);
+	string GetCacheFilepath();
+	void SaveToCache(string cacheFilepath, uint8_t* data, size_t size);
+
 	void LoadFile();
 
 public:
 	static const std::initializer_list<string> RomExtensions;
 
+	static void SetCacheFolder(string folder);
+
 	VirtualFile();
 	VirtualFile(const string &archivePath, const string innerFile);
 	VirtualFile(const string &file);
@@ -0,0 +1,116 @@
+#include "stdafx.h"
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(uint32_t threadCount)
+{
+	_nextTask = 0;
+	_running = false;
+	for(uint32_t i = 0; i < threadCount; i++) {
+		_threads.push_back(std::thread(&WorkerPool::WorkerThread, this));
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_stopFlag = true;
+		_startSignal.notify_all();
+	}
+
+	for(std::thread &thread : _threads) {
+		thread.join();
+	}
+}
+
+uint32_t WorkerPool::GetDefaultThreadCount()
+{
+	//Leave a core for the emulation thread and one for the thread that calls Run (it processes tasks too)
+	uint32_t coreCount = std::thread::hardware_concurrency();
+	return coreCount > 2 ? std::min<uint32_t>(coreCount - 2, 6) : 0;
+}
+
+uint32_t WorkerPool::GetThreadCount()
+{
+	//Includes the calling thread
+	return (uint32_t)_threads.size() + 1;
+}
+
+void WorkerPool::RunTasks()
+{
+	uint32_t taskIndex;
+	while((taskIndex = _nextTask++) < _taskCount) {
+		_task(taskIndex);
+	}
+}
+
+void WorkerPool::WorkerThread()
+{
+	uint32_t generation = 0;
+	while(true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_startSignal.wait(lock, [&] { return _stopFlag || _generation != generation; });
+			if(_stopFlag) {
+				return;
+			}
+			generation = _generation;
+		}
+
+		RunTasks();
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		if(--_pendingWorkers == 0) {
+			_doneSignal.notify_all();
+		}
+	}
+}
+
+void WorkerPool::Run(uint32_t taskCount, std::function<void(uint32_t)> task)
+{
+	bool expected = false;
+	if(_threads.empty() || taskCount <= 1 || !_running.compare_exchange_strong(expected, true)) {
+		//Nothing to split or the pool is already in use by another thread, run everything on this thread
+		for(uint32_t i = 0; i < taskCount; i++) {
+			task(i);
+		}
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_task = task;
+		_taskCount = taskCount;
+		_nextTask = 0;
+		_pendingWorkers = (uint32_t)_threads.size();
+		_generation++;
+		_startSignal.notify_all();
+	}
+
+	RunTasks();
+
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_doneSignal.wait(lock, [this] { return _pendingWorkers == 0; });
+		_task = nullptr;
+	}
+
+	_running = false;
+}
+
+void WorkerPool::RunBands(uint32_t rowCount, uint32_t rowAlignment, std::function<void(uint32_t, uint32_t)> task)
+{
+	//Splits [0, rowCount) into one band per thread, each band's start is a multiple of rowAlignment
+	uint32_t bandCount = GetThreadCount();
+	uint32_t rowsPerBand = (rowCount + bandCount - 1) / bandCount;
+	rowsPerBand = (rowsPerBand + rowAlignment - 1) / rowAlignment * rowAlignment;
+	if(rowsPerBand == 0) {
+		return;
+	}
+
+	bandCount = (rowCount + rowsPerBand - 1) / rowsPerBand;
+	Run(bandCount, [=](uint32_t band) {
+		uint32_t firstRow = band * rowsPerBand;
+		task(firstRow, std::min(firstRow + rowsPerBand, rowCount));
+	});
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include "stdafx.h"
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include <mutex>
+
+class WorkerPool
+{
+private:
+	vector<std::thread> _threads;
+	std::mutex _mutex;
+	std::condition_variable _startSignal;
+	std::condition_variable _doneSignal;
+
+	std::function<void(uint32_t)> _task;
+	uint32_t _taskCount = 0;
+	atomic<uint32_t> _nextTask;
+	uint32_t _pendingWorkers = 0;
+	uint32_t _generation = 0;
+	bool _stopFlag = false;
+	atomic<bool> _running;
+
+	void WorkerThread();
+	void RunTasks();
+
+public:
+	WorkerPool(uint32_t threadCount);
+	~WorkerPool();
+
+	uint32_t GetThreadCount();
+
+	void Run(uint32_t taskCount, std::function<void(uint32_t)> task);
+	void RunBands(uint32_t rowCount, uint32_t rowAlignment, std::function<void(uint32_t, uint32_t)> task);
+
+	static uint32_t GetDefaultThreadCount();
+};
\ No newline at end of file
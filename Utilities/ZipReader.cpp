@@ -42,25 +42,26 @@ vector<string> ZipReader::InternalGetFileList()
 	return fileList;
 }
 
-bool ZipReader::ExtractFile(string filename, vector<uint8_t> &output)
+bool ZipReader::InternalGetFileSize(string filename, size_t &size)
 {
-	if(_initialized) {
-		size_t uncompSize;
-		void *p = mz_zip_reader_extract_file_to_heap(&_zipArchive, filename.c_str(), &uncompSize, 0);
-		if(!p) {
-#ifdef _DEBUG
-			std::cout << "mz_zip_reader_extract_file_to_heap() failed!" << std::endl;
-#endif
-			return false;
-		}
-
-		output = vector<uint8_t>((uint8_t*)p, (uint8_t*)p + uncompSize);
+	int fileIndex = mz_zip_reader_locate_file(&_zipArchive, filename.c_str(), nullptr, 0);
+	mz_zip_archive_file_stat fileStat;
+	if(fileIndex < 0 || !mz_zip_reader_file_stat(&_zipArchive, fileIndex, &fileStat)) {
+		return false;
+	}
 
-		// We're done.
-		mz_free(p);
+	size = (size_t)fileStat.m_uncomp_size;
+	return true;
+}
 
-		return true;
+bool ZipReader::InternalExtractFile(string filename, uint8_t* output, size_t size)
+{
+	int fileIndex = mz_zip_reader_locate_file(&_zipArchive, filename.c_str(), nullptr, 0);
+	if(fileIndex < 0 || !mz_zip_reader_extract_to_mem(&_zipArchive, fileIndex, output, size, 0)) {
+#ifdef _DEBUG
+		std::cout << "mz_zip_reader_extract_to_mem() failed!" << std::endl;
+#endif
+		return false;
 	}
-
-	return false;
+	return true;
 }
\ No newline at end of file
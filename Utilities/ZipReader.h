@@ -11,10 +11,10 @@ private:
 protected:
 	bool InternalLoadArchive(void* buffer, size_t size);
 	vector<string> InternalGetFileList();
+	bool InternalGetFileSize(string filename, size_t &size);
+	bool InternalExtractFile(string filename, uint8_t* output, size_t size);
 
 public:
 	ZipReader();
 	virtual ~ZipReader();
-
-	bool ExtractFile(string filename, vector<uint8_t> &output);
 };
\ No newline at end of file
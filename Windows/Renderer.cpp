@@ -169,11 +169,6 @@ void Renderer::ResetNesBuffers()
 		_pOverlaySrv->Release();
 		_pOverlaySrv = nullptr;
 	}
-
-	delete[] _textureBuffer[0];
-	_textureBuffer[0] = nullptr;
-	delete[] _textureBuffer[1];
-	_textureBuffer[1] = nullptr;
 }
 
 void Renderer::ReleaseRenderTargetView()
@@ -218,11 +213,6 @@ HRESULT Renderer::CreateNesBuffers()
 	vp.TopLeftY = 0;
 	_pDeviceContext->RSSetViewports(1, &vp);
 
-	_textureBuffer[0] = new uint8_t[_nesFrameWidth*_nesFrameHeight * 4];
-	_textureBuffer[1] = new uint8_t[_nesFrameWidth*_nesFrameHeight * 4];
-	memset(_textureBuffer[0], 0, _nesFrameWidth*_nesFrameHeight * 4);
-	memset(_textureBuffer[1], 0, _nesFrameWidth*_nesFrameHeight * 4);
-
 	_pTexture = CreateTexture(_nesFrameWidth, _nesFrameHeight);
 	if(!_pTexture) {
 		return S_FALSE;
@@ -487,28 +477,22 @@ void Renderer::DrawString(std::wstring message, float x, float y, DirectX::FXMVE
 	font->DrawString(_spriteBatch.get(), text, XMFLOAT2(x+_leftMargin, y+_topMargin), color, 0.0f, XMFLOAT2(0, 0), scale);
 }
 
-void Renderer::UpdateFrame(void *frameBuffer, uint32_t width, uint32_t height)
+void Renderer::UpdateFrame(shared_ptr<FrameBuffer> frame)
 {
-	SetScreenSize(width, height);
+	SetScreenSize(frame->GetWidth(), frame->GetHeight());
 
-	uint32_t bpp = 4;
 	auto lock = _textureLock.AcquireSafe();
-	if(_textureBuffer[0]) {
-		//_textureBuffer[0] may be null if directx failed to initialize properly
-		memcpy(_textureBuffer[0], frameBuffer, width*height*bpp);
-		_needFlip = true;
-		_frameChanged = true;
-	}
+	_pendingFrame = frame;
+	_needFlip = true;
+	_frameChanged = true;
 }
 
 void Renderer::DrawScreen()
 {
-	//Swap buffers - emulator always writes to _textureBuffer[0], screen always draws _textureBuffer[1]
+	//Display the latest frame sent by the decoder - the decoder writes the next frames to other buffers from its pool
 	if(_needFlip) {
 		auto lock = _textureLock.AcquireSafe();
-		uint8_t* textureBuffer = _textureBuffer[0];
-		_textureBuffer[0] = _textureBuffer[1];
-		_textureBuffer[1] = textureBuffer;
+		_displayedFrame = std::move(_pendingFrame);
 		_needFlip = false;
 
 		if(_frameChanged) {
@@ -527,10 +511,16 @@ void Renderer::DrawScreen()
 		return;
 	}
 	uint8_t* surfacePointer = (uint8_t*)dd.pData;
-	uint8_t* videoBuffer = _textureBuffer[1];
+	shared_ptr<FrameBuffer> frame = _displayedFrame;
+	bool validFrame = frame && frame->GetWidth() == _nesFrameWidth && frame->GetHeight() == _nesFrameHeight;
+	uint8_t* videoBuffer = validFrame ? (uint8_t*)frame->GetData() : nullptr;
 	for(uint32_t i = 0, iMax = _nesFrameHeight; i < iMax; i++) {
-		memcpy(surfacePointer, videoBuffer, rowPitch);
-		videoBuffer += rowPitch;
+		if(videoBuffer) {
+			memcpy(surfacePointer, videoBuffer, rowPitch);
+			videoBuffer += rowPitch;
+		} else {
+			memset(surfacePointer, 0, rowPitch);
+		}
 		surfacePointer += dd.RowPitch;
 	}
 	_pDeviceContext->Unmap(_pTexture, 0);
@@ -32,7 +32,8 @@ private:
 	ID3D11SamplerState*		_samplerState = nullptr;
 		
 	atomic<bool>				_needFlip = false;
-	uint8_t*						_textureBuffer[2] = { nullptr, nullptr };
+	shared_ptr<FrameBuffer>	_pendingFrame;
+	shared_ptr<FrameBuffer>	_displayedFrame;
 	ID3D11Texture2D*			_pTexture = nullptr;
 	ID3D11ShaderResourceView*	_pTextureSrv = nullptr;
 	ID3D11Texture2D*			_overlayTexture = nullptr;
@@ -100,5 +101,5 @@ public:
 	void Reset();
 	void Render();
 
-	void UpdateFrame(void *frameBuffer, uint32_t width, uint32_t height);
+	void UpdateFrame(shared_ptr<FrameBuffer> frame);
 };
\ No newline at end of file